@@ -133,6 +133,11 @@ ENDIF()
 
 SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_COMPRESSIBLE_STRING)
 
+# 16-bit opcode header instead of handler address in each bytecode
+IF (ESCARGOT_COMPACT_BYTECODE)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_COMPACT_BYTECODE)
+ENDIF()
+
 #######################################################
 # flags for $(MODE) : debug/release
 #######################################################
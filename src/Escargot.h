@@ -419,6 +419,19 @@ typedef uint16_t LexicalBlockIndex;
 #define REGEXP_CACHE_SIZE_MAX 64
 #endif
 
+#ifndef PROPERTY_ACCESS_STUB_CACHE_SIZE
+#define PROPERTY_ACCESS_STUB_CACHE_SIZE 1024
+#endif
+
+// a property access inline cache starts filling after this many misses, and gives up after PROPERTY_INLINE_CACHE_MAX_MISS_COUNT
+#ifndef PROPERTY_INLINE_CACHE_MIN_FILL_COUNT
+#define PROPERTY_INLINE_CACHE_MIN_FILL_COUNT 3
+#endif
+
+#ifndef PROPERTY_INLINE_CACHE_MAX_MISS_COUNT
+#define PROPERTY_INLINE_CACHE_MAX_MISS_COUNT 16
+#endif
+
 
 #ifndef ROPE_STRING_MIN_LENGTH
 #define ROPE_STRING_MIN_LENGTH 24
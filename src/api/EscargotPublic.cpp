@@ -25,8 +25,10 @@
 #include "parser/ast/Node.h"
 #include "parser/ScriptParser.h"
 #include "parser/CodeBlock.h"
+#include "codecache/CodeCache.h"
 #include "runtime/Context.h"
 #include "runtime/FunctionObject.h"
+#include "runtime/ScriptFunctionObject.h"
 #include "runtime/Value.h"
 #include "runtime/VMInstance.h"
 #include "runtime/SandBox.h"
@@ -778,6 +780,31 @@ void VMInstanceRef::clearCachesRelatedWithContext()
     imp->globalSymbolRegistry().clear();
 }
 
+size_t VMInstanceRef::maxCompiledByteCodeSize()
+{
+    return toImpl(this)->maxCompiledByteCodeSize();
+}
+
+void VMInstanceRef::setMaxCompiledByteCodeSize(size_t size)
+{
+    toImpl(this)->setMaxCompiledByteCodeSize(size);
+}
+
+bool VMInstanceRef::exportWarmUpProfile(const char* profileFilePath)
+{
+    return WarmUpProfile::write(toImpl(this), profileFilePath);
+}
+
+bool VMInstanceRef::importWarmUpProfile(const char* profileFilePath)
+{
+    WarmUpProfile* profile = WarmUpProfile::read(profileFilePath);
+    if (!profile) {
+        return false;
+    }
+    toImpl(this)->setWarmUpProfile(profile);
+    return true;
+}
+
 #define DECLARE_GLOBAL_SYMBOLS(name)                      \
     SymbolRef* VMInstanceRef::name##Symbol()              \
     {                                                     \
@@ -1140,6 +1167,14 @@ bool ObjectRef::setPrototype(ExecutionStateRef* state, ValueRef* value)
     return toImpl(this)->setPrototype(*toImpl(state), toImpl(value));
 }
 
+static Context* creationContextOfFunction(FunctionObject* fn)
+{
+    if (fn->isScriptFunctionObject()) {
+        return fn->asScriptFunctionObject()->realm();
+    }
+    return fn->codeBlock()->context();
+}
+
 OptionalRef<ContextRef> ObjectRef::creationContext()
 {
     Optional<Object*> o = toImpl(this);
@@ -1150,13 +1185,13 @@ OptionalRef<ContextRef> ObjectRef::creationContext()
         }
 
         if (o->isFunctionObject()) {
-            return toRef(o->asFunctionObject()->codeBlock()->context());
+            return toRef(creationContextOfFunction(o->asFunctionObject()));
         }
 
         auto ctor = o->readConstructorSlotWithoutState();
         if (ctor) {
             if (ctor.value().isFunction()) {
-                return toRef(ctor.value().asFunction()->codeBlock()->context());
+                return toRef(creationContextOfFunction(ctor.value().asFunction()));
             }
         }
 
@@ -2462,6 +2497,30 @@ ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScript(String
     return result;
 }
 
+void ScriptParserRef::setCodeCacheDirectory(const char* cacheDirectory)
+{
+    toImpl(this)->setCodeCacheDirectory(cacheDirectory);
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptWithBundle(const char* bundleData, size_t bundleLength, StringRef* fileName)
+{
+    auto internalResult = toImpl(this)->initializeScriptWithBundle(bundleData, bundleLength, toImpl(fileName));
+    ScriptParserRef::InitializeScriptResult result;
+    if (internalResult.script) {
+        result.script = toRef(internalResult.script.value());
+    } else {
+        result.parseErrorMessage = toRef(internalResult.parseErrorMessage);
+        result.parseErrorCode = (Escargot::ErrorObjectRef::Code)internalResult.parseErrorCode;
+    }
+
+    return result;
+}
+
+bool ScriptParserRef::writeBundle(ScriptRef* script, const char* bundleFilePath)
+{
+    return toImpl(this)->writeBundle(toImpl(script), bundleFilePath);
+}
+
 bool ScriptRef::isModule()
 {
     return toImpl(this)->isModule();
@@ -2484,9 +2543,25 @@ StringRef* ScriptRef::sourceCode()
 
 ValueRef* ScriptRef::execute(ExecutionStateRef* state)
 {
+    RELEASE_ASSERT(toImpl(state)->context()->vmInstance() == toImpl(this)->context()->vmInstance());
     return toRef(toImpl(this)->execute(*toImpl(state)));
 }
 
+bool ScriptRef::shareAcrossContexts()
+{
+    Script* script = toImpl(this);
+    if (script->isModule()) {
+        return false;
+    }
+    script->setSharedAcrossContexts();
+    return true;
+}
+
+bool ScriptRef::isSharedAcrossContexts()
+{
+    return toImpl(this)->isSharedAcrossContexts();
+}
+
 size_t ScriptRef::moduleRequestsLength()
 {
     return toImpl(this)->moduleRequestsLength();
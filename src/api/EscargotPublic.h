@@ -533,6 +533,17 @@ public:
 
     void clearCachesRelatedWithContext();
 
+    // budget of compiled bytecode in bytes. when exceeded, GC releases bytecode of least recently called functions
+    size_t maxCompiledByteCodeSize();
+    void setMaxCompiledByteCodeSize(size_t size);
+
+    // warm-up profile keeps runtime feedback (executed functions, inline cache states, operand types, hot call targets)
+    // across restarts. export it before exit, and import it on next start before loading scripts.
+    // imported feedback compiles profiled functions as soon as their script is loaded and pre-seeds their caches.
+    // profile is only accepted by the same engine build. both return false on failure
+    bool exportWarmUpProfile(const char* profileFilePath);
+    bool importWarmUpProfile(const char* profileFilePath);
+
     PlatformRef* platform();
 
     SymbolRef* toStringTagSymbol();
@@ -1365,6 +1376,18 @@ public:
     };
 
     InitializeScriptResult initializeScript(StringRef* scriptSource, StringRef* fileName, bool isModule = false);
+
+    // load parse result of top-level scripts from cache files in cacheDirectory, and store them there after parsing
+    // function bodies are still compiled lazily. nullptr disables code cache (default)
+    void setCodeCacheDirectory(const char* cacheDirectory);
+
+    // load script from precompiled bundle written by writeBundle (e.g. escargot-bundler).
+    // bundle has bytecode of every function and no source code, so Function.prototype.toString returns placeholder
+    // and error positions are not available. bundleData can be released (or unmapped) after this call
+    InitializeScriptResult initializeScriptWithBundle(const char* bundleData, size_t bundleLength, StringRef* fileName);
+    // compile every function of script and write them into bundle file. script should not be executed yet.
+    // bundle can be loaded only by the same build of engine. modules are not supported
+    bool writeBundle(ScriptRef* script, const char* bundleFilePath);
 };
 
 class ESCARGOT_EXPORT ScriptRef {
@@ -1373,8 +1396,14 @@ public:
     bool isExecuted();
     StringRef* src();
     StringRef* sourceCode();
+    // state can belong to any ContextRef of the VMInstance which created this script
     ValueRef* execute(ExecutionStateRef* state);
 
+    // keeps compiled global code after execution, so script can be executed on every ContextRef of its VMInstance
+    // without parsing and generating bytecode again. module cannot be shared (returns false)
+    bool shareAcrossContexts();
+    bool isSharedAcrossContexts();
+
     size_t moduleRequestsLength();
     StringRef* moduleRequest(size_t i);
 };
@@ -0,0 +1,1663 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "CodeCache.h"
+#include "parser/Script.h"
+#include "parser/ScriptParser.h"
+#include "parser/CodeBlock.h"
+#include "interpreter/ByteCode.h"
+#include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
+#include "runtime/StringBuilder.h"
+#include "runtime/ScriptFunctionObject.h"
+#include "runtime/VMInstance.h"
+
+namespace Escargot {
+
+// bump this whenever layout of cache file or meaning of bytecode operands is changed
+static const uint32_t codeCacheVersion = 3;
+static const uint32_t codeCacheMagic = 0x43435345; // "ESCC"
+static const uint32_t codeCacheBundleMagic = 0x42435345; // "ESCB"
+
+static const uint8_t codeCacheByteCodeLengths[] = {
+#define ITER_BYTE_CODE(code, pushCount, popCount) \
+    (uint8_t)sizeof(code),
+
+    FOR_EACH_BYTECODE_OP(ITER_BYTE_CODE)
+#undef ITER_BYTE_CODE
+};
+
+// every flag of CodeBlock which is decided by parser
+#define FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(F)      \
+    F(m_isStrict)                                   \
+    F(m_isFunctionNameSaveOnHeap)                   \
+    F(m_isFunctionNameExplicitlyDeclared)           \
+    F(m_canUseIndexedVariableStorage)               \
+    F(m_canAllocateVariablesOnStack)                \
+    F(m_canAllocateEnvironmentOnStack)              \
+    F(m_hasDescendantUsesNonIndexedVariableStorage) \
+    F(m_hasEval)                                    \
+    F(m_hasWith)                                    \
+    F(m_inWith)                                     \
+    F(m_isEvalCode)                                 \
+    F(m_isEvalCodeInFunction)                       \
+    F(m_usesArgumentsObject)                        \
+    F(m_isFunctionExpression)                       \
+    F(m_isFunctionDeclaration)                      \
+    F(m_isArrowFunctionExpression)                  \
+    F(m_isClassConstructor)                         \
+    F(m_isDerivedClassConstructor)                  \
+    F(m_isClassMethod)                              \
+    F(m_isClassStaticMethod)                        \
+    F(m_isGenerator)                                \
+    F(m_isAsync)                                    \
+    F(m_needsVirtualIDOperation)                    \
+    F(m_hasImplicitFunctionName)                    \
+    F(m_hasArrowParameterPlaceHolder)               \
+    F(m_hasParameterOtherThanIdentifier)            \
+    F(m_allowSuperCall)                             \
+    F(m_allowSuperProperty)
+
+struct CodeCacheFileHeader {
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_engineHash;
+    uint64_t m_sourceHash;
+    uint64_t m_sourceLength;
+    uint64_t m_payloadLength;
+};
+
+enum CodeCacheStringKind : uint8_t {
+    Latin1StringKind,
+    UTF16StringKind,
+    SourceRangeStringKind, // StringView into script source
+};
+
+// kinds of operand which cannot be copied as is
+enum CodeCacheRelocationKind : uint8_t {
+    AtomicStringRelocation,
+    PropertyNameRelocation,
+    StringRelocation,
+    StringValueRelocation,
+    ObjectFreezeValueRelocation,
+    CodeBlockRelocation,
+    BlockInfoRelocation,
+    GlobalVariableSlotRelocation,
+    ControlFlowRecordRelocation,
+    ErrorMessageRelocation,
+};
+
+static const uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+static const uint64_t fnvPrime = 1099511628211ULL;
+
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t length)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+static uint64_t engineHash()
+{
+    uint64_t hash = fnvOffsetBasis;
+    hash = hashBytes(hash, &codeCacheVersion, sizeof(codeCacheVersion));
+    hash = hashBytes(hash, codeCacheByteCodeLengths, sizeof(codeCacheByteCodeLengths));
+    const uint32_t sizes[] = { sizeof(size_t), sizeof(Value), sizeof(ByteCodeLOC), sizeof(ExtendedNodeLOC), sizeof(ObjectStructurePropertyName) };
+    hash = hashBytes(hash, sizes, sizeof(sizes));
+#ifndef NDEBUG
+    hash = hashBytes(hash, "debug", 5);
+#endif
+#if defined(ENABLE_COMPACT_BYTECODE)
+    hash = hashBytes(hash, "compact", 7);
+#endif
+    return hash;
+}
+
+static uint64_t sourceHash(const StringView& source)
+{
+    auto data = source.bufferAccessData();
+    uint64_t hash = fnvOffsetBasis;
+    uint8_t is8Bit = data.has8BitContent;
+    hash = hashBytes(hash, &is8Bit, sizeof(is8Bit));
+    return hashBytes(hash, data.buffer, data.length * (data.has8BitContent ? sizeof(LChar) : sizeof(char16_t)));
+}
+
+static std::string cacheFilePath(const char* directory, uint64_t sourceHash, size_t sourceLength)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%llx.cache", (unsigned long long)(sourceHash ^ engineHash()), (unsigned long long)sourceLength);
+    std::string path(directory);
+    if (path.length() && path.back() != '/') {
+        path += '/';
+    }
+    return path + name;
+}
+
+static Opcode opcodeOfRelocatedByteCode(ByteCode* code)
+{
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+    static std::unordered_map<void*, Opcode> opcodeByAddress;
+    if (UNLIKELY(opcodeByAddress.empty())) {
+        for (size_t i = 0; i < OpcodeKindEnd; i++) {
+            opcodeByAddress.insert(std::make_pair(g_opcodeTable.m_table[i], (Opcode)i));
+        }
+    }
+    auto iter = opcodeByAddress.find(code->m_opcodeInAddress);
+    return iter == opcodeByAddress.end() ? OpcodeKindEnd : iter->second;
+#else
+    return code->m_opcode;
+#endif
+}
+
+static Opcode opcodeOfLoadedByteCode(ByteCode* code)
+{
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+static size_t executionPauseTailDataLength(ExecutionPause* code)
+{
+    if (code->m_reason == ExecutionPause::Reason::Yield) {
+        return code->m_yieldData.m_tailDataLength;
+    } else if (code->m_reason == ExecutionPause::Reason::Await) {
+        return code->m_awaitData.m_tailDataLength;
+    } else if (code->m_reason == ExecutionPause::Reason::AsyncGeneratorInitialize) {
+        return code->m_asyncGeneratorInitializeData.m_tailDataLength;
+    }
+    return 0;
+}
+
+class CodeCacheWriter {
+public:
+    CodeCacheWriter(Context* context, Script* script, bool isBundle)
+        : m_context(context)
+        , m_source(script->topCodeBlock()->src())
+        , m_isBundle(isBundle)
+        , m_isValid(true)
+        , m_codeBase(nullptr)
+        , m_copyBase(nullptr)
+    {
+    }
+
+    // returns false if script has something that cannot be written into cache file
+    bool write(InterpretedCodeBlock* topCodeBlock, std::vector<char>& payload)
+    {
+        writeCodeBlock(topCodeBlock);
+        writeByteCodeBlock(topCodeBlock->byteCodeBlock());
+        if (m_isBundle) {
+            // bytecode of functions follows in the order of code block tree
+            for (size_t i = 1; i < m_codeBlocks.size() && m_isValid; i++) {
+                if (!m_codeBlocks[i]->byteCodeBlock()) {
+                    m_isValid = false;
+                    break;
+                }
+                writeByteCodeBlock(m_codeBlocks[i]->byteCodeBlock());
+            }
+        }
+        if (!m_isValid) {
+            return false;
+        }
+
+        // string table goes first because reader needs it while reading others
+        std::vector<char> body;
+        std::swap(body, m_out);
+        writeStringTable();
+        m_out.insert(m_out.end(), body.begin(), body.end());
+        std::swap(payload, m_out);
+        return true;
+    }
+
+private:
+    template <typename T>
+    void put(const T& value)
+    {
+        const char* p = (const char*)&value;
+        m_out.insert(m_out.end(), p, p + sizeof(T));
+    }
+
+    void putBytes(const void* data, size_t length)
+    {
+        const char* p = (const char*)data;
+        m_out.insert(m_out.end(), p, p + length);
+    }
+
+    uint64_t stringIndex(String* str)
+    {
+        auto iter = m_stringIndex.find(str);
+        if (iter != m_stringIndex.end()) {
+            return iter->second;
+        }
+        uint64_t idx = m_strings.size();
+        m_strings.push_back(str);
+        m_stringIndex.insert(std::make_pair(str, idx));
+        return idx;
+    }
+
+    void putAtomicString(const AtomicString& str)
+    {
+        put(stringIndex(str.string()));
+    }
+
+    bool sourceRangeOf(String* str, uint64_t& start)
+    {
+        auto data = str->bufferAccessData();
+        auto sourceData = m_source.bufferAccessData();
+        if (data.has8BitContent != sourceData.has8BitContent) {
+            return false;
+        }
+        size_t charSize = sourceData.has8BitContent ? sizeof(LChar) : sizeof(char16_t);
+        const char* begin = (const char*)sourceData.buffer;
+        const char* p = (const char*)data.buffer;
+        if (p < begin || p + data.length * charSize > begin + sourceData.length * charSize) {
+            return false;
+        }
+        start = (p - begin) / charSize;
+        return true;
+    }
+
+    void writeStringTable()
+    {
+        put((uint64_t)m_strings.size());
+        for (size_t i = 0; i < m_strings.size(); i++) {
+            String* str = m_strings[i];
+            auto data = str->bufferAccessData();
+            uint64_t start;
+            if (!m_isBundle && str->isStringView() && data.length && sourceRangeOf(str, start)) {
+                put((uint8_t)SourceRangeStringKind);
+                put(start);
+                put((uint64_t)data.length);
+            } else if (data.has8BitContent) {
+                put((uint8_t)Latin1StringKind);
+                put((uint64_t)data.length);
+                putBytes(data.buffer, data.length * sizeof(LChar));
+            } else {
+                put((uint8_t)UTF16StringKind);
+                put((uint64_t)data.length);
+                putBytes(data.buffer, data.length * sizeof(char16_t));
+            }
+        }
+    }
+
+    void writeCodeBlock(InterpretedCodeBlock* cb)
+    {
+        m_codeBlockIndex.insert(std::make_pair(cb, (uint64_t)m_codeBlocks.size()));
+        m_codeBlocks.push_back(cb);
+
+        uint32_t flags = 0;
+        uint32_t bit = 0;
+#define WRITE_FLAG(name)                          \
+    flags |= (uint32_t)(cb->name ? 1 : 0) << bit; \
+    bit++;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(WRITE_FLAG)
+#undef WRITE_FLAG
+        put(flags);
+        put(cb->m_functionLength);
+        putAtomicString(cb->m_functionName);
+
+        uint64_t srcStart = 0;
+        uint64_t srcLength = m_isBundle ? 0 : cb->m_src.length();
+        if (srcLength && !sourceRangeOf(&cb->m_src, srcStart)) {
+            m_isValid = false;
+        }
+        put(srcStart);
+        put(srcLength);
+        put((uint64_t)cb->m_functionStart.line);
+        put((uint64_t)cb->m_functionStart.column);
+        put((uint64_t)cb->m_functionStart.index);
+
+        put((uint64_t)cb->m_parameterNames.size());
+        for (size_t i = 0; i < cb->m_parameterNames.size(); i++) {
+            putAtomicString(cb->m_parameterNames[i]);
+        }
+        put((uint16_t)cb->m_parameterCount);
+        put((uint16_t)cb->m_functionBodyBlockIndex);
+        put(cb->m_identifierOnStackCount);
+        put(cb->m_identifierOnHeapCount);
+        put(cb->m_lexicalBlockStackAllocatedIdentifierMaximumDepth);
+        put((uint16_t)cb->m_lexicalBlockIndexFunctionLocatedIn);
+
+        put((uint64_t)cb->m_identifierInfos.size());
+        for (size_t i = 0; i < cb->m_identifierInfos.size(); i++) {
+            const InterpretedCodeBlock::IdentifierInfo& info = cb->m_identifierInfos[i];
+            uint8_t infoFlags = (info.m_needToAllocateOnStack ? 1 : 0) | (info.m_isMutable ? 2 : 0) | (info.m_isParameterName ? 4 : 0)
+                | (info.m_isExplicitlyDeclaredOrParameterName ? 8 : 0) | (info.m_isVarDeclaration ? 16 : 0);
+            put(infoFlags);
+            put((uint64_t)info.m_indexForIndexedStorage);
+            putAtomicString(info.m_name);
+        }
+        put((uint8_t)(cb->m_identifierInfoMap ? 1 : 0));
+
+        put((uint64_t)cb->m_blockInfos.size());
+        for (size_t i = 0; i < cb->m_blockInfos.size(); i++) {
+            InterpretedCodeBlock::BlockInfo* info = cb->m_blockInfos[i];
+            put((uint16_t)info->m_nodeType);
+            put((uint8_t)((info->m_canAllocateEnvironmentOnStack ? 1 : 0) | (info->m_shouldAllocateEnvironment ? 2 : 0)));
+            put((uint16_t)info->m_parentBlockIndex);
+            put((uint16_t)info->m_blockIndex);
+            put((uint64_t)info->m_identifiers.size());
+            for (size_t j = 0; j < info->m_identifiers.size(); j++) {
+                const InterpretedCodeBlock::BlockIdentifierInfo& id = info->m_identifiers[j];
+                put((uint8_t)((id.m_needToAllocateOnStack ? 1 : 0) | (id.m_isMutable ? 2 : 0)));
+                put((uint64_t)id.m_indexForIndexedStorage);
+                putAtomicString(id.m_name);
+            }
+        }
+
+        uint64_t childCount = 0;
+        for (InterpretedCodeBlock* child = cb->firstChild(); child; child = child->nextSibling()) {
+            childCount++;
+        }
+        put(childCount);
+        for (InterpretedCodeBlock* child = cb->firstChild(); child; child = child->nextSibling()) {
+            writeCodeBlock(child);
+        }
+    }
+
+    void addRelocation(void* field, size_t fieldSize, CodeCacheRelocationKind kind, uint64_t payload)
+    {
+        uint64_t offset = (char*)field - m_codeBase;
+        memset(m_copyBase + offset, 0, fieldSize);
+        m_relocations.push_back(std::make_tuple(offset, kind, payload));
+    }
+
+    void relocateAtomicString(AtomicString& field)
+    {
+        addRelocation(&field, sizeof(AtomicString), AtomicStringRelocation, stringIndex(field.string()));
+    }
+
+    void relocateString(String*& field)
+    {
+        addRelocation(&field, sizeof(String*), StringRelocation, stringIndex(field));
+    }
+
+    void relocatePropertyName(ObjectStructurePropertyName& field)
+    {
+        if (!field.hasAtomicString()) {
+            m_isValid = false;
+            return;
+        }
+        addRelocation(&field, sizeof(ObjectStructurePropertyName), PropertyNameRelocation, stringIndex(field.asAtomicString().string()));
+    }
+
+    void relocateValue(Value& field)
+    {
+        if (!field.isPointerValue()) {
+            return;
+        }
+        if (field.isString()) {
+            addRelocation(&field, sizeof(Value), StringValueRelocation, stringIndex(field.asString()));
+        } else if (field.asPointerValue() == m_context->globalObject()->objectFreeze()) {
+            addRelocation(&field, sizeof(Value), ObjectFreezeValueRelocation, 0);
+        } else {
+            m_isValid = false;
+        }
+    }
+
+    void relocateCodeBlock(CodeBlock*& field)
+    {
+        uint64_t idx = UINT64_MAX;
+        if (field) {
+            auto iter = m_codeBlockIndex.find(field);
+            if (iter == m_codeBlockIndex.end()) {
+                m_isValid = false;
+                return;
+            }
+            idx = iter->second;
+        }
+        addRelocation(&field, sizeof(CodeBlock*), CodeBlockRelocation, idx);
+    }
+
+    void relocateBlockInfo(InterpretedCodeBlock::BlockInfo*& field, InterpretedCodeBlock* owner)
+    {
+        for (size_t i = 0; i < owner->m_blockInfos.size(); i++) {
+            if (owner->m_blockInfos[i] == field) {
+                addRelocation(&field, sizeof(InterpretedCodeBlock::BlockInfo*), BlockInfoRelocation, i);
+                return;
+            }
+        }
+        m_isValid = false;
+    }
+
+    String* classSourcePlaceholder(CreateClass* code)
+    {
+        StringBuilder builder;
+        builder.appendString("class ");
+        if (code->m_codeBlock) {
+            builder.appendString(code->m_codeBlock->functionName().string());
+        }
+        builder.appendString(" { [native code] }");
+        return builder.finalize();
+    }
+
+    void writeByteCodeBlock(ByteCodeBlock* block)
+    {
+        // relocations are offsets into code of this block only
+        m_relocations.clear();
+
+        InterpretedCodeBlock* owner = block->m_codeBlock;
+        put((uint8_t)((block->m_isEvalMode ? 1 : 0) | (block->m_isOnGlobal ? 2 : 0) | (block->m_shouldClearStack ? 4 : 0)));
+        put((uint16_t)block->m_requiredRegisterFileSizeInValueSize);
+
+        put((uint64_t)block->m_numeralLiteralData.size());
+        for (size_t i = 0; i < block->m_numeralLiteralData.size(); i++) {
+            if (block->m_numeralLiteralData[i].isPointerValue()) {
+                m_isValid = false;
+            }
+            putBytes(&block->m_numeralLiteralData[i], sizeof(Value));
+        }
+
+        std::vector<char> code(block->m_code.data(), block->m_code.data() + block->m_code.size());
+        m_codeBase = block->m_code.data();
+        m_copyBase = code.data();
+        std::vector<ControlFlowRecord*> records;
+        std::vector<const char*> errorMessages;
+
+        size_t position = 0;
+        size_t end = code.size();
+        while (position < end && m_isValid) {
+            ByteCode* currentCode = (ByteCode*)(m_codeBase + position);
+            ByteCode* copiedCode = (ByteCode*)(m_copyBase + position);
+            Opcode opcode = opcodeOfRelocatedByteCode(currentCode);
+            if (opcode >= OpcodeKindEnd) {
+                m_isValid = false;
+                break;
+            }
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+            copiedCode->m_opcodeInAddress = (void*)opcode;
+#endif
+
+            switch (opcode) {
+            case LoadLiteralOpcode:
+            case LoadLiteralAndBinaryPlusOpcode:
+                relocateValue(((LoadLiteral*)currentCode)->m_value);
+                break;
+            case LoadRegexpOpcode:
+                relocateString(((LoadRegexp*)currentCode)->m_body);
+                relocateString(((LoadRegexp*)currentCode)->m_option);
+                break;
+            case LoadByNameOpcode:
+                relocateAtomicString(((LoadByName*)currentCode)->m_name);
+                break;
+            case StoreByNameOpcode:
+                relocateAtomicString(((StoreByName*)currentCode)->m_name);
+                break;
+            case InitializeByNameOpcode:
+                relocateAtomicString(((InitializeByName*)currentCode)->m_name);
+                break;
+            case ResolveNameAddressOpcode:
+                relocateAtomicString(((ResolveNameAddress*)currentCode)->m_name);
+                break;
+            case StoreByNameWithAddressOpcode:
+                relocateAtomicString(((StoreByNameWithAddress*)currentCode)->m_name);
+                break;
+            case ObjectDefineOwnPropertyWithNameOperationOpcode:
+                relocateAtomicString(((ObjectDefineOwnPropertyWithNameOperation*)currentCode)->m_propertyName);
+                break;
+            case InitializeObjectLiteralPropertyOpcode:
+                relocateAtomicString(((InitializeObjectLiteralProperty*)currentCode)->m_propertyName);
+                break;
+            case GetMethodOpcode:
+                relocateAtomicString(((GetMethod*)currentCode)->m_propertyName);
+                break;
+            case InitializeGlobalVariableOpcode:
+                relocateAtomicString(((InitializeGlobalVariable*)currentCode)->m_variableName);
+                break;
+            case UnaryTypeofOpcode:
+                relocateAtomicString(((UnaryTypeof*)currentCode)->m_id);
+                break;
+            case UnaryDeleteOpcode:
+                relocateAtomicString(((UnaryDelete*)currentCode)->m_id);
+                break;
+            case CallFunctionComplexCaseOpcode: {
+                CallFunctionComplexCase* cd = (CallFunctionComplexCase*)currentCode;
+                if (cd->m_kind == CallFunctionComplexCase::InWithScope) {
+                    relocateAtomicString(cd->m_calleeName);
+                }
+                break;
+            }
+            case GetObjectPreComputedCaseOpcode:
+            case GetObjectPreComputedCaseAndCallOpcode:
+                relocatePropertyName(((GetObjectPreComputedCase*)currentCode)->m_propertyName);
+                break;
+            case SetObjectPreComputedCaseOpcode:
+                relocatePropertyName(((SetObjectPreComputedCase*)currentCode)->m_propertyName);
+                break;
+            case GetGlobalVariableOpcode: {
+                GetGlobalVariable* cd = (GetGlobalVariable*)currentCode;
+                addRelocation(&cd->m_slotIndex, sizeof(size_t), GlobalVariableSlotRelocation, stringIndex(m_context->vmInstance()->globalVariableAccessCacheSlotName(cd->m_slotIndex).string()));
+                break;
+            }
+            case SetGlobalVariableOpcode: {
+                SetGlobalVariable* cd = (SetGlobalVariable*)currentCode;
+                addRelocation(&cd->m_slotIndex, sizeof(size_t), GlobalVariableSlotRelocation, stringIndex(m_context->vmInstance()->globalVariableAccessCacheSlotName(cd->m_slotIndex).string()));
+                break;
+            }
+            case CreateFunctionOpcode:
+                relocateCodeBlock(((CreateFunction*)currentCode)->m_codeBlock);
+                break;
+            case CreateClassOpcode: {
+                CreateClass* cd = (CreateClass*)currentCode;
+                relocateCodeBlock(cd->m_codeBlock);
+                if (m_isBundle) {
+                    // source of class is not shipped with bundle
+                    addRelocation(&cd->m_classSrc, sizeof(String*), StringRelocation, stringIndex(classSourcePlaceholder(cd)));
+                } else {
+                    relocateString(cd->m_classSrc);
+                }
+                break;
+            }
+            case BlockOperationOpcode:
+                relocateBlockInfo(((BlockOperation*)currentCode)->m_blockInfo, owner);
+                break;
+            case ReplaceBlockLexicalEnvironmentOperationOpcode:
+                relocateBlockInfo(((ReplaceBlockLexicalEnvironmentOperation*)currentCode)->m_blockInfo, owner);
+                break;
+            case JumpComplexCaseOpcode: {
+                JumpComplexCase* cd = (JumpComplexCase*)currentCode;
+                if (cd->m_controlFlowRecord->reason() != ControlFlowRecord::NeedsJump) {
+                    m_isValid = false;
+                    break;
+                }
+                addRelocation(&cd->m_controlFlowRecord, sizeof(ControlFlowRecord*), ControlFlowRecordRelocation, records.size());
+                records.push_back(cd->m_controlFlowRecord);
+                break;
+            }
+            case ThrowStaticErrorOperationOpcode: {
+                ThrowStaticErrorOperation* cd = (ThrowStaticErrorOperation*)currentCode;
+                addRelocation(&cd->m_errorMessage, sizeof(const char*), ErrorMessageRelocation, errorMessages.size());
+                errorMessages.push_back(cd->m_errorMessage);
+                relocateAtomicString(cd->m_templateDataString);
+                break;
+            }
+            case JumpOpcode:
+                ((Jump*)copiedCode)->m_jumpPosition -= (size_t)m_codeBase;
+                break;
+            case JumpIfTrueOpcode:
+            case JumpIfFalseOpcode:
+            case JumpIfRelationOpcode:
+            case JumpIfEqualOpcode:
+                ((JumpByteCode*)copiedCode)->m_jumpPosition -= (size_t)m_codeBase;
+                break;
+            case ExecutionResumeOpcode:
+                // refers ExecutionPauser of running generator
+                m_isValid = false;
+                break;
+            case ExecutionPauseOpcode:
+                position += executionPauseTailDataLength((ExecutionPause*)currentCode);
+                break;
+            default:
+                break;
+            }
+
+            position += codeCacheByteCodeLengths[opcode];
+        }
+
+        put((uint64_t)code.size());
+        put((uint64_t)block->m_code.capacity());
+        putBytes(code.data(), code.size());
+
+        put((uint64_t)m_relocations.size());
+        for (size_t i = 0; i < m_relocations.size(); i++) {
+            put(std::get<0>(m_relocations[i]));
+            put((uint8_t)std::get<1>(m_relocations[i]));
+            put(std::get<2>(m_relocations[i]));
+        }
+
+        put((uint64_t)records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            put((uint64_t)records[i]->wordValue());
+            put((uint64_t)records[i]->count());
+            put((uint64_t)records[i]->outerLimitCount());
+        }
+
+        put((uint64_t)errorMessages.size());
+        for (size_t i = 0; i < errorMessages.size(); i++) {
+            size_t length = strlen(errorMessages[i]);
+            put((uint64_t)length);
+            putBytes(errorMessages[i], length);
+        }
+    }
+
+    Context* m_context;
+    const StringView& m_source;
+    bool m_isBundle;
+    bool m_isValid;
+    std::vector<char> m_out;
+
+    std::vector<String*> m_strings;
+    std::unordered_map<String*, uint64_t> m_stringIndex;
+    std::vector<InterpretedCodeBlock*> m_codeBlocks;
+    std::unordered_map<CodeBlock*, uint64_t> m_codeBlockIndex;
+
+    char* m_codeBase;
+    char* m_copyBase;
+    std::vector<std::tuple<uint64_t, CodeCacheRelocationKind, uint64_t>> m_relocations;
+};
+
+class CodeCacheReader {
+public:
+    CodeCacheReader(Context* context, const StringView& source, const char* data, size_t length)
+        : m_context(context)
+        , m_source(source)
+        , m_cursor(data)
+        , m_end(data + length)
+        , m_hasError(false)
+    {
+    }
+
+    bool hasError()
+    {
+        return m_hasError || m_cursor != m_end;
+    }
+
+    // bytecode of every function follows global code in bundle
+    bool readFunctionByteCodeBlocks()
+    {
+        for (size_t i = 1; i < m_codeBlocks.size() && !m_hasError; i++) {
+            ByteCodeBlock* block = readByteCodeBlock(m_codeBlocks[i]);
+            if (!block) {
+                return false;
+            }
+            m_codeBlocks[i]->m_byteCodeBlock = block;
+        }
+        return !m_hasError;
+    }
+
+    void readStringTable()
+    {
+        uint64_t count = get<uint64_t>();
+        if (!ensure(count <= (uint64_t)(m_end - m_cursor))) {
+            return;
+        }
+        m_stringEntries.resize(count);
+        m_strings.resize(count, nullptr);
+        for (size_t i = 0; i < count && !m_hasError; i++) {
+            StringEntry& entry = m_stringEntries[i];
+            entry.m_kind = get<uint8_t>();
+            if (entry.m_kind == SourceRangeStringKind) {
+                entry.m_start = get<uint64_t>();
+                entry.m_length = get<uint64_t>();
+                ensure(entry.m_start <= m_source.length() && entry.m_length <= m_source.length() - entry.m_start);
+            } else {
+                entry.m_length = get<uint64_t>();
+                size_t charSize = entry.m_kind == Latin1StringKind ? sizeof(LChar) : sizeof(char16_t);
+                if (ensure(entry.m_kind <= UTF16StringKind && entry.m_length <= (uint64_t)(m_end - m_cursor) / charSize)) {
+                    entry.m_data = m_cursor;
+                    m_cursor += entry.m_length * charSize;
+                }
+            }
+        }
+    }
+
+    InterpretedCodeBlock* readCodeBlock(Script* script, InterpretedCodeBlock* parent)
+    {
+        uint32_t flags = get<uint32_t>();
+        uint16_t functionLength = get<uint16_t>();
+        AtomicString functionName = atomicString(get<uint64_t>());
+
+        uint64_t srcStart = get<uint64_t>();
+        uint64_t srcLength = get<uint64_t>();
+        size_t line = get<uint64_t>();
+        size_t column = get<uint64_t>();
+        size_t index = get<uint64_t>();
+        if (!ensure(srcStart <= m_source.length() && srcLength <= m_source.length() - srcStart)) {
+            return nullptr;
+        }
+
+        StringView src = parent ? StringView(m_source, srcStart, srcStart + srcLength) : m_source;
+        InterpretedCodeBlock* cb = new InterpretedCodeBlock(m_context, script, src, ExtendedNodeLOC(line, column, index), parent);
+        m_codeBlocks.push_back(cb);
+
+        uint32_t bit = 0;
+#define READ_FLAG(name)            \
+    cb->name = (flags >> bit) & 1; \
+    bit++;
+        FOR_EACH_CODE_CACHE_CODE_BLOCK_FLAG(READ_FLAG)
+#undef READ_FLAG
+        cb->m_functionLength = functionLength;
+        cb->m_functionName = functionName;
+
+        uint64_t parameterNamesCount = get<uint64_t>();
+        if (!ensureCount(parameterNamesCount)) {
+            return nullptr;
+        }
+        cb->m_parameterNames.resizeWithUninitializedValues(parameterNamesCount);
+        for (size_t i = 0; i < parameterNamesCount; i++) {
+            cb->m_parameterNames[i] = atomicString(get<uint64_t>());
+        }
+        cb->m_parameterCount = get<uint16_t>();
+        cb->m_functionBodyBlockIndex = get<uint16_t>();
+        cb->m_identifierOnStackCount = get<uint16_t>();
+        cb->m_identifierOnHeapCount = get<uint16_t>();
+        cb->m_lexicalBlockStackAllocatedIdentifierMaximumDepth = get<uint16_t>();
+        cb->m_lexicalBlockIndexFunctionLocatedIn = get<uint16_t>();
+
+        uint64_t identifierCount = get<uint64_t>();
+        if (!ensureCount(identifierCount)) {
+            return nullptr;
+        }
+        cb->m_identifierInfos.resize(identifierCount);
+        for (size_t i = 0; i < identifierCount; i++) {
+            InterpretedCodeBlock::IdentifierInfo info;
+            uint8_t infoFlags = get<uint8_t>();
+            info.m_needToAllocateOnStack = infoFlags & 1;
+            info.m_isMutable = infoFlags & 2;
+            info.m_isParameterName = infoFlags & 4;
+            info.m_isExplicitlyDeclaredOrParameterName = infoFlags & 8;
+            info.m_isVarDeclaration = infoFlags & 16;
+            info.m_indexForIndexedStorage = get<uint64_t>();
+            info.m_name = atomicString(get<uint64_t>());
+            cb->m_identifierInfos[i] = info;
+        }
+        if (get<uint8_t>()) {
+            cb->m_identifierInfoMap = new (GC) FunctionContextVarMap;
+            for (size_t i = 0; i < identifierCount; i++) {
+                cb->m_identifierInfoMap->insert(std::make_pair(cb->m_identifierInfos[i].m_name, i));
+            }
+        }
+
+        uint64_t blockCount = get<uint64_t>();
+        if (!ensureCount(blockCount)) {
+            return nullptr;
+        }
+        cb->m_blockInfos.resizeWithUninitializedValues(blockCount);
+        for (size_t i = 0; i < blockCount; i++) {
+            InterpretedCodeBlock::BlockInfo* info = new InterpretedCodeBlock::BlockInfo(
+#ifndef NDEBUG
+                ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+#endif
+                );
+            info->m_nodeType = (ASTNodeType)get<uint16_t>();
+            uint8_t blockFlags = get<uint8_t>();
+            info->m_canAllocateEnvironmentOnStack = blockFlags & 1;
+            info->m_shouldAllocateEnvironment = blockFlags & 2;
+            info->m_parentBlockIndex = get<uint16_t>();
+            info->m_blockIndex = get<uint16_t>();
+
+            uint64_t idCount = get<uint64_t>();
+            if (!ensureCount(idCount)) {
+                return nullptr;
+            }
+            info->m_identifiers.resizeWithUninitializedValues(idCount);
+            for (size_t j = 0; j < idCount; j++) {
+                InterpretedCodeBlock::BlockIdentifierInfo id;
+                uint8_t idFlags = get<uint8_t>();
+                id.m_needToAllocateOnStack = idFlags & 1;
+                id.m_isMutable = idFlags & 2;
+                id.m_indexForIndexedStorage = get<uint64_t>();
+                id.m_name = atomicString(get<uint64_t>());
+                info->m_identifiers[j] = id;
+            }
+            cb->m_blockInfos[i] = info;
+        }
+
+        uint64_t childCount = get<uint64_t>();
+        if (!ensureCount(childCount)) {
+            return nullptr;
+        }
+        InterpretedCodeBlock* lastChild = nullptr;
+        for (size_t i = 0; i < childCount && !m_hasError; i++) {
+            InterpretedCodeBlock* child = readCodeBlock(script, cb);
+            if (!child) {
+                return nullptr;
+            }
+            cb->appendChild(child, lastChild);
+            lastChild = child;
+        }
+
+        return cb;
+    }
+
+    ByteCodeBlock* readByteCodeBlock(InterpretedCodeBlock* owner)
+    {
+        uint8_t blockFlags = get<uint8_t>();
+        uint16_t registerSize = get<uint16_t>();
+
+        uint64_t numeralCount = get<uint64_t>();
+        if (!ensure(numeralCount <= (uint64_t)(m_end - m_cursor) / sizeof(Value))) {
+            return nullptr;
+        }
+        const char* numerals = m_cursor;
+        m_cursor += numeralCount * sizeof(Value);
+
+        uint64_t codeSize = get<uint64_t>();
+        uint64_t codeCapacity = get<uint64_t>();
+        if (!ensure(codeSize <= (uint64_t)(m_end - m_cursor) && codeCapacity >= codeSize)) {
+            return nullptr;
+        }
+        const char* code = m_cursor;
+        m_cursor += codeSize;
+
+        ByteCodeBlock* block = new ByteCodeBlock(owner);
+        block->m_isEvalMode = blockFlags & 1;
+        block->m_isOnGlobal = blockFlags & 2;
+        block->m_shouldClearStack = blockFlags & 4;
+        block->m_requiredRegisterFileSizeInValueSize = registerSize;
+
+        block->m_numeralLiteralData.resizeWithUninitializedValues(numeralCount);
+        memcpy(block->m_numeralLiteralData.data(), numerals, numeralCount * sizeof(Value));
+
+        block->m_code.reserve(codeCapacity);
+        block->m_code.resizeWithUninitializedValues(codeSize);
+        memcpy(block->m_code.data(), code, codeSize);
+
+        // relocate operands before opcodes so reader can see original opcode while relocating
+        uint64_t relocationCount = get<uint64_t>();
+        if (!ensureCount(relocationCount)) {
+            return nullptr;
+        }
+        std::vector<std::tuple<uint64_t, uint8_t, uint64_t>> relocations(relocationCount);
+        for (size_t i = 0; i < relocationCount; i++) {
+            uint64_t offset = get<uint64_t>();
+            uint8_t kind = get<uint8_t>();
+            uint64_t payload = get<uint64_t>();
+            relocations[i] = std::make_tuple(offset, kind, payload);
+        }
+
+        uint64_t recordCount = get<uint64_t>();
+        if (!ensureCount(recordCount)) {
+            return nullptr;
+        }
+        std::vector<ControlFlowRecord*> records(recordCount);
+        for (size_t i = 0; i < recordCount; i++) {
+            size_t wordValue = get<uint64_t>();
+            size_t count = get<uint64_t>();
+            size_t outerLimitCount = get<uint64_t>();
+            records[i] = new ControlFlowRecord(ControlFlowRecord::NeedsJump, wordValue, count, outerLimitCount);
+            block->m_literalData.pushBack(records[i]);
+        }
+
+        uint64_t messageCount = get<uint64_t>();
+        if (!ensureCount(messageCount)) {
+            return nullptr;
+        }
+        std::vector<char*> messages(messageCount);
+        for (size_t i = 0; i < messageCount; i++) {
+            uint64_t length = get<uint64_t>();
+            if (!ensure(length <= (uint64_t)(m_end - m_cursor))) {
+                return nullptr;
+            }
+            messages[i] = (char*)GC_MALLOC_ATOMIC(length + 1);
+            memcpy(messages[i], m_cursor, length);
+            messages[i][length] = 0;
+            m_cursor += length;
+            block->m_literalData.pushBack(messages[i]);
+        }
+
+        char* codeBase = block->m_code.data();
+        for (size_t i = 0; i < relocationCount && !m_hasError; i++) {
+            uint64_t offset = std::get<0>(relocations[i]);
+            uint64_t payload = std::get<2>(relocations[i]);
+            if (!ensure(offset <= codeSize && codeSize - offset >= sizeof(Value) && offset % sizeof(size_t) == 0)) {
+                break;
+            }
+            void* field = codeBase + offset;
+            switch (std::get<1>(relocations[i])) {
+            case AtomicStringRelocation:
+                *(AtomicString*)field = atomicString(payload);
+                break;
+            case PropertyNameRelocation:
+                *(ObjectStructurePropertyName*)field = ObjectStructurePropertyName(atomicString(payload));
+                break;
+            case StringRelocation:
+                *(String**)field = literalString(block, payload);
+                break;
+            case StringValueRelocation:
+                *(Value*)field = Value(literalString(block, payload));
+                break;
+            case ObjectFreezeValueRelocation:
+                *(Value*)field = Value(m_context->globalObject()->objectFreeze());
+                break;
+            case CodeBlockRelocation:
+                if (payload == UINT64_MAX) {
+                    *(CodeBlock**)field = nullptr;
+                } else if (ensure(payload < m_codeBlocks.size())) {
+                    *(CodeBlock**)field = m_codeBlocks[payload];
+                }
+                break;
+            case BlockInfoRelocation:
+                if (ensure(payload < owner->m_blockInfos.size())) {
+                    *(InterpretedCodeBlock::BlockInfo**)field = owner->m_blockInfos[payload];
+                }
+                break;
+            case GlobalVariableSlotRelocation:
+                *(size_t*)field = m_context->vmInstance()->globalVariableAccessCacheSlotIndex(atomicString(payload));
+                break;
+            case ControlFlowRecordRelocation:
+                if (ensure(payload < records.size())) {
+                    *(ControlFlowRecord**)field = records[payload];
+                }
+                break;
+            case ErrorMessageRelocation:
+                if (ensure(payload < messages.size())) {
+                    *(const char**)field = messages[payload];
+                }
+                break;
+            default:
+                ensure(false);
+                break;
+            }
+        }
+
+        size_t position = 0;
+        size_t codeBaseAddress = (size_t)codeBase;
+        while (position < codeSize && !m_hasError) {
+            ByteCode* currentCode = (ByteCode*)(codeBase + position);
+            Opcode opcode = opcodeOfLoadedByteCode(currentCode);
+            if (!ensure(opcode < OpcodeKindEnd && codeCacheByteCodeLengths[opcode] <= codeSize - position)) {
+                break;
+            }
+            currentCode->assignOpcodeInAddress();
+
+            switch (opcode) {
+            case JumpOpcode:
+                ensure(((Jump*)currentCode)->m_jumpPosition < codeSize);
+                ((Jump*)currentCode)->m_jumpPosition += codeBaseAddress;
+                break;
+            case JumpIfTrueOpcode:
+            case JumpIfFalseOpcode:
+            case JumpIfRelationOpcode:
+            case JumpIfEqualOpcode:
+                ensure(((JumpByteCode*)currentCode)->m_jumpPosition < codeSize);
+                ((JumpByteCode*)currentCode)->m_jumpPosition += codeBaseAddress;
+                break;
+            case ExecutionPauseOpcode:
+                position += executionPauseTailDataLength((ExecutionPause*)currentCode);
+                break;
+            default:
+                break;
+            }
+
+            position += codeCacheByteCodeLengths[opcode];
+        }
+        ensure(position == codeSize);
+
+        return block;
+    }
+
+private:
+    struct StringEntry {
+        uint8_t m_kind;
+        uint64_t m_start;
+        uint64_t m_length;
+        const char* m_data;
+    };
+
+    bool ensure(bool condition)
+    {
+        if (UNLIKELY(!condition)) {
+            m_hasError = true;
+        }
+        return !m_hasError;
+    }
+
+    // every counted item takes one byte at least
+    bool ensureCount(uint64_t count)
+    {
+        return ensure(count <= (uint64_t)(m_end - m_cursor));
+    }
+
+    template <typename T>
+    T get()
+    {
+        T value;
+        if (!ensure(sizeof(T) <= (size_t)(m_end - m_cursor))) {
+            memset(&value, 0, sizeof(T));
+            return value;
+        }
+        memcpy(&value, m_cursor, sizeof(T));
+        m_cursor += sizeof(T);
+        return value;
+    }
+
+    String* string(uint64_t idx)
+    {
+        if (!ensure(idx < m_strings.size())) {
+            return String::emptyString;
+        }
+        if (m_strings[idx]) {
+            return m_strings[idx];
+        }
+
+        StringEntry& entry = m_stringEntries[idx];
+        String* str;
+        if (entry.m_length == 0) {
+            str = String::emptyString;
+        } else if (entry.m_kind == SourceRangeStringKind) {
+            str = new StringView(m_source, entry.m_start, entry.m_start + entry.m_length);
+        } else if (entry.m_kind == Latin1StringKind) {
+            if (isAllASCII(entry.m_data, entry.m_length)) {
+                str = new ASCIIString(entry.m_data, entry.m_length);
+            } else {
+                str = new Latin1String((const LChar*)entry.m_data, entry.m_length);
+            }
+        } else {
+            UTF16StringData data;
+            data.resizeWithUninitializedValues(entry.m_length);
+            memcpy(data.data(), entry.m_data, entry.m_length * sizeof(char16_t));
+            str = new UTF16String(std::move(data));
+        }
+        m_strings[idx] = str;
+        return str;
+    }
+
+    String* literalString(ByteCodeBlock* block, uint64_t idx)
+    {
+        String* str = string(idx);
+        block->m_literalData.pushBack(str);
+        return str;
+    }
+
+    AtomicString atomicString(uint64_t idx)
+    {
+        String* str = string(idx);
+        if (str->length() == 0) {
+            return AtomicString();
+        }
+        return AtomicString(m_context, str);
+    }
+
+    Context* m_context;
+    const StringView& m_source;
+    const char* m_cursor;
+    const char* m_end;
+    bool m_hasError;
+
+    std::vector<StringEntry> m_stringEntries;
+    std::vector<String*> m_strings;
+    std::vector<InterpretedCodeBlock*> m_codeBlocks;
+};
+
+// write into temporary file first, so other process cannot see half-written file
+static bool writeCacheFile(const std::string& path, const CodeCacheFileHeader& header, const std::vector<char>& payload)
+{
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%p.tmp", (const void*)&payload);
+    std::string temporaryPath = path + suffix;
+
+    FILE* fp = fopen(temporaryPath.data(), "wb");
+    if (!fp) {
+        return false;
+    }
+    bool result = fwrite(&header, sizeof(CodeCacheFileHeader), 1, fp) == 1;
+    if (result && payload.size()) {
+        result = fwrite(payload.data(), payload.size(), 1, fp) == 1;
+    }
+    result = (fclose(fp) == 0) && result;
+
+    if (!result || rename(temporaryPath.data(), path.data()) != 0) {
+        remove(temporaryPath.data());
+        return false;
+    }
+    return true;
+}
+
+static bool readCacheFile(const std::string& path, std::vector<char>& content)
+{
+    FILE* fp = fopen(path.data(), "rb");
+    if (!fp) {
+        return false;
+    }
+
+    char buf[4096];
+    size_t readLength;
+    while ((readLength = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        content.insert(content.end(), buf, buf + readLength);
+    }
+    bool result = !ferror(fp);
+    fclose(fp);
+    return result;
+}
+
+Script* CodeCache::load(Context* context, const char* directory, String* fileName, const StringView& source)
+{
+    uint64_t hash = sourceHash(source);
+    std::vector<char> content;
+    if (!readCacheFile(cacheFilePath(directory, hash, source.length()), content) || content.size() < sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    CodeCacheFileHeader header;
+    memcpy(&header, content.data(), sizeof(CodeCacheFileHeader));
+    if (header.m_magic != codeCacheMagic || header.m_version != codeCacheVersion || header.m_engineHash != engineHash()
+        || header.m_sourceHash != hash || header.m_sourceLength != source.length()
+        || header.m_payloadLength != content.size() - sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    GC_disable();
+
+    CodeCacheReader reader(context, source, content.data() + sizeof(CodeCacheFileHeader), header.m_payloadLength);
+    Script* script = new Script(fileName, new StringView(source), nullptr, true);
+    InterpretedCodeBlock* topCodeBlock = nullptr;
+    ByteCodeBlock* byteCodeBlock = nullptr;
+
+    reader.readStringTable();
+    topCodeBlock = reader.readCodeBlock(script, nullptr);
+    if (topCodeBlock) {
+        byteCodeBlock = reader.readByteCodeBlock(topCodeBlock);
+    }
+
+    GC_enable();
+
+    if (!topCodeBlock || !byteCodeBlock || reader.hasError()) {
+        return nullptr;
+    }
+
+    topCodeBlock->m_byteCodeBlock = byteCodeBlock;
+    script->m_topCodeBlock = topCodeBlock;
+    return script;
+}
+
+void CodeCache::store(Context* context, const char* directory, Script* script)
+{
+    InterpretedCodeBlock* topCodeBlock = script->topCodeBlock();
+    if (!topCodeBlock->byteCodeBlock()) {
+        return;
+    }
+
+    std::vector<char> payload;
+    CodeCacheWriter writer(context, script, false);
+    if (!writer.write(topCodeBlock, payload)) {
+        return;
+    }
+
+    const StringView& source = topCodeBlock->src();
+    CodeCacheFileHeader header;
+    header.m_magic = codeCacheMagic;
+    header.m_version = codeCacheVersion;
+    header.m_engineHash = engineHash();
+    header.m_sourceHash = sourceHash(source);
+    header.m_sourceLength = source.length();
+    header.m_payloadLength = payload.size();
+
+    writeCacheFile(cacheFilePath(directory, header.m_sourceHash, source.length()), header, payload);
+}
+
+Script* CodeCache::loadBundle(Context* context, String* fileName, const char* data, size_t length)
+{
+    if (length < sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    CodeCacheFileHeader header;
+    memcpy(&header, data, sizeof(CodeCacheFileHeader));
+    if (header.m_magic != codeCacheBundleMagic || header.m_version != codeCacheVersion || header.m_engineHash != engineHash()
+        || header.m_sourceLength != 0 || header.m_payloadLength != length - sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    GC_disable();
+
+    StringView source;
+    CodeCacheReader reader(context, source, data + sizeof(CodeCacheFileHeader), header.m_payloadLength);
+    Script* script = new Script(fileName, String::emptyString, nullptr, true);
+    script->m_hasSourceCode = false;
+    InterpretedCodeBlock* topCodeBlock = nullptr;
+    ByteCodeBlock* byteCodeBlock = nullptr;
+
+    reader.readStringTable();
+    topCodeBlock = reader.readCodeBlock(script, nullptr);
+    if (topCodeBlock) {
+        byteCodeBlock = reader.readByteCodeBlock(topCodeBlock);
+    }
+    bool result = byteCodeBlock && reader.readFunctionByteCodeBlocks();
+
+    GC_enable();
+
+    if (!result || reader.hasError()) {
+        return nullptr;
+    }
+
+    topCodeBlock->m_byteCodeBlock = byteCodeBlock;
+    script->m_topCodeBlock = topCodeBlock;
+    return script;
+}
+
+static void compileEveryFunction(ExecutionState& state, InterpretedCodeBlock* codeBlock)
+{
+    for (InterpretedCodeBlock* child = codeBlock->firstChild(); child; child = child->nextSibling()) {
+        if (!child->byteCodeBlock()) {
+            state.context()->scriptParser().generateFunctionByteCode(state, child, SIZE_MAX);
+        }
+        compileEveryFunction(state, child);
+    }
+}
+
+bool CodeCache::storeBundle(Context* context, Script* script, const char* filePath)
+{
+    InterpretedCodeBlock* topCodeBlock = script->topCodeBlock();
+    if (script->isModule() || !script->hasSourceCode() || !topCodeBlock->byteCodeBlock()) {
+        return false;
+    }
+
+    // compiled ByteCodeBlocks should not be released until they are written
+    GC_disable();
+
+    std::vector<char> payload;
+    bool result;
+    try {
+        ExecutionState state(context);
+        compileEveryFunction(state, topCodeBlock);
+
+        CodeCacheWriter writer(context, script, true);
+        result = writer.write(topCodeBlock, payload);
+    } catch (const Value&) {
+        // syntax error in function body
+        result = false;
+    }
+
+    GC_enable();
+
+    if (!result) {
+        return false;
+    }
+
+    CodeCacheFileHeader header;
+    header.m_magic = codeCacheBundleMagic;
+    header.m_version = codeCacheVersion;
+    header.m_engineHash = engineHash();
+    header.m_sourceHash = 0;
+    header.m_sourceLength = 0;
+    header.m_payloadLength = payload.size();
+
+    return writeCacheFile(filePath, header, payload);
+}
+
+static const uint32_t warmUpProfileMagic = 0x50435345; // "ESCP"
+
+// calls fn(position, code, opcode) for every bytecode of relocated block
+template <typename Fn>
+static bool iterateRelocatedByteCode(ByteCodeBlock* block, const Fn& fn)
+{
+    char* codeBase = block->m_code.data();
+    size_t position = 0;
+    size_t end = block->m_code.size();
+    while (position < end) {
+        ByteCode* currentCode = (ByteCode*)(codeBase + position);
+        Opcode opcode = opcodeOfRelocatedByteCode(currentCode);
+        if (opcode >= OpcodeKindEnd) {
+            return false;
+        }
+        fn(position, currentCode, opcode);
+        if (opcode == ExecutionPauseOpcode) {
+            position += executionPauseTailDataLength((ExecutionPause*)currentCode);
+        }
+        position += codeCacheByteCodeLengths[opcode];
+    }
+    return true;
+}
+
+static void collectCodeBlocks(InterpretedCodeBlock* codeBlock, std::unordered_set<InterpretedCodeBlock*>& codeBlocks)
+{
+    codeBlocks.insert(codeBlock);
+    for (InterpretedCodeBlock* child = codeBlock->firstChild(); child; child = child->nextSibling()) {
+        collectCodeBlocks(child, codeBlocks);
+    }
+}
+
+uint64_t WarmUpProfile::functionKey(InterpretedCodeBlock* codeBlock)
+{
+    // global code has no start position of its own
+    return codeBlock->isGlobalScopeCodeBlock() ? std::numeric_limits<uint64_t>::max() : codeBlock->functionStart().index;
+}
+
+WarmUpProfile::Function* WarmUpProfile::findFunction(InterpretedCodeBlock* codeBlock)
+{
+    if (codeBlock->isEvalCode()) {
+        return nullptr;
+    }
+    auto scriptIter = m_functions.find(codeBlock->script()->src()->toNonGCUTF8StringData());
+    if (scriptIter == m_functions.end()) {
+        return nullptr;
+    }
+    auto iter = scriptIter->second.find(functionKey(codeBlock));
+    if (iter == scriptIter->second.end() || iter->second.m_sourceHash != sourceHash(codeBlock->src())) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+bool WarmUpProfile::write(VMInstance* instance, const char* filePath)
+{
+    WarmUpProfile profile;
+    std::unordered_set<InterpretedCodeBlock*> liveCodeBlocks;
+    std::vector<InterpretedCodeBlock*> callTargets;
+
+    auto& blocks = instance->compiledByteCodeBlocks();
+    for (size_t i = 0; i < blocks.size(); i++) {
+        ByteCodeBlock* block = blocks[i];
+        InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+        if (codeBlock->isEvalCode()) {
+            continue;
+        }
+        auto& functions = profile.m_functions[codeBlock->script()->src()->toNonGCUTF8StringData()];
+        auto insertResult = functions.insert(std::make_pair(functionKey(codeBlock), Function()));
+        if (!insertResult.second) {
+            // released ByteCodeBlock which is not collected yet
+            continue;
+        }
+        if (liveCodeBlocks.find(codeBlock) == liveCodeBlocks.end()) {
+            collectCodeBlocks(codeBlock->script()->topCodeBlock(), liveCodeBlocks);
+        }
+
+        Function& function = insertResult.first->second;
+        function.m_sourceHash = sourceHash(codeBlock->src());
+        function.m_byteCodeSize = block->m_code.size();
+
+        bool isValid = iterateRelocatedByteCode(block, [&](size_t position, ByteCode* currentCode, Opcode opcode) {
+            Site site;
+            site.m_position = position;
+            switch (opcode) {
+            case GetObjectPreComputedCaseOpcode:
+            case GetObjectPreComputedCaseAndCallOpcode: {
+                GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+                site.m_kind = GetObjectSite;
+                if (cd->m_cacheMissCount > PROPERTY_INLINE_CACHE_MAX_MISS_COUNT) {
+                    site.m_state = MegamorphicSite;
+                } else if (cd->m_inlineCache && cd->m_inlineCache->m_cache.size()) {
+                    site.m_state = (uint8_t)std::min(cd->m_inlineCache->m_cache.size(), (size_t)MegamorphicSite - 1);
+                } else {
+                    break;
+                }
+                site.m_propertyName = cd->m_propertyName.plainString()->toNonGCUTF8StringData();
+                function.m_sites.push_back(site);
+                break;
+            }
+            case SetObjectPreComputedCaseOpcode: {
+                SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+                site.m_kind = SetObjectSite;
+                if (cd->m_missCount > PROPERTY_INLINE_CACHE_MAX_MISS_COUNT) {
+                    site.m_state = MegamorphicSite;
+                } else if (cd->m_inlineCache && cd->m_inlineCache->m_cache.size()) {
+                    site.m_state = (uint8_t)std::min(cd->m_inlineCache->m_cache.size(), (size_t)MegamorphicSite - 1);
+                } else {
+                    break;
+                }
+                site.m_propertyName = cd->m_propertyName.plainString()->toNonGCUTF8StringData();
+                function.m_sites.push_back(site);
+                break;
+            }
+            case CallFunctionOpcode:
+                // code block of cached callee is used only if it is found in live scripts
+                if (((CallFunction*)currentCode)->m_inlineCache) {
+                    callTargets.push_back(((CallFunction*)currentCode)->m_inlineCache->m_cachedCodeBlock);
+                }
+                break;
+            case CallFunctionWithReceiverOpcode:
+                if (((CallFunctionWithReceiver*)currentCode)->m_inlineCache) {
+                    callTargets.push_back(((CallFunctionWithReceiver*)currentCode)->m_inlineCache->m_cachedCodeBlock);
+                }
+                break;
+#define RECORD_TYPE_FEEDBACK(BaseCodeName)                               \
+    case BaseCodeName##Opcode:                                           \
+    case BaseCodeName##Int32Opcode:                                      \
+    case BaseCodeName##DoubleOpcode:                                     \
+        if (((BaseCodeName*)currentCode)->m_typeFeedback) {              \
+            site.m_kind = TypeFeedbackSite;                              \
+            site.m_state = ((BaseCodeName*)currentCode)->m_typeFeedback; \
+            function.m_sites.push_back(site);                            \
+        }                                                                \
+        break;
+                FOR_EACH_QUICKENED_BYTECODE(RECORD_TYPE_FEEDBACK)
+#undef RECORD_TYPE_FEEDBACK
+            default:
+                break;
+            }
+        });
+        if (!isValid) {
+            function.m_sites.clear();
+        }
+    }
+
+    // hot call targets whose bytecode is released are compiled at once too
+    for (size_t i = 0; i < callTargets.size(); i++) {
+        InterpretedCodeBlock* codeBlock = callTargets[i];
+        if (liveCodeBlocks.find(codeBlock) == liveCodeBlocks.end() || codeBlock->isEvalCode()) {
+            continue;
+        }
+        Function function;
+        function.m_sourceHash = sourceHash(codeBlock->src());
+        function.m_byteCodeSize = 0;
+        profile.m_functions[codeBlock->script()->src()->toNonGCUTF8StringData()].insert(std::make_pair(functionKey(codeBlock), function));
+    }
+
+    std::vector<char> payload;
+    auto put = [&payload](const void* data, size_t length) {
+        payload.insert(payload.end(), (const char*)data, (const char*)data + length);
+    };
+    auto putString = [&put](const std::string& str) {
+        uint64_t length = str.length();
+        put(&length, sizeof(length));
+        put(str.data(), str.length());
+    };
+
+    uint64_t scriptCount = profile.m_functions.size();
+    put(&scriptCount, sizeof(scriptCount));
+    for (auto& script : profile.m_functions) {
+        putString(script.first);
+        uint64_t functionCount = script.second.size();
+        put(&functionCount, sizeof(functionCount));
+        for (auto& function : script.second) {
+            put(&function.first, sizeof(function.first));
+            put(&function.second.m_sourceHash, sizeof(function.second.m_sourceHash));
+            put(&function.second.m_byteCodeSize, sizeof(function.second.m_byteCodeSize));
+            uint64_t siteCount = function.second.m_sites.size();
+            put(&siteCount, sizeof(siteCount));
+            for (size_t i = 0; i < siteCount; i++) {
+                const Site& site = function.second.m_sites[i];
+                put(&site.m_position, sizeof(site.m_position));
+                put(&site.m_kind, sizeof(site.m_kind));
+                put(&site.m_state, sizeof(site.m_state));
+                putString(site.m_propertyName);
+            }
+        }
+    }
+
+    CodeCacheFileHeader header;
+    header.m_magic = warmUpProfileMagic;
+    header.m_version = codeCacheVersion;
+    header.m_engineHash = engineHash();
+    header.m_sourceHash = 0;
+    header.m_sourceLength = 0;
+    header.m_payloadLength = payload.size();
+
+    return writeCacheFile(filePath, header, payload);
+}
+
+WarmUpProfile* WarmUpProfile::read(const char* filePath)
+{
+    std::vector<char> content;
+    if (!readCacheFile(filePath, content) || content.size() < sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    CodeCacheFileHeader header;
+    memcpy(&header, content.data(), sizeof(CodeCacheFileHeader));
+    if (header.m_magic != warmUpProfileMagic || header.m_version != codeCacheVersion || header.m_engineHash != engineHash()
+        || header.m_payloadLength != content.size() - sizeof(CodeCacheFileHeader)) {
+        return nullptr;
+    }
+
+    const char* cursor = content.data() + sizeof(CodeCacheFileHeader);
+    const char* end = content.data() + content.size();
+    bool hasError = false;
+    auto get = [&](void* data, size_t length) {
+        if (hasError || (size_t)(end - cursor) < length) {
+            hasError = true;
+            memset(data, 0, length);
+            return;
+        }
+        memcpy(data, cursor, length);
+        cursor += length;
+    };
+    auto getString = [&](std::string& str) {
+        uint64_t length;
+        get(&length, sizeof(length));
+        if (hasError || (uint64_t)(end - cursor) < length) {
+            hasError = true;
+            return;
+        }
+        str.assign(cursor, length);
+        cursor += length;
+    };
+
+    std::unique_ptr<WarmUpProfile> profile(new WarmUpProfile());
+    uint64_t scriptCount;
+    get(&scriptCount, sizeof(scriptCount));
+    for (uint64_t i = 0; i < scriptCount && !hasError; i++) {
+        std::string name;
+        getString(name);
+        auto& functions = profile->m_functions[name];
+        uint64_t functionCount;
+        get(&functionCount, sizeof(functionCount));
+        for (uint64_t j = 0; j < functionCount && !hasError; j++) {
+            uint64_t key;
+            Function function;
+            get(&key, sizeof(key));
+            get(&function.m_sourceHash, sizeof(function.m_sourceHash));
+            get(&function.m_byteCodeSize, sizeof(function.m_byteCodeSize));
+            uint64_t siteCount;
+            get(&siteCount, sizeof(siteCount));
+            for (uint64_t k = 0; k < siteCount && !hasError; k++) {
+                Site site;
+                get(&site.m_position, sizeof(site.m_position));
+                get(&site.m_kind, sizeof(site.m_kind));
+                get(&site.m_state, sizeof(site.m_state));
+                getString(site.m_propertyName);
+                hasError = hasError || site.m_kind > TypeFeedbackSite;
+                function.m_sites.push_back(site);
+            }
+            functions[key] = std::move(function);
+        }
+    }
+
+    if (hasError || cursor != end) {
+        return nullptr;
+    }
+    return profile.release();
+}
+
+void WarmUpProfile::compileProfiledFunctions(Context* context, Script* script)
+{
+    if (m_functions.find(script->src()->toNonGCUTF8StringData()) == m_functions.end()) {
+        return;
+    }
+
+    std::vector<InterpretedCodeBlock*> codeBlocks;
+    std::function<void(InterpretedCodeBlock*)> collect = [&](InterpretedCodeBlock* codeBlock) {
+        for (InterpretedCodeBlock* child = codeBlock->firstChild(); child; child = child->nextSibling()) {
+            if (!child->byteCodeBlock() && findFunction(child)) {
+                codeBlocks.push_back(child);
+            }
+            collect(child);
+        }
+    };
+    collect(script->topCodeBlock());
+
+    ExecutionState state(context);
+    auto& currentCodeSizeTotal = context->vmInstance()->compiledByteCodeSize();
+    for (size_t i = 0; i < codeBlocks.size(); i++) {
+        try {
+            context->scriptParser().generateFunctionByteCode(state, codeBlocks[i], STACK_LIMIT_FROM_BASE);
+            currentCodeSizeTotal += codeBlocks[i]->byteCodeBlock()->memoryAllocatedSize();
+        } catch (const Value&) {
+            // early error of function body is thrown again when the function is called
+        }
+    }
+}
+
+void WarmUpProfile::applyToByteCodeBlock(InterpretedCodeBlock* codeBlock)
+{
+    ByteCodeBlock* block = codeBlock->byteCodeBlock();
+    Function* function = findFunction(codeBlock);
+    // profiled bytecode positions are valid only for the same bytecode
+    if (!function || function->m_byteCodeSize != block->m_code.size()) {
+        return;
+    }
+
+    size_t siteIndex = 0;
+    auto& sites = function->m_sites;
+    iterateRelocatedByteCode(block, [&](size_t position, ByteCode* currentCode, Opcode opcode) {
+        while (siteIndex < sites.size() && sites[siteIndex].m_position < position) {
+            siteIndex++;
+        }
+        if (siteIndex == sites.size() || sites[siteIndex].m_position != position) {
+            return;
+        }
+
+        const Site& site = sites[siteIndex];
+        if (site.m_kind == GetObjectSite && (opcode == GetObjectPreComputedCaseOpcode || opcode == GetObjectPreComputedCaseAndCallOpcode)) {
+            GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
+            if (cd->m_inlineCache || cd->m_propertyName.plainString()->toNonGCUTF8StringData() != site.m_propertyName) {
+                return;
+            }
+            if (site.m_state == MegamorphicSite) {
+                cd->m_cacheMissCount = PROPERTY_INLINE_CACHE_MAX_MISS_COUNT + 1;
+            } else {
+                cd->m_cacheMissCount = PROPERTY_INLINE_CACHE_MIN_FILL_COUNT;
+                cd->m_inlineCache = new GetObjectInlineCache();
+                cd->m_inlineCache->m_cache.reserve(site.m_state);
+                block->m_inlineCacheDataSize += sizeof(GetObjectInlineCache);
+                block->m_literalData.push_back(cd->m_inlineCache);
+            }
+        } else if (site.m_kind == SetObjectSite && opcode == SetObjectPreComputedCaseOpcode) {
+            SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)currentCode;
+            if (cd->m_inlineCache || cd->m_propertyName.plainString()->toNonGCUTF8StringData() != site.m_propertyName) {
+                return;
+            }
+            if (site.m_state == MegamorphicSite) {
+                cd->m_missCount = PROPERTY_INLINE_CACHE_MAX_MISS_COUNT + 1;
+            } else {
+                cd->m_missCount = PROPERTY_INLINE_CACHE_MIN_FILL_COUNT;
+                cd->m_inlineCache = new SetObjectInlineCache();
+                cd->m_inlineCache->m_cache.reserve(site.m_state);
+                block->m_inlineCacheDataSize += sizeof(SetObjectInlineCache);
+                block->m_literalData.push_back(cd->m_inlineCache);
+            }
+        } else if (site.m_kind == TypeFeedbackSite) {
+            // same as quickening of interpreter, but with every type observed in profiled run
+            switch (opcode) {
+#define APPLY_TYPE_FEEDBACK(BaseCodeName)                                \
+    case BaseCodeName##Opcode: {                                         \
+        BaseCodeName* cd = (BaseCodeName*)currentCode;                   \
+        cd->m_typeFeedback = site.m_state;                               \
+        if (site.m_state == BinaryOperationTypeFeedbackInt32) {          \
+            cd->changeOpcode(BaseCodeName##Int32Opcode);                 \
+        } else if (!(site.m_state & BinaryOperationTypeFeedbackOther)) { \
+            cd->changeOpcode(BaseCodeName##DoubleOpcode);                \
+        }                                                                \
+        break;                                                           \
+    }
+                FOR_EACH_QUICKENED_BYTECODE(APPLY_TYPE_FEEDBACK)
+#undef APPLY_TYPE_FEEDBACK
+            default:
+                break;
+            }
+        }
+    });
+}
+}
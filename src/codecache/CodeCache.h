@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotCodeCache__
+#define __EscargotCodeCache__
+
+namespace Escargot {
+
+class Context;
+class Script;
+class String;
+class StringView;
+class VMInstance;
+class InterpretedCodeBlock;
+class ByteCodeBlock;
+
+// On-disk cache of parse results for top-level scripts.
+// A cache file holds the InterpretedCodeBlock tree and the ByteCodeBlock of global code.
+// Function bodies are still compiled lazily from the source when they are called first.
+// Files are named after the hash of source and engine build, and the header is checked again on load,
+// so a stale or foreign file is just ignored.
+class CodeCache {
+public:
+    // returns nullptr if there is no usable cache file for this source
+    static Script* load(Context* context, const char* directory, String* fileName, const StringView& source);
+    // script should be initialized just now (global ByteCodeBlock should not be executed yet)
+    static void store(Context* context, const char* directory, Script* script);
+
+    // Precompiled bundle holds bytecode of every function too, and no source.
+    // Loaded script never compiles again, and source positions and function sources are not available.
+    // returns nullptr if data is not a bundle of this engine build
+    static Script* loadBundle(Context* context, String* fileName, const char* data, size_t length);
+    // compiles every function of script and writes the bundle into filePath.
+    // script should be initialized just now. returns false on failure (e.g. script has something that cannot be written)
+    static bool storeBundle(Context* context, Script* script, const char* filePath);
+};
+
+// Runtime feedback of a VMInstance saved for the next start of the same application.
+// It records executed functions, state of property inline caches, operand types of quickened bytecodes and hot call targets.
+// When a script is loaded again, its profiled functions are compiled at once and their caches skip the warm-up misses.
+// Structures cannot be saved, so caches are seeded by property name and still fill on their first execution.
+// Functions are matched by script name, start position and hash of source, so feedback of modified functions is dropped.
+class WarmUpProfile {
+public:
+    static bool write(VMInstance* instance, const char* filePath);
+    // returns nullptr if the file is not a profile of this engine build
+    static WarmUpProfile* read(const char* filePath);
+
+    // script should be initialized just now
+    void compileProfiledFunctions(Context* context, Script* script);
+    // applies feedback to ByteCodeBlock of codeBlock generated just now
+    void applyToByteCodeBlock(InterpretedCodeBlock* codeBlock);
+
+private:
+    enum SiteKind : uint8_t {
+        GetObjectSite,
+        SetObjectSite,
+        TypeFeedbackSite,
+    };
+
+    struct Site {
+        uint64_t m_position;
+        SiteKind m_kind;
+        // number of cached structures (or MegamorphicSite) for property sites, observed operand types for TypeFeedbackSite
+        uint8_t m_state;
+        std::string m_propertyName;
+    };
+
+    struct Function {
+        uint64_t m_sourceHash;
+        // 0 if function was only seen as a call target
+        uint64_t m_byteCodeSize;
+        std::vector<Site> m_sites;
+    };
+
+    static const uint8_t MegamorphicSite = 0xff;
+
+    static uint64_t functionKey(InterpretedCodeBlock* codeBlock);
+    Function* findFunction(InterpretedCodeBlock* codeBlock);
+
+    // script name -> function key -> feedback
+    std::unordered_map<std::string, std::unordered_map<uint64_t, Function>> m_functions;
+};
+}
+
+#endif
@@ -133,7 +133,7 @@ GC_word* getNextValidInGetObjectInlineCacheDataVector(GC_word* ptr, GC_word** ne
 {
     GetObjectInlineCacheData* current = (GetObjectInlineCacheData*)ptr;
     *next_ptr = (GC_word*)((size_t)ptr + sizeof(GetObjectInlineCacheData));
-    GC_word* ret = (GC_word*)current->m_cachedhiddenClassChain;
+    GC_word* ret = (GC_word*)current->m_cachedhiddenClass;
     return ret;
 }
 
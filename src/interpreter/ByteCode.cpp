@@ -68,21 +68,113 @@ int ByteCode::dumpJumpPosition(size_t pos, const char* byteCodeStart)
 
 void GetGlobalVariable::dump(const char* byteCodeStart)
 {
-    printf("get global variable r%d <- global.%s", (int)m_registerIndex, m_slot->m_propertyName.string()->toUTF8StringData().data());
+    printf("get global variable r%d <- global slot %d", (int)m_registerIndex, (int)m_slotIndex);
 }
 
 void SetGlobalVariable::dump(const char* byteCodeStart)
 {
-    printf("set global variable global.%s <- r%d", m_slot->m_propertyName.string()->toUTF8StringData().data(), (int)m_registerIndex);
+    printf("set global variable global slot %d <- r%d", (int)m_slotIndex, (int)m_registerIndex);
 }
 #endif
 
+static size_t encodeLOCSourceIndex(size_t index)
+{
+    return index == SIZE_MAX ? 0 : index + 1;
+}
+
+static size_t decodeLOCSourceIndex(size_t index)
+{
+    return index == 0 ? SIZE_MAX : index - 1;
+}
+
+ByteCodeLOCTable::ByteCodeLOCTable(ByteCodeLOCData& data)
+    : m_size(0)
+{
+    // code can be rewound while generating, so the first entry of each position is the valid one
+    std::stable_sort(data.begin(), data.end(), [](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) -> bool {
+        return a.first < b.first;
+    });
+
+    size_t lastPosition = 0;
+    size_t lastSourceIndex = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        if (m_size && data[i].first == lastPosition) {
+            continue;
+        }
+
+        size_t sourceIndex = encodeLOCSourceIndex(data[i].second);
+        intptr_t sourceDelta = (intptr_t)(sourceIndex - lastSourceIndex);
+        writeVarInt(m_data, data[i].first - lastPosition);
+        // zigzag encoding keeps small negative deltas small
+        writeVarInt(m_data, ((size_t)sourceDelta << 1) ^ (size_t)(sourceDelta >> (sizeof(intptr_t) * 8 - 1)));
+
+        lastPosition = data[i].first;
+        lastSourceIndex = sourceIndex;
+        if (m_size % CheckpointInterval == 0) {
+            m_checkpoints.push_back({ lastPosition, lastSourceIndex, m_data.size() });
+        }
+        m_size++;
+    }
+
+    m_data.shrink_to_fit();
+    m_checkpoints.shrink_to_fit();
+}
+
+void ByteCodeLOCTable::writeVarInt(std::vector<uint8_t>& out, size_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+size_t ByteCodeLOCTable::readVarInt(const uint8_t*& data)
+{
+    size_t value = 0;
+    size_t shift = 0;
+    while (*data & 0x80) {
+        value |= (size_t)(*data++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= (size_t)(*data++) << shift;
+    return value;
+}
+
+bool ByteCodeLOCTable::find(size_t codePosition, size_t& sourceIndex) const
+{
+    auto iter = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), codePosition, [](size_t position, const Checkpoint& checkpoint) -> bool {
+        return position < checkpoint.m_codePosition;
+    });
+    if (iter == m_checkpoints.begin()) {
+        return false;
+    }
+    iter--;
+
+    size_t position = iter->m_codePosition;
+    size_t encodedSourceIndex = iter->m_sourceIndex;
+    const uint8_t* data = m_data.data() + iter->m_dataOffset;
+    size_t remain = std::min(CheckpointInterval - 1, m_size - (iter - m_checkpoints.begin()) * CheckpointInterval - 1);
+    while (position < codePosition && remain--) {
+        position += readVarInt(data);
+        size_t zigzag = readVarInt(data);
+        encodedSourceIndex += (size_t)((intptr_t)(zigzag >> 1) ^ -(intptr_t)(zigzag & 1));
+    }
+
+    if (position != codePosition) {
+        return false;
+    }
+    sourceIndex = decodeLOCSourceIndex(encodedSourceIndex);
+    return true;
+}
+
 ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     : m_isEvalMode(false)
     , m_isOnGlobal(false)
     , m_shouldClearStack(false)
     , m_isOwnerMayFreed(false)
     , m_requiredRegisterFileSizeInValueSize(2)
+    , m_age(0)
     , m_inlineCacheDataSize(0)
     , m_locData(nullptr)
     , m_codeBlock(codeBlock)
@@ -140,8 +232,7 @@ void ByteCodeBlock::fillLocDataIfNeeded(Context* c)
     }
     m_locData = block->m_locData;
     block->m_locData = nullptr;
-    // prevent infinate fillLocDataIfNeeded if m_locData.size() == 0 in here
-    m_locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
+    ASSERT(m_locData);
 
     // reset ASTAllocator
     c->astAllocator().reset();
@@ -155,16 +246,14 @@ ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t cod
     }
 
     fillLocDataIfNeeded(c);
+    // script loaded from bundle has no source to compute LOC data
+    if (!m_locData) {
+        return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
+    }
 
     size_t index = 0;
-    for (size_t i = 0; i < m_locData->size(); i++) {
-        if ((*m_locData)[i].first == codePosition) {
-            index = (*m_locData)[i].second;
-            if (index == SIZE_MAX) {
-                return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
-            }
-            break;
-        }
+    if (m_locData->find(codePosition, index) && index == SIZE_MAX) {
+        return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
     }
 
     size_t indexRelatedWithScript = index;
@@ -304,8 +393,7 @@ void* SetObjectInlineCache::operator new(size_t size)
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetObjectInlineCache)] = { 0 };
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cachedHiddenClassChainData));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_hiddenClassWillBe));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cache));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetObjectInlineCache));
         typeInited = true;
     }
@@ -30,6 +30,9 @@
 
 namespace Escargot {
 class ObjectStructure;
+class ObjectAllocationSite;
+class PrototypeValidityCell;
+class ScriptFunctionObject;
 class Node;
 struct GlobalVariableAccessCacheItem;
 
@@ -67,6 +70,8 @@ struct GlobalVariableAccessCacheItem;
     F(BinaryInOperation, 1, 2)                              \
     F(BinaryInstanceOfOperation, 1, 2)                      \
     F(CreateObject, 1, 0)                                   \
+    F(CreateObjectWithStructure, 1, 0)                      \
+    F(InitializeObjectLiteralProperty, 0, 0)                \
     F(CreateArray, 1, 0)                                    \
     F(CreateSpreadArrayObject, 1, 0)                        \
     F(CreateFunction, 1, 0)                                 \
@@ -132,6 +137,40 @@ struct GlobalVariableAccessCacheItem;
     F(EnsureArgumentsObject, 0, 0)                          \
     F(ResolveNameAddress, 1, 0)                             \
     F(StoreByNameWithAddress, 0, 1)                         \
+    F(GetObjectPreComputedCaseAndCall, 1, 1)                \
+    F(LoadLiteralAndBinaryPlus, 1, 0)                       \
+    F(BinaryEqualAndJumpIfFalse, 1, 2)                      \
+    F(BinaryNotEqualAndJumpIfFalse, 1, 2)                   \
+    F(BinaryStrictEqualAndJumpIfFalse, 1, 2)                \
+    F(BinaryNotStrictEqualAndJumpIfFalse, 1, 2)             \
+    F(BinaryLessThanAndJumpIfFalse, 1, 2)                   \
+    F(BinaryLessThanOrEqualAndJumpIfFalse, 1, 2)            \
+    F(BinaryGreaterThanAndJumpIfFalse, 1, 2)                \
+    F(BinaryGreaterThanOrEqualAndJumpIfFalse, 1, 2)         \
+    F(IncrementAndJumpToRelation, 1, 1)                     \
+    F(DecrementAndJumpToRelation, 1, 1)                     \
+    F(BinaryPlusInt32, 1, 2)                                \
+    F(BinaryPlusDouble, 1, 2)                               \
+    F(BinaryMinusInt32, 1, 2)                               \
+    F(BinaryMinusDouble, 1, 2)                              \
+    F(BinaryMultiplyInt32, 1, 2)                            \
+    F(BinaryMultiplyDouble, 1, 2)                           \
+    F(BinaryLessThanInt32, 1, 2)                            \
+    F(BinaryLessThanDouble, 1, 2)                           \
+    F(BinaryLessThanOrEqualInt32, 1, 2)                     \
+    F(BinaryLessThanOrEqualDouble, 1, 2)                    \
+    F(BinaryGreaterThanInt32, 1, 2)                         \
+    F(BinaryGreaterThanDouble, 1, 2)                        \
+    F(BinaryGreaterThanOrEqualInt32, 1, 2)                  \
+    F(BinaryGreaterThanOrEqualDouble, 1, 2)                 \
+    F(BinaryLessThanAndJumpIfFalseInt32, 1, 2)              \
+    F(BinaryLessThanAndJumpIfFalseDouble, 1, 2)             \
+    F(BinaryLessThanOrEqualAndJumpIfFalseInt32, 1, 2)       \
+    F(BinaryLessThanOrEqualAndJumpIfFalseDouble, 1, 2)      \
+    F(BinaryGreaterThanAndJumpIfFalseInt32, 1, 2)           \
+    F(BinaryGreaterThanAndJumpIfFalseDouble, 1, 2)          \
+    F(BinaryGreaterThanOrEqualAndJumpIfFalseInt32, 1, 2)    \
+    F(BinaryGreaterThanOrEqualAndJumpIfFalseDouble, 1, 2)   \
     F(End, 0, 0)
 
 
@@ -173,17 +212,31 @@ struct ByteCodeLOC {
     }
 };
 
-#if defined(NDEBUG) && defined(ESCARGOT_32)
+#if defined(NDEBUG) && defined(ESCARGOT_32) && !defined(ENABLE_COMPACT_BYTECODE)
 #define BYTECODE_SIZE_CHECK_IN_32BIT(codeName, size) COMPILE_ASSERT(sizeof(codeName) == size, "");
 #else
 #define BYTECODE_SIZE_CHECK_IN_32BIT(CodeName, Size)
 #endif
 
+// By default, with computed goto, every bytecode starts with the address of its handler (threaded code).
+// ENABLE_COMPACT_BYTECODE stores a 16-bit opcode instead and aligns ByteCode to a word,
+// so operands of each bytecode are packed into the tail padding right after the opcode
+// (e.g. Move shrinks from 16 to 8 bytes on 64-bit). Dispatch loads the handler from g_opcodeTable then.
+#if (defined(COMPILER_GCC) || defined(COMPILER_CLANG)) && !defined(ENABLE_COMPACT_BYTECODE)
+#define BYTECODE_OPCODE_IN_ADDRESS
+#endif
+
+#if defined(ENABLE_COMPACT_BYTECODE)
+#define BYTECODE_ALIGNAS alignas(sizeof(size_t))
+#else
+#define BYTECODE_ALIGNAS
+#endif
+
 /* Byte code is never instantiated on the heap, it is part of the byte code stream. */
-class ByteCode {
+class BYTECODE_ALIGNAS ByteCode {
 public:
     ByteCode(Opcode code, const ByteCodeLOC& loc)
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
         : m_opcodeInAddress((void*)code)
 #else
         : m_opcode(code)
@@ -195,22 +248,37 @@ public:
     {
     }
 
+    // rewrite opcode of relocated bytecode in place (type feedback quickening)
+    void changeOpcode(Opcode code)
+    {
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+        m_opcodeInAddress = g_opcodeTable.m_table[code];
+#else
+        m_opcode = code;
+#endif
+#ifndef NDEBUG
+        m_orgOpcode = code;
+#endif
+    }
+
     void assignOpcodeInAddress()
     {
 #ifndef NDEBUG
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
         m_orgOpcode = (Opcode)(size_t)m_opcodeInAddress;
 #else
         m_orgOpcode = m_opcode;
 #endif
 #endif
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
         m_opcodeInAddress = g_opcodeTable.m_table[(Opcode)(size_t)m_opcodeInAddress];
 #endif
     }
 
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
     void* m_opcodeInAddress;
+#elif defined(ENABLE_COMPACT_BYTECODE)
+    Opcode m_opcode : 16;
 #else
     Opcode m_opcode;
 #endif
@@ -291,16 +359,57 @@ public:
 #endif
 };
 
+// guard for one EnvironmentRecord on the path from the current scope to the cached binding
+struct ByNameInlineCacheItem {
+    enum Kind : size_t {
+        DeclarativeIndexed, // m_key is BlockInfo of the record
+        Function, // m_key is CodeBlock of the function
+        NotIndexed, // bindings can be added by eval so the name is checked on every access
+        Object, // m_key is structure chain of the binding object (m_keyLength items)
+        GlobalDeclarative, // m_key is GlobalObject
+        GlobalObject, // m_key is GlobalObject, m_extraKey is its structure and m_keyLength is size of global declarative record
+    };
+
+    size_t m_recordTag;
+    Kind m_kind;
+    void* m_key;
+    void* m_extraKey;
+    size_t m_keyLength;
+};
+
+struct ByNameInlineCache : public gc {
+    ByNameInlineCache()
+        : m_items(nullptr)
+        , m_itemCount(0)
+        , m_index(SIZE_MAX)
+        , m_holderDepth(0)
+        , m_isLexicallyDeclared(false)
+        , m_missCount(0)
+    {
+    }
+
+    ByNameInlineCacheItem* m_items;
+    size_t m_itemCount;
+    // binding slot on the last record
+    // for Object records, index in structure of the holder which is m_holderDepth-th prototype of binding object
+    size_t m_index;
+    size_t m_holderDepth;
+    bool m_isLexicallyDeclared;
+    size_t m_missCount;
+};
+
 class LoadByName : public ByteCode {
 public:
     LoadByName(const ByteCodeLOC& loc, const size_t registerIndex, const AtomicString& name)
         : ByteCode(Opcode::LoadByNameOpcode, loc)
         , m_registerIndex(registerIndex)
         , m_name(name)
+        , m_inlineCache(nullptr)
     {
     }
     ByteCodeRegisterIndex m_registerIndex;
     AtomicString m_name;
+    ByNameInlineCache* m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -316,10 +425,12 @@ public:
         : ByteCode(Opcode::StoreByNameOpcode, loc)
         , m_registerIndex(registerIndex)
         , m_name(name)
+        , m_inlineCache(nullptr)
     {
     }
     ByteCodeRegisterIndex m_registerIndex;
     AtomicString m_name;
+    ByNameInlineCache* m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -580,6 +691,15 @@ public:
     }
 #endif
 
+// operand types observed by arithmetic and relational operations
+enum BinaryOperationTypeFeedback {
+    BinaryOperationTypeFeedbackNone = 0,
+    BinaryOperationTypeFeedbackInt32 = 1,
+    BinaryOperationTypeFeedbackNumber = 1 << 1,
+    BinaryOperationTypeFeedbackOther = 1 << 2,
+};
+
+// m_isResultUnused is set by ByteCodeGenerator when fused JumpIfFalse is the only reader of m_dstIndex
 #define DEFINE_BINARY_OPERATION(CodeName, HumanName)                                                                                      \
     class Binary##CodeName : public ByteCode {                                                                                            \
     public:                                                                                                                               \
@@ -588,11 +708,15 @@ public:
             , m_srcIndex0(registerIndex0)                                                                                                 \
             , m_srcIndex1(registerIndex1)                                                                                                 \
             , m_dstIndex(dstRegisterIndex)                                                                                                \
+            , m_typeFeedback(BinaryOperationTypeFeedbackNone)                                                                             \
+            , m_isResultUnused(false)                                                                                                     \
         {                                                                                                                                 \
         }                                                                                                                                 \
         ByteCodeRegisterIndex m_srcIndex0;                                                                                                \
         ByteCodeRegisterIndex m_srcIndex1;                                                                                                \
         ByteCodeRegisterIndex m_dstIndex;                                                                                                 \
+        uint8_t m_typeFeedback;                                                                                                           \
+        bool m_isResultUnused;                                                                                                            \
         DEFINE_BINARY_OPERATION_DUMP(HumanName)                                                                                           \
     };
 
@@ -604,8 +728,6 @@ DEFINE_BINARY_OPERATION(Equal, "equal");
 DEFINE_BINARY_OPERATION(Exponentiation, "exponentiation operation");
 DEFINE_BINARY_OPERATION(GreaterThan, "greaterthan");
 DEFINE_BINARY_OPERATION(GreaterThanOrEqual, "greaterthan or equal");
-DEFINE_BINARY_OPERATION(InOperation, "in operation");
-DEFINE_BINARY_OPERATION(InstanceOfOperation, "instance of");
 DEFINE_BINARY_OPERATION(LeftShift, "left shift");
 DEFINE_BINARY_OPERATION(LessThan, "lessthan");
 DEFINE_BINARY_OPERATION(LessThanOrEqual, "lessthan or equal");
@@ -619,16 +741,87 @@ DEFINE_BINARY_OPERATION(SignedRightShift, "signed right shift");
 DEFINE_BINARY_OPERATION(StrictEqual, "strict equal");
 DEFINE_BINARY_OPERATION(UnsignedRightShift, "unsigned right shift");
 
+// caches `key in object` for a constant key as (structure chain of object) -> result
+struct BinaryInOperationInlineCache : public gc {
+    BinaryInOperationInlineCache()
+        : m_cachedKey(nullptr)
+        , m_cachedHiddenClassChain(nullptr)
+        , m_cachedHiddenClassChainLength(0)
+        , m_cachedResult(false)
+        , m_missCount(0)
+    {
+    }
+
+    PointerValue* m_cachedKey;
+    ObjectStructure** m_cachedHiddenClassChain;
+    size_t m_cachedHiddenClassChainLength;
+    bool m_cachedResult;
+    size_t m_missCount;
+};
+
+class BinaryInOperation : public ByteCode {
+public:
+    BinaryInOperation(const ByteCodeLOC& loc, const size_t registerIndex0, const size_t registerIndex1, const size_t dstRegisterIndex)
+        : ByteCode(Opcode::BinaryInOperationOpcode, loc)
+        , m_srcIndex0(registerIndex0)
+        , m_srcIndex1(registerIndex1)
+        , m_dstIndex(dstRegisterIndex)
+        , m_inlineCache(nullptr)
+    {
+    }
+    ByteCodeRegisterIndex m_srcIndex0;
+    ByteCodeRegisterIndex m_srcIndex1;
+    ByteCodeRegisterIndex m_dstIndex;
+    BinaryInOperationInlineCache* m_inlineCache;
+    DEFINE_BINARY_OPERATION_DUMP("in operation")
+};
+
+// caches a constructor whose @@hasInstance resolves to Function.prototype[@@hasInstance]
+// so `x instanceof C` only needs to read C.prototype and walk the prototype chain of x
+struct BinaryInstanceOfOperationInlineCache : public gc {
+    BinaryInstanceOfOperationInlineCache()
+        : m_cachedConstructorStructure(nullptr)
+        , m_cachedFunctionPrototype(nullptr)
+        , m_cachedPrototypeIndex(SIZE_MAX)
+        , m_missCount(0)
+    {
+    }
+
+    ObjectStructure* m_cachedConstructorStructure;
+    Object* m_cachedFunctionPrototype;
+    size_t m_cachedPrototypeIndex;
+    size_t m_missCount;
+};
+
+class BinaryInstanceOfOperation : public ByteCode {
+public:
+    BinaryInstanceOfOperation(const ByteCodeLOC& loc, const size_t registerIndex0, const size_t registerIndex1, const size_t dstRegisterIndex)
+        : ByteCode(Opcode::BinaryInstanceOfOperationOpcode, loc)
+        , m_srcIndex0(registerIndex0)
+        , m_srcIndex1(registerIndex1)
+        , m_dstIndex(dstRegisterIndex)
+        , m_inlineCache(nullptr)
+    {
+    }
+    ByteCodeRegisterIndex m_srcIndex0;
+    ByteCodeRegisterIndex m_srcIndex1;
+    ByteCodeRegisterIndex m_dstIndex;
+    BinaryInstanceOfOperationInlineCache* m_inlineCache;
+    DEFINE_BINARY_OPERATION_DUMP("instance of")
+};
+
 
 class CreateObject : public ByteCode {
 public:
     CreateObject(const ByteCodeLOC& loc, const size_t registerIndex)
         : ByteCode(Opcode::CreateObjectOpcode, loc)
         , m_registerIndex(registerIndex)
+        , m_allocationSite(nullptr)
     {
     }
 
     ByteCodeRegisterIndex m_registerIndex;
+    ObjectAllocationSite* m_allocationSite;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -638,6 +831,62 @@ public:
 #endif
 };
 
+// creates object of literal whose properties are all `name: value` with distinct names
+// the structure made by the first execution is used for later executions, and
+// InitializeObjectLiteralProperty stores values into slots without structure transition
+class CreateObjectWithStructure : public ByteCode {
+public:
+    CreateObjectWithStructure(const ByteCodeLOC& loc, const size_t registerIndex, const size_t propertyCount)
+        : ByteCode(Opcode::CreateObjectWithStructureOpcode, loc)
+        , m_registerIndex(registerIndex)
+        , m_structureUpdateCount(0)
+        , m_propertyCount(propertyCount)
+        , m_structure(nullptr)
+    {
+    }
+
+    static const size_t maxStructureUpdateCount = 8;
+
+    ByteCodeRegisterIndex m_registerIndex;
+    uint16_t m_structureUpdateCount;
+    uint32_t m_propertyCount;
+    ObjectStructure* m_structure;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("createobject with structure(%d properties) -> r%d", (int)m_propertyCount, (int)m_registerIndex);
+    }
+#endif
+};
+
+class InitializeObjectLiteralProperty : public ByteCode {
+public:
+    InitializeObjectLiteralProperty(const ByteCodeLOC& loc, const size_t objectRegisterIndex, AtomicString propertyName, const size_t loadRegisterIndex, const size_t slotIndex)
+        : ByteCode(Opcode::InitializeObjectLiteralPropertyOpcode, loc)
+        , m_objectRegisterIndex(objectRegisterIndex)
+        , m_loadRegisterIndex(loadRegisterIndex)
+        , m_slotIndex(slotIndex)
+        , m_propertyName(propertyName)
+        , m_createObjectCodePosition(SIZE_MAX)
+    {
+    }
+
+    ByteCodeRegisterIndex m_objectRegisterIndex;
+    ByteCodeRegisterIndex m_loadRegisterIndex;
+    uint32_t m_slotIndex;
+    AtomicString m_propertyName;
+    // position of CreateObjectWithStructure for the last property of literal, SIZE_MAX otherwise
+    size_t m_createObjectCodePosition;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("initialize object literal property r%d.%s(slot %d) <- r%d", (int)m_objectRegisterIndex, m_propertyName.string()->toUTF8StringData().data(), (int)m_slotIndex, (int)m_loadRegisterIndex);
+    }
+#endif
+};
+
 class CreateArray : public ByteCode {
 public:
     CreateArray(const ByteCodeLOC& loc, const size_t registerIndex)
@@ -678,6 +927,20 @@ public:
 #endif
 };
 
+// element inline cache of GetObject and SetObjectOperation for typed arrays
+// it is allocated only when a typed array is met at the site
+// remembers tag and TypedArrayType of the typed array seen last
+struct ElementInlineCache : public gc {
+    ElementInlineCache()
+        : m_cachedTag(0)
+        , m_typedArrayType(0)
+    {
+    }
+
+    size_t m_cachedTag;
+    uint8_t m_typedArrayType;
+};
+
 class GetObject : public ByteCode {
 public:
     GetObject(const ByteCodeLOC& loc, const size_t objectRegisterIndex, const size_t propertyRegisterIndex, const size_t storeRegisterIndex)
@@ -685,12 +948,14 @@ public:
         , m_objectRegisterIndex(objectRegisterIndex)
         , m_propertyRegisterIndex(propertyRegisterIndex)
         , m_storeRegisterIndex(storeRegisterIndex)
+        , m_elementInlineCache(nullptr)
     {
     }
 
     ByteCodeRegisterIndex m_objectRegisterIndex;
     ByteCodeRegisterIndex m_propertyRegisterIndex;
     ByteCodeRegisterIndex m_storeRegisterIndex;
+    ElementInlineCache* m_elementInlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -707,12 +972,14 @@ public:
         , m_objectRegisterIndex(objectRegisterIndex)
         , m_propertyRegisterIndex(propertyRegisterIndex)
         , m_loadRegisterIndex(loadRegisterIndex)
+        , m_elementInlineCache(nullptr)
     {
     }
 
     ByteCodeRegisterIndex m_objectRegisterIndex;
     ByteCodeRegisterIndex m_propertyRegisterIndex;
     ByteCodeRegisterIndex m_loadRegisterIndex;
+    ElementInlineCache* m_elementInlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -861,19 +1128,29 @@ public:
     }
 };
 
+// cached lookup which goes through prototype chain of receiver
+// objects after m_prototype are checked by its validity cell instead of comparing their structures
+struct GetObjectInlineCachePrototypeData : public gc {
+    ObjectStructure* m_receiverStructure;
+    Object* m_prototype;
+    PrototypeValidityCell* m_validityCell;
+    // object which has the property. nullptr if property does not exist on the chain
+    Object* m_holder;
+};
+
 struct GetObjectInlineCacheData {
     GetObjectInlineCacheData()
     {
-        m_cachedhiddenClassChain = nullptr;
-        m_cachedhiddenClassChainLength = 0;
+        m_cachedhiddenClass = nullptr;
+        m_isPrototypeCase = false;
         m_cachedIndex = 0;
     }
 
     union {
-        ObjectStructure** m_cachedhiddenClassChain;
         ObjectStructure* m_cachedhiddenClass;
+        GetObjectInlineCachePrototypeData* m_prototypeData;
     };
-    size_t m_cachedhiddenClassChainLength;
+    bool m_isPrototypeCase;
     size_t m_cachedIndex;
 };
 
@@ -919,31 +1196,45 @@ public:
 #endif
 };
 
-struct SetObjectInlineCache {
+struct SetObjectInlineCacheData {
+    SetObjectInlineCacheData()
+    {
+        m_cachedHiddenClassChainData = nullptr;
+        m_cachedhiddenClassChainLength = 0;
+        m_cachedIndex = 0;
+        m_hiddenClassWillBe = nullptr;
+        m_isDoubleSlot = false;
+    }
+
+    // m_hiddenClassWillBe is nullptr when the data caches a store into an existing own property
+    // otherwise it caches a property addition through the whole prototype chain
     union {
         ObjectStructure** m_cachedHiddenClassChainData;
         ObjectStructure* m_cachedHiddenClass;
     };
     size_t m_cachedhiddenClassChainLength;
-    union {
-        size_t m_cachedIndex;
-        ObjectStructure* m_hiddenClassWillBe;
-    };
+    size_t m_cachedIndex;
+    ObjectStructure* m_hiddenClassWillBe;
+    // the slot written (or added) has double representation, so only numbers are stored on cache hit
+    bool m_isDoubleSlot;
+};
 
+typedef Vector<SetObjectInlineCacheData, GCUtil::gc_malloc_allocator<SetObjectInlineCacheData>> SetObjectInlineCacheDataVector;
+
+struct SetObjectInlineCache {
     SetObjectInlineCache()
     {
-        m_cachedHiddenClass = m_hiddenClassWillBe = nullptr;
-        m_cachedhiddenClassChainLength = 0;
     }
 
     void invalidateCache()
     {
-        m_cachedHiddenClass = m_hiddenClassWillBe = nullptr;
-        m_cachedhiddenClassChainLength = 0;
+        m_cache.clear();
     }
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
+
+    SetObjectInlineCacheDataVector m_cache;
 };
 
 class SetObjectPreComputedCase : public ByteCode {
@@ -975,15 +1266,16 @@ public:
 
 class GetGlobalVariable : public ByteCode {
 public:
-    GetGlobalVariable(const ByteCodeLOC& loc, const size_t registerIndex, GlobalVariableAccessCacheItem* slot)
+    GetGlobalVariable(const ByteCodeLOC& loc, const size_t registerIndex, size_t slotIndex)
         : ByteCode(Opcode::GetGlobalVariableOpcode, loc)
         , m_registerIndex(registerIndex)
-        , m_slot(slot)
+        , m_slotIndex(slotIndex)
     {
     }
 
     ByteCodeRegisterIndex m_registerIndex;
-    GlobalVariableAccessCacheItem* m_slot;
+    // index of VMInstance::globalVariableAccessCacheSlotIndex. cache item is in side table of running Context
+    size_t m_slotIndex;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart);
@@ -992,15 +1284,16 @@ public:
 
 class SetGlobalVariable : public ByteCode {
 public:
-    SetGlobalVariable(const ByteCodeLOC& loc, const size_t registerIndex, GlobalVariableAccessCacheItem* slot)
+    SetGlobalVariable(const ByteCodeLOC& loc, const size_t registerIndex, size_t slotIndex)
         : ByteCode(Opcode::SetGlobalVariableOpcode, loc)
         , m_registerIndex(registerIndex)
-        , m_slot(slot)
+        , m_slotIndex(slotIndex)
     {
     }
 
     ByteCodeRegisterIndex m_registerIndex;
-    GlobalVariableAccessCacheItem* m_slot;
+    // index of VMInstance::globalVariableAccessCacheSlotIndex. cache item is in side table of running Context
+    size_t m_slotIndex;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart);
@@ -1526,6 +1819,22 @@ public:
 #endif
 };
 
+// call target cache of CallFunction and CallFunctionWithReceiver
+// only plain ScriptFunctionObject whose environment can be allocated on stack is cached,
+// so a hit enters the frame setup specialized for it.
+// cache is keyed by code block of callee instead of callee itself,
+// so it does not keep closures (and their environments) alive and every closure of the same function hits
+struct CallFunctionInlineCache : public gc {
+    CallFunctionInlineCache()
+        : m_cachedCodeBlock(nullptr)
+        , m_missCount(0)
+    {
+    }
+
+    InterpretedCodeBlock* m_cachedCodeBlock;
+    size_t m_missCount;
+};
+
 class CallFunction : public ByteCode {
 public:
     CallFunction(const ByteCodeLOC& loc, const size_t calleeIndex, const size_t argumentsStartIndex, const size_t resultIndex, const size_t argumentCount)
@@ -1534,12 +1843,14 @@ public:
         , m_argumentsStartIndex(argumentsStartIndex)
         , m_resultIndex(resultIndex)
         , m_argumentCount(argumentCount)
+        , m_inlineCache(nullptr)
     {
     }
     ByteCodeRegisterIndex m_calleeIndex;
     ByteCodeRegisterIndex m_argumentsStartIndex;
     ByteCodeRegisterIndex m_resultIndex;
     uint16_t m_argumentCount;
+    CallFunctionInlineCache* m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -1558,6 +1869,7 @@ public:
         , m_argumentsStartIndex(argumentsStartIndex)
         , m_resultIndex(resultIndex)
         , m_argumentCount(argumentCount)
+        , m_inlineCache(nullptr)
     {
     }
 
@@ -1566,6 +1878,7 @@ public:
     ByteCodeRegisterIndex m_argumentsStartIndex;
     ByteCodeRegisterIndex m_resultIndex;
     uint16_t m_argumentCount;
+    CallFunctionInlineCache* m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -2349,6 +2662,90 @@ public:
 #endif
 };
 
+// Fused super instructions.
+// A fused bytecode reuses the operand layout of the first bytecode of a pair
+// and the second bytecode stays untouched right after it in the stream.
+// so jump targets and LOC data need no fixup, and jumping directly into the second bytecode still works.
+// These are never pushed by node generators. ByteCodeGenerator rewrites opcode of the first bytecode after generation.
+#ifdef NDEBUG
+#define DEFINE_FUSED_BYTECODE_DUMP(BaseCodeName)
+#else
+#define DEFINE_FUSED_BYTECODE_DUMP(BaseCodeName) \
+    void dump(const char* byteCodeStart)         \
+    {                                            \
+        printf("(fused) ");                      \
+        BaseCodeName::dump(byteCodeStart);       \
+    }
+#endif
+
+#define DEFINE_FUSED_BYTECODE(CodeName, BaseCodeName) \
+    class CodeName : public BaseCodeName {            \
+    public:                                           \
+        DEFINE_FUSED_BYTECODE_DUMP(BaseCodeName)      \
+    };                                                \
+    COMPILE_ASSERT(sizeof(CodeName) == sizeof(BaseCodeName), "")
+
+// get object r1 <- r0.name + call r1 with receiver r0
+DEFINE_FUSED_BYTECODE(GetObjectPreComputedCaseAndCall, GetObjectPreComputedCase);
+// load r0 <- literal + plus r2 <- r1, r0
+DEFINE_FUSED_BYTECODE(LoadLiteralAndBinaryPlus, LoadLiteral);
+// compare r2 <- r0, r1 + jump if false r2
+DEFINE_FUSED_BYTECODE(BinaryEqualAndJumpIfFalse, BinaryEqual);
+DEFINE_FUSED_BYTECODE(BinaryNotEqualAndJumpIfFalse, BinaryNotEqual);
+DEFINE_FUSED_BYTECODE(BinaryStrictEqualAndJumpIfFalse, BinaryStrictEqual);
+DEFINE_FUSED_BYTECODE(BinaryNotStrictEqualAndJumpIfFalse, BinaryNotStrictEqual);
+DEFINE_FUSED_BYTECODE(BinaryLessThanAndJumpIfFalse, BinaryLessThan);
+DEFINE_FUSED_BYTECODE(BinaryLessThanOrEqualAndJumpIfFalse, BinaryLessThanOrEqual);
+DEFINE_FUSED_BYTECODE(BinaryGreaterThanAndJumpIfFalse, BinaryGreaterThan);
+DEFINE_FUSED_BYTECODE(BinaryGreaterThanOrEqualAndJumpIfFalse, BinaryGreaterThanOrEqual);
+// loop back-edge: increment r0 + jump to the loop test (JumpIfRelation)
+DEFINE_FUSED_BYTECODE(IncrementAndJumpToRelation, Increment);
+DEFINE_FUSED_BYTECODE(DecrementAndJumpToRelation, Decrement);
+
+// Quickened bytecodes.
+// A generic arithmetic or relational bytecode records operand types in m_typeFeedback
+// and rewrites its opcode into a specialized variant while the feedback stays monomorphic.
+// A specialized variant guards operand types once and rewrites itself back into the generic one on mismatch.
+#ifdef NDEBUG
+#define DEFINE_QUICKENED_BYTECODE_DUMP(BaseCodeName, TypeName)
+#else
+#define DEFINE_QUICKENED_BYTECODE_DUMP(BaseCodeName, TypeName) \
+    void dump(const char* byteCodeStart)                       \
+    {                                                          \
+        printf("(" TypeName ") ");                             \
+        BaseCodeName::dump(byteCodeStart);                     \
+    }
+#endif
+
+#define DEFINE_QUICKENED_BYTECODE(BaseCodeName)                              \
+    class BaseCodeName##Int32 : public BaseCodeName {                        \
+    public:                                                                  \
+        DEFINE_QUICKENED_BYTECODE_DUMP(BaseCodeName, "int32")                \
+    };                                                                       \
+    class BaseCodeName##Double : public BaseCodeName {                       \
+    public:                                                                  \
+        DEFINE_QUICKENED_BYTECODE_DUMP(BaseCodeName, "double")               \
+    };                                                                       \
+    COMPILE_ASSERT(sizeof(BaseCodeName##Int32) == sizeof(BaseCodeName), ""); \
+    COMPILE_ASSERT(sizeof(BaseCodeName##Double) == sizeof(BaseCodeName), "")
+
+#define FOR_EACH_QUICKENED_BYTECODE(F)            \
+    F(BinaryPlus)                                 \
+    F(BinaryMinus)                                \
+    F(BinaryMultiply)                             \
+    F(BinaryLessThan)                             \
+    F(BinaryLessThanOrEqual)                      \
+    F(BinaryGreaterThan)                          \
+    F(BinaryGreaterThanOrEqual)                   \
+    F(BinaryLessThanAndJumpIfFalse)               \
+    F(BinaryLessThanOrEqualAndJumpIfFalse)        \
+    F(BinaryGreaterThanAndJumpIfFalse)            \
+    F(BinaryGreaterThanOrEqualAndJumpIfFalse)
+
+#define DECLARE_QUICKENED_BYTECODE(BaseCodeName) DEFINE_QUICKENED_BYTECODE(BaseCodeName);
+FOR_EACH_QUICKENED_BYTECODE(DECLARE_QUICKENED_BYTECODE)
+#undef DECLARE_QUICKENED_BYTECODE
+
 class End : public ByteCode {
 public:
     explicit End(const ByteCodeLOC& loc, const size_t registerIndex)
@@ -2368,10 +2765,43 @@ public:
 
 
 typedef Vector<char, std::allocator<char>, ComputeReservedCapacityFunctionWithLog2<200>> ByteCodeBlockData;
-typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
 typedef Vector<void*, GCUtil::gc_malloc_allocator<void*>> ByteCodeLiteralData;
 typedef Vector<Value, std::allocator<Value>> ByteCodeNumeralLiteralData;
 
+// Compact form of ByteCodeLOCData kept by ByteCodeBlock.
+// Entries are sorted by bytecode position and stored as varint deltas of (bytecode position, source index).
+// Every CheckpointInterval-th entry also has an absolute checkpoint, so lookup is a binary search
+// over checkpoints followed by decoding at most CheckpointInterval entries.
+class ByteCodeLOCTable {
+public:
+    explicit ByteCodeLOCTable(ByteCodeLOCData& data);
+
+    // returns false if there is no entry for codePosition.
+    // sourceIndex can be SIZE_MAX when the code has no source node
+    bool find(size_t codePosition, size_t& sourceIndex) const;
+
+    size_t memoryAllocatedSize() const
+    {
+        return sizeof(ByteCodeLOCTable) + m_data.capacity() + m_checkpoints.capacity() * sizeof(Checkpoint);
+    }
+
+private:
+    static const size_t CheckpointInterval = 16;
+
+    struct Checkpoint {
+        size_t m_codePosition;
+        size_t m_sourceIndex; // source index + 1, 0 means SIZE_MAX
+        size_t m_dataOffset; // offset of the next entry in m_data
+    };
+
+    static void writeVarInt(std::vector<uint8_t>& out, size_t value);
+    static size_t readVarInt(const uint8_t*& data);
+
+    size_t m_size;
+    std::vector<uint8_t> m_data;
+    std::vector<Checkpoint> m_checkpoints;
+};
+
 class ByteCodeBlock : public gc {
     friend struct OpcodeTable;
     friend class VMInstance;
@@ -2401,7 +2831,7 @@ public:
         }
 #endif
 
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
         Opcode opcode = (Opcode)(size_t)code.m_opcodeInAddress;
 #else
         Opcode opcode = code.m_opcode;
@@ -2409,8 +2839,8 @@ public:
 
         char* first = (char*)&code;
         size_t start = m_code.size();
-        if (context->m_shouldGenerateLOCData)
-            m_locData->push_back(std::make_pair(start, idx));
+        if (context->m_locData)
+            context->m_locData->push_back(std::make_pair(start, idx));
 
         m_code.resizeWithUninitializedValues(m_code.size() + sizeof(CodeType));
         for (size_t i = 0; i < sizeof(CodeType); i++) {
@@ -2468,7 +2898,7 @@ public:
     {
         size_t siz = m_code.capacity();
         siz += sizeof(ByteCodeBlock);
-        siz += m_locData ? (m_locData->size() * sizeof(std::pair<size_t, size_t>)) : 0;
+        siz += m_locData ? m_locData->memoryAllocatedSize() : 0;
         siz += m_numeralLiteralData.size() * sizeof(Value);
         siz += m_literalData.size() * sizeof(size_t);
         siz += m_inlineCacheDataSize;
@@ -2484,13 +2914,15 @@ public:
     bool m_shouldClearStack : 1;
     bool m_isOwnerMayFreed : 1;
     ByteCodeRegisterIndex m_requiredRegisterFileSizeInValueSize : REGISTER_INDEX_IN_BIT;
+    // number of GCs since this block was called last (saturated). VMInstance releases old blocks first
+    uint8_t m_age;
 
     ByteCodeBlockData m_code;
     ByteCodeNumeralLiteralData m_numeralLiteralData;
     ByteCodeLiteralData m_literalData;
     size_t m_inlineCacheDataSize;
 
-    ByteCodeLOCData* m_locData;
+    ByteCodeLOCTable* m_locData;
     InterpretedCodeBlock* m_codeBlock;
 
     void* operator new(size_t size);
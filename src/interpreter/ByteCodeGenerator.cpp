@@ -108,6 +108,871 @@ static const uint8_t byteCodeLengths[] = {
 #undef ITER_BYTE_CODE
 };
 
+static ALWAYS_INLINE Opcode opcodeBeforeRelocation(ByteCode* code)
+{
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+static ALWAYS_INLINE void setOpcodeBeforeRelocation(ByteCode* code, Opcode opcode)
+{
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
+    code->m_opcodeInAddress = (void*)opcode;
+#else
+    code->m_opcode = opcode;
+#endif
+}
+
+static Opcode fusedCompareAndJumpIfFalseOpcode(Opcode opcode)
+{
+    switch (opcode) {
+    case BinaryEqualOpcode:
+        return BinaryEqualAndJumpIfFalseOpcode;
+    case BinaryNotEqualOpcode:
+        return BinaryNotEqualAndJumpIfFalseOpcode;
+    case BinaryStrictEqualOpcode:
+        return BinaryStrictEqualAndJumpIfFalseOpcode;
+    case BinaryNotStrictEqualOpcode:
+        return BinaryNotStrictEqualAndJumpIfFalseOpcode;
+    case BinaryLessThanOpcode:
+        return BinaryLessThanAndJumpIfFalseOpcode;
+    case BinaryLessThanOrEqualOpcode:
+        return BinaryLessThanOrEqualAndJumpIfFalseOpcode;
+    case BinaryGreaterThanOpcode:
+        return BinaryGreaterThanAndJumpIfFalseOpcode;
+    case BinaryGreaterThanOrEqualOpcode:
+        return BinaryGreaterThanOrEqualAndJumpIfFalseOpcode;
+    default:
+        return OpcodeKindEnd;
+    }
+}
+
+// register operands of a bytecode, used by register coalescing.
+// m_uses and m_def point into the code buffer, so operands can be rewritten in place
+struct ByteCodeRegisterOperands {
+    ByteCodeRegisterOperands()
+        : m_useCount(0)
+        , m_def(nullptr)
+        , m_rangeStart(REGISTER_LIMIT)
+        , m_rangeLength(0)
+        , m_jumpPosition(nullptr)
+        , m_codePosition(nullptr)
+        , m_hasFallThrough(true)
+    {
+    }
+
+    void addUse(ByteCodeRegisterIndex& index)
+    {
+        ASSERT(m_useCount < 3);
+        m_uses[m_useCount++] = &index;
+    }
+
+    bool isInRange(ByteCodeRegisterIndex index) const
+    {
+        return m_rangeLength && index >= m_rangeStart && index < m_rangeStart + m_rangeLength;
+    }
+
+    bool isUsing(ByteCodeRegisterIndex index) const
+    {
+        for (size_t i = 0; i < m_useCount; i++) {
+            if (*m_uses[i] == index) {
+                return true;
+            }
+        }
+        return isInRange(index);
+    }
+
+    bool isDefining(ByteCodeRegisterIndex index) const
+    {
+        return m_def && *m_def == index;
+    }
+
+    ByteCodeRegisterIndex* m_uses[3];
+    size_t m_useCount;
+    ByteCodeRegisterIndex* m_def;
+    ByteCodeRegisterIndex m_rangeStart;
+    size_t m_rangeLength;
+    size_t* m_jumpPosition;
+    // position of another code referred by this code, which is not a jump target
+    size_t* m_codePosition;
+    bool m_hasFallThrough;
+};
+
+// returns false when register usage of the bytecode is not modeled.
+// every handler of the modeled bytecodes reads its source registers before writing the destination register
+static bool collectRegisterOperands(ByteCode* code, Opcode opcode, ByteCodeRegisterOperands& operands)
+{
+#define SOURCE_TO_DESTINATION_CASE(CodeName)             \
+    case CodeName##Opcode: {                             \
+        CodeName* cd = (CodeName*)code;                  \
+        operands.addUse(cd->m_srcIndex);                 \
+        operands.m_def = &cd->m_dstIndex;                \
+        return true;                                     \
+    }
+
+#define BINARY_OPERATION_CASE(CodeName)                  \
+    case CodeName##Opcode: {                             \
+        CodeName* cd = (CodeName*)code;                  \
+        operands.addUse(cd->m_srcIndex0);                \
+        operands.addUse(cd->m_srcIndex1);                \
+        operands.m_def = &cd->m_dstIndex;                \
+        return true;                                     \
+    }
+
+    switch (opcode) {
+    case LoadLiteralOpcode:
+        operands.m_def = &((LoadLiteral*)code)->m_registerIndex;
+        return true;
+    case LoadThisBindingOpcode:
+        operands.m_def = &((LoadThisBinding*)code)->m_dstIndex;
+        return true;
+    case GetParameterOpcode:
+        operands.m_def = &((GetParameter*)code)->m_registerIndex;
+        return true;
+    case GetGlobalVariableOpcode:
+        operands.m_def = &((GetGlobalVariable*)code)->m_registerIndex;
+        return true;
+    case SetGlobalVariableOpcode:
+        operands.addUse(((SetGlobalVariable*)code)->m_registerIndex);
+        return true;
+    case LoadByHeapIndexOpcode:
+        operands.m_def = &((LoadByHeapIndex*)code)->m_registerIndex;
+        return true;
+    case StoreByHeapIndexOpcode:
+        operands.addUse(((StoreByHeapIndex*)code)->m_registerIndex);
+        return true;
+    case CreateObjectOpcode:
+        operands.m_def = &((CreateObject*)code)->m_registerIndex;
+        return true;
+    case CreateObjectWithStructureOpcode:
+        operands.m_def = &((CreateObjectWithStructure*)code)->m_registerIndex;
+        return true;
+    case InitializeObjectLiteralPropertyOpcode: {
+        InitializeObjectLiteralProperty* cd = (InitializeObjectLiteralProperty*)code;
+        operands.addUse(cd->m_objectRegisterIndex);
+        operands.addUse(cd->m_loadRegisterIndex);
+        if (cd->m_createObjectCodePosition != SIZE_MAX) {
+            operands.m_codePosition = &cd->m_createObjectCodePosition;
+        }
+        return true;
+    }
+    case CreateArrayOpcode:
+        operands.m_def = &((CreateArray*)code)->m_registerIndex;
+        return true;
+    case CreateFunctionOpcode: {
+        CreateFunction* cd = (CreateFunction*)code;
+        operands.addUse(cd->m_homeObjectRegisterIndex);
+        operands.m_def = &cd->m_registerIndex;
+        return true;
+    }
+    case MoveOpcode: {
+        Move* cd = (Move*)code;
+        operands.addUse(cd->m_registerIndex0);
+        operands.m_def = &cd->m_registerIndex1;
+        return true;
+    }
+        SOURCE_TO_DESTINATION_CASE(Increment)
+        SOURCE_TO_DESTINATION_CASE(Decrement)
+        SOURCE_TO_DESTINATION_CASE(ToNumber)
+        SOURCE_TO_DESTINATION_CASE(UnaryMinus)
+        SOURCE_TO_DESTINATION_CASE(UnaryNot)
+        SOURCE_TO_DESTINATION_CASE(UnaryBitwiseNot)
+        SOURCE_TO_DESTINATION_CASE(UnaryTypeof)
+        BINARY_OPERATION_CASE(BinaryPlus)
+        BINARY_OPERATION_CASE(BinaryMinus)
+        BINARY_OPERATION_CASE(BinaryMultiply)
+        BINARY_OPERATION_CASE(BinaryDivision)
+        BINARY_OPERATION_CASE(BinaryExponentiation)
+        BINARY_OPERATION_CASE(BinaryMod)
+        BINARY_OPERATION_CASE(BinaryEqual)
+        BINARY_OPERATION_CASE(BinaryLessThan)
+        BINARY_OPERATION_CASE(BinaryLessThanOrEqual)
+        BINARY_OPERATION_CASE(BinaryGreaterThan)
+        BINARY_OPERATION_CASE(BinaryGreaterThanOrEqual)
+        BINARY_OPERATION_CASE(BinaryNotEqual)
+        BINARY_OPERATION_CASE(BinaryStrictEqual)
+        BINARY_OPERATION_CASE(BinaryNotStrictEqual)
+        BINARY_OPERATION_CASE(BinaryBitwiseAnd)
+        BINARY_OPERATION_CASE(BinaryBitwiseOr)
+        BINARY_OPERATION_CASE(BinaryBitwiseXor)
+        BINARY_OPERATION_CASE(BinaryLeftShift)
+        BINARY_OPERATION_CASE(BinarySignedRightShift)
+        BINARY_OPERATION_CASE(BinaryUnsignedRightShift)
+        BINARY_OPERATION_CASE(BinaryInOperation)
+        BINARY_OPERATION_CASE(BinaryInstanceOfOperation)
+    case GetObjectOpcode: {
+        GetObject* cd = (GetObject*)code;
+        operands.addUse(cd->m_objectRegisterIndex);
+        operands.addUse(cd->m_propertyRegisterIndex);
+        operands.m_def = &cd->m_storeRegisterIndex;
+        return true;
+    }
+    case SetObjectOperationOpcode: {
+        SetObjectOperation* cd = (SetObjectOperation*)code;
+        operands.addUse(cd->m_objectRegisterIndex);
+        operands.addUse(cd->m_propertyRegisterIndex);
+        operands.addUse(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case GetObjectPreComputedCaseOpcode: {
+        GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)code;
+        operands.addUse(cd->m_objectRegisterIndex);
+        operands.m_def = &cd->m_storeRegisterIndex;
+        return true;
+    }
+    case SetObjectPreComputedCaseOpcode: {
+        SetObjectPreComputedCase* cd = (SetObjectPreComputedCase*)code;
+        operands.addUse(cd->m_objectRegisterIndex);
+        operands.addUse(cd->m_loadRegisterIndex);
+        return true;
+    }
+    case CallFunctionOpcode: {
+        CallFunction* cd = (CallFunction*)code;
+        operands.addUse(cd->m_calleeIndex);
+        operands.m_rangeStart = cd->m_argumentsStartIndex;
+        operands.m_rangeLength = cd->m_argumentCount;
+        operands.m_def = &cd->m_resultIndex;
+        return true;
+    }
+    case CallFunctionWithReceiverOpcode: {
+        CallFunctionWithReceiver* cd = (CallFunctionWithReceiver*)code;
+        operands.addUse(cd->m_receiverIndex);
+        operands.addUse(cd->m_calleeIndex);
+        operands.m_rangeStart = cd->m_argumentsStartIndex;
+        operands.m_rangeLength = cd->m_argumentCount;
+        operands.m_def = &cd->m_resultIndex;
+        return true;
+    }
+    case JumpOpcode:
+        operands.m_jumpPosition = &((Jump*)code)->m_jumpPosition;
+        operands.m_hasFallThrough = false;
+        return true;
+    case JumpIfTrueOpcode: {
+        JumpIfTrue* cd = (JumpIfTrue*)code;
+        operands.addUse(cd->m_registerIndex);
+        operands.m_jumpPosition = &cd->m_jumpPosition;
+        return true;
+    }
+    case JumpIfFalseOpcode: {
+        JumpIfFalse* cd = (JumpIfFalse*)code;
+        operands.addUse(cd->m_registerIndex);
+        operands.m_jumpPosition = &cd->m_jumpPosition;
+        return true;
+    }
+    case JumpIfRelationOpcode: {
+        JumpIfRelation* cd = (JumpIfRelation*)code;
+        operands.addUse(cd->m_registerIndex0);
+        operands.addUse(cd->m_registerIndex1);
+        operands.m_jumpPosition = &cd->m_jumpPosition;
+        return true;
+    }
+    case JumpIfEqualOpcode: {
+        JumpIfEqual* cd = (JumpIfEqual*)code;
+        operands.addUse(cd->m_registerIndex0);
+        operands.addUse(cd->m_registerIndex1);
+        operands.m_jumpPosition = &cd->m_jumpPosition;
+        return true;
+    }
+    case ThrowOperationOpcode:
+        operands.addUse(((ThrowOperation*)code)->m_registerIndex);
+        operands.m_hasFallThrough = false;
+        return true;
+    case EndOpcode:
+        operands.addUse(((End*)code)->m_registerIndex);
+        operands.m_hasFallThrough = false;
+        return true;
+    default:
+        return false;
+    }
+
+#undef SOURCE_TO_DESTINATION_CASE
+#undef BINARY_OPERATION_CASE
+}
+
+class ByteCodeRegisterCoalescer {
+public:
+    ByteCodeRegisterCoalescer(ByteCodeBlock* block, ByteCodeLOCData* locData)
+        : m_block(block)
+        , m_locData(locData)
+        , m_visitStamp(0)
+    {
+    }
+
+    void coalesce();
+
+    // liveness query for other passes. code should not be changed after analyze
+    bool analyze()
+    {
+        return collect();
+    }
+    bool isLiveAfterCodeAt(size_t position, ByteCodeRegisterIndex reg)
+    {
+        return isLiveAfter(indexOfPosition(position), reg);
+    }
+    static bool isTemporaryRegister(ByteCodeRegisterIndex index)
+    {
+        return index < REGULAR_REGISTER_LIMIT;
+    }
+
+private:
+    bool collect();
+    size_t indexOfPosition(size_t position)
+    {
+        auto iter = std::lower_bound(m_positions.begin(), m_positions.end(), position);
+        ASSERT(iter != m_positions.end() && *iter == position);
+        return iter - m_positions.begin();
+    }
+    bool isLiveAfter(size_t index, ByteCodeRegisterIndex reg);
+    void remove(size_t index);
+    bool tryCoalesce(size_t index);
+    void compact();
+    void shrinkRegisterFile();
+
+    static const size_t maxCodeCount = 8192;
+
+    ByteCodeBlock* m_block;
+    ByteCodeLOCData* m_locData;
+    std::vector<size_t> m_positions;
+    std::vector<ByteCodeRegisterOperands> m_operands;
+    std::vector<bool> m_isJumpTarget;
+    std::vector<bool> m_isRemoved;
+    std::vector<size_t> m_visited;
+    std::vector<size_t> m_worklist;
+    size_t m_visitStamp;
+};
+
+bool ByteCodeRegisterCoalescer::collect()
+{
+    char* codeBase = m_block->m_code.data();
+    size_t codeSize = m_block->m_code.size();
+    size_t position = 0;
+
+    while (position < codeSize) {
+        // liveness check is not linear. give up on huge blocks
+        if (m_positions.size() >= maxCodeCount) {
+            return false;
+        }
+        ByteCode* currentCode = (ByteCode*)(codeBase + position);
+        Opcode opcode = opcodeBeforeRelocation(currentCode);
+        ASSERT(opcode <= EndOpcode);
+
+        ByteCodeRegisterOperands operands;
+        if (!collectRegisterOperands(currentCode, opcode, operands)) {
+            return false;
+        }
+        m_positions.push_back(position);
+        m_operands.push_back(operands);
+        position += byteCodeLengths[opcode];
+    }
+
+    size_t count = m_positions.size();
+    m_isJumpTarget.assign(count, false);
+    m_isRemoved.assign(count, false);
+    m_visited.assign(count + 1, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        if (m_operands[i].m_jumpPosition) {
+            size_t target = *m_operands[i].m_jumpPosition;
+            if (target >= codeSize || !std::binary_search(m_positions.begin(), m_positions.end(), target)) {
+                return false;
+            }
+            m_isJumpTarget[indexOfPosition(target)] = true;
+        }
+        if (m_operands[i].m_codePosition) {
+            size_t target = *m_operands[i].m_codePosition;
+            if (target >= codeSize || !std::binary_search(m_positions.begin(), m_positions.end(), target)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// check whether the value of `reg` after bytecode[index] can be read by its successors
+bool ByteCodeRegisterCoalescer::isLiveAfter(size_t index, ByteCodeRegisterIndex reg)
+{
+    size_t count = m_positions.size();
+    m_visitStamp++;
+    m_worklist.clear();
+    if (m_operands[index].m_jumpPosition) {
+        m_worklist.push_back(indexOfPosition(*m_operands[index].m_jumpPosition));
+    }
+    if (m_operands[index].m_hasFallThrough) {
+        m_worklist.push_back(index + 1);
+    }
+
+    while (m_worklist.size()) {
+        size_t i = m_worklist.back();
+        m_worklist.pop_back();
+        if (i >= count || m_visited[i] == m_visitStamp) {
+            continue;
+        }
+        m_visited[i] = m_visitStamp;
+
+        if (m_isRemoved[i]) {
+            m_worklist.push_back(i + 1);
+            continue;
+        }
+
+        const ByteCodeRegisterOperands& operands = m_operands[i];
+        if (operands.isUsing(reg)) {
+            return true;
+        }
+        if (operands.isDefining(reg)) {
+            continue;
+        }
+        if (operands.m_jumpPosition) {
+            m_worklist.push_back(indexOfPosition(*operands.m_jumpPosition));
+        }
+        if (operands.m_hasFallThrough) {
+            m_worklist.push_back(i + 1);
+        }
+    }
+    return false;
+}
+
+void ByteCodeRegisterCoalescer::remove(size_t index)
+{
+    m_isRemoved[index] = true;
+    // jumps to removed code will land on the next code
+    if (m_isJumpTarget[index] && index + 1 < m_positions.size()) {
+        m_isJumpTarget[index + 1] = true;
+    }
+}
+
+bool ByteCodeRegisterCoalescer::tryCoalesce(size_t index)
+{
+    ByteCodeRegisterOperands& move = m_operands[index];
+    ByteCode* currentCode = (ByteCode*)(m_block->m_code.data() + m_positions[index]);
+    if (opcodeBeforeRelocation(currentCode) != MoveOpcode) {
+        return false;
+    }
+
+    ByteCodeRegisterIndex src = *move.m_uses[0];
+    ByteCodeRegisterIndex dst = *move.m_def;
+
+    // mov r0 <- r0
+    if (src == dst) {
+        remove(index);
+        return true;
+    }
+
+    // mov r0 <- r1, and r0 is never read
+    if (isTemporaryRegister(dst) && !isLiveAfter(index, dst)) {
+        remove(index);
+        return true;
+    }
+
+    // r1 <- op ..., mov r0 <- r1  =>  r0 <- op ...
+    if (isTemporaryRegister(src) && !m_isJumpTarget[index]) {
+        size_t prev = index;
+        while (prev > 0 && m_isRemoved[prev - 1]) {
+            prev--;
+        }
+        if (prev > 0 && m_operands[prev - 1].isDefining(src) && !m_operands[prev - 1].m_jumpPosition && !isLiveAfter(index, src)) {
+            *m_operands[prev - 1].m_def = dst;
+            remove(index);
+            return true;
+        }
+    }
+
+    // mov r1 <- r0, op ... r1 ...  =>  op ... r0 ...
+    if (isTemporaryRegister(dst)) {
+        size_t next = index + 1;
+        while (next < m_positions.size() && m_isRemoved[next]) {
+            next++;
+        }
+        if (next < m_positions.size() && !m_isJumpTarget[next]) {
+            ByteCodeRegisterOperands& user = m_operands[next];
+            if (user.isUsing(dst) && !user.isInRange(dst) && (user.isDefining(dst) || !isLiveAfter(next, dst))) {
+                for (size_t i = 0; i < user.m_useCount; i++) {
+                    if (*user.m_uses[i] == dst) {
+                        *user.m_uses[i] = src;
+                    }
+                }
+                remove(index);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void ByteCodeRegisterCoalescer::compact()
+{
+    size_t count = m_positions.size();
+    size_t codeSize = m_block->m_code.size();
+    char* codeBase = m_block->m_code.data();
+
+    // new position of each code. removed code gets the position of the code after it
+    std::vector<size_t> newPositions(count + 1);
+    size_t newPosition = 0;
+    for (size_t i = 0; i < count; i++) {
+        newPositions[i] = newPosition;
+        if (!m_isRemoved[i]) {
+            newPosition += (i + 1 < count ? m_positions[i + 1] : codeSize) - m_positions[i];
+        }
+    }
+    newPositions[count] = newPosition;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!m_isRemoved[i] && m_operands[i].m_jumpPosition) {
+            size_t* jumpPosition = m_operands[i].m_jumpPosition;
+            *jumpPosition = newPositions[indexOfPosition(*jumpPosition)];
+        }
+        if (!m_isRemoved[i] && m_operands[i].m_codePosition) {
+            size_t* codePosition = m_operands[i].m_codePosition;
+            *codePosition = newPositions[indexOfPosition(*codePosition)];
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!m_isRemoved[i]) {
+            size_t length = (i + 1 < count ? m_positions[i + 1] : codeSize) - m_positions[i];
+            memmove(codeBase + newPositions[i], codeBase + m_positions[i], length);
+        }
+    }
+    m_block->m_code.resize(newPosition);
+
+    if (m_locData) {
+        ByteCodeLOCData* locData = m_locData;
+        size_t j = 0;
+        for (size_t i = 0; i < locData->size(); i++) {
+            size_t index = indexOfPosition((*locData)[i].first);
+            if (!m_isRemoved[index]) {
+                (*locData)[j++] = std::make_pair(newPositions[index], (*locData)[i].second);
+            }
+        }
+        locData->resize(j);
+    }
+}
+
+void ByteCodeRegisterCoalescer::shrinkRegisterFile()
+{
+    size_t required = 0;
+    for (size_t i = 0; i < m_operands.size(); i++) {
+        if (m_isRemoved[i]) {
+            continue;
+        }
+        const ByteCodeRegisterOperands& operands = m_operands[i];
+        for (size_t j = 0; j < operands.m_useCount; j++) {
+            if (isTemporaryRegister(*operands.m_uses[j])) {
+                required = std::max(required, (size_t)*operands.m_uses[j] + 1);
+            }
+        }
+        if (operands.m_def && isTemporaryRegister(*operands.m_def)) {
+            required = std::max(required, (size_t)*operands.m_def + 1);
+        }
+        if (operands.m_rangeLength && isTemporaryRegister(operands.m_rangeStart)) {
+            required = std::max(required, (size_t)operands.m_rangeStart + operands.m_rangeLength);
+        }
+    }
+
+    if (required < m_block->m_requiredRegisterFileSizeInValueSize) {
+        m_block->m_requiredRegisterFileSizeInValueSize = required;
+    }
+}
+
+// copy propagation and dead move elimination over temporary registers.
+// only blocks consisting of modeled bytecodes are processed (no try, generator, with, for-in...)
+// this should be called before relocation (operand pointers are collected from code buffer)
+void ByteCodeRegisterCoalescer::coalesce()
+{
+    if (!collect()) {
+        return;
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < m_positions.size(); i++) {
+        if (!m_isRemoved[i] && tryCoalesce(i)) {
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        shrinkRegisterFile();
+        compact();
+    }
+}
+
+// rewrite frequent bytecode pairs into fused super instructions.
+// only the opcode of the first bytecode is changed, so code size, jump positions and LOC data remain same.
+// this should be called before relocation (opcodes are not converted into addresses and jump positions are relative yet)
+static void fuseSuperInstructions(ByteCodeBlock* block)
+{
+    char* codeBase = block->m_code.data();
+    char* code = codeBase;
+    char* end = code + block->m_code.size();
+
+    // opcode changes below do not change register usage, so liveness stays valid during fusion
+    ByteCodeRegisterCoalescer liveness(block, nullptr);
+    bool hasLiveness = liveness.analyze();
+
+    while (code < end) {
+        ByteCode* currentCode = (ByteCode*)code;
+        Opcode opcode = opcodeBeforeRelocation(currentCode);
+        ASSERT(opcode <= EndOpcode);
+
+        char* next = code + byteCodeLengths[opcode];
+        if (opcode == ExecutionPauseOpcode) {
+            ExecutionPause* cd = (ExecutionPause*)currentCode;
+            if (cd->m_reason == ExecutionPause::Reason::Yield) {
+                next += cd->m_yieldData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::Reason::Await) {
+                next += cd->m_awaitData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::Reason::AsyncGeneratorInitialize) {
+                next += cd->m_asyncGeneratorInitializeData.m_tailDataLength;
+            }
+            code = next;
+            continue;
+        }
+
+        if (next >= end) {
+            break;
+        }
+
+        ByteCode* nextCode = (ByteCode*)next;
+        Opcode nextOpcode = opcodeBeforeRelocation(nextCode);
+
+        switch (opcode) {
+        case GetObjectPreComputedCaseOpcode: {
+            if (nextOpcode == CallFunctionWithReceiverOpcode) {
+                setOpcodeBeforeRelocation(currentCode, GetObjectPreComputedCaseAndCallOpcode);
+            }
+            break;
+        }
+        case LoadLiteralOpcode: {
+            if (nextOpcode == BinaryPlusOpcode) {
+                setOpcodeBeforeRelocation(currentCode, LoadLiteralAndBinaryPlusOpcode);
+            }
+            break;
+        }
+        case BinaryEqualOpcode:
+        case BinaryNotEqualOpcode:
+        case BinaryStrictEqualOpcode:
+        case BinaryNotStrictEqualOpcode:
+        case BinaryLessThanOpcode:
+        case BinaryLessThanOrEqualOpcode:
+        case BinaryGreaterThanOpcode:
+        case BinaryGreaterThanOrEqualOpcode: {
+            // fused code branches with the compare result directly
+            BinaryEqual* compare = (BinaryEqual*)currentCode;
+            if (nextOpcode == JumpIfFalseOpcode && ((JumpIfFalse*)nextCode)->m_registerIndex == compare->m_dstIndex) {
+                setOpcodeBeforeRelocation(currentCode, fusedCompareAndJumpIfFalseOpcode(opcode));
+                // fused code skips JumpIfFalse. so the result needs no store if nothing else reads it
+                if (hasLiveness && ByteCodeRegisterCoalescer::isTemporaryRegister(compare->m_dstIndex)
+                    && !liveness.isLiveAfterCodeAt(next - codeBase, compare->m_dstIndex)) {
+                    compare->m_isResultUnused = true;
+                }
+            }
+            break;
+        }
+        case IncrementOpcode:
+        case DecrementOpcode: {
+            // loop back-edge of `for (...; i < n; i++)`
+            if (nextOpcode == JumpOpcode) {
+                size_t jumpPosition = ((Jump*)nextCode)->m_jumpPosition;
+                if (jumpPosition < block->m_code.size() && opcodeBeforeRelocation((ByteCode*)(codeBase + jumpPosition)) == JumpIfRelationOpcode) {
+                    setOpcodeBeforeRelocation(currentCode, opcode == IncrementOpcode ? IncrementAndJumpToRelationOpcode : DecrementAndJumpToRelationOpcode);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        code = next;
+    }
+}
+
+// region of bytecode which is rarely executed, moved to the end of block by moveColdCodeToEnd
+struct ByteCodeColdRegion {
+    size_t m_start;
+    size_t m_end;
+    size_t m_newStart;
+};
+
+static size_t positionAfterMovingColdCode(const std::vector<ByteCodeColdRegion>& regions, size_t position)
+{
+    size_t movedLength = 0;
+    for (size_t i = 0; i < regions.size(); i++) {
+        const ByteCodeColdRegion& r = regions[i];
+        if (position < r.m_start) {
+            break;
+        }
+        if (position < r.m_end) {
+            return r.m_newStart + position - r.m_start;
+        }
+        movedLength += r.m_end - r.m_start;
+    }
+    return position - movedLength;
+}
+
+// move catch clauses to the end of block, so hot code around try statements shares fewer cache lines with them.
+// catch clause is only entered from TryOperation by nested interpretation and it ends with TryCatchFinallyWithBlockBodyEnd,
+// so no code falls through into or out of it and moving it only needs rewriting of code positions.
+// blocks with generator or async pause points are not processed (tail data of ExecutionPause contains code positions)
+// this should be called before relocation (jump positions are relative yet)
+static void moveColdCodeToEnd(ByteCodeBlock* block, ByteCodeLOCData* locData)
+{
+    char* codeBase = block->m_code.data();
+    size_t codeSize = block->m_code.size();
+
+    std::vector<size_t> positions;
+    std::vector<ByteCodeColdRegion> regions;
+    std::vector<size_t*> positionFields;
+    std::vector<ControlFlowRecord*> records;
+
+    size_t position = 0;
+    while (position < codeSize) {
+        ByteCode* currentCode = (ByteCode*)(codeBase + position);
+        Opcode opcode = opcodeBeforeRelocation(currentCode);
+        ASSERT(opcode <= EndOpcode);
+
+        switch (opcode) {
+        case ExecutionPauseOpcode:
+        case ExecutionResumeOpcode:
+            return;
+        case JumpOpcode:
+            positionFields.push_back(&((Jump*)currentCode)->m_jumpPosition);
+            break;
+        case JumpIfTrueOpcode:
+        case JumpIfFalseOpcode:
+        case JumpIfRelationOpcode:
+        case JumpIfEqualOpcode:
+            positionFields.push_back(&((JumpByteCode*)currentCode)->m_jumpPosition);
+            break;
+        case JumpComplexCaseOpcode: {
+            ControlFlowRecord* record = ((JumpComplexCase*)currentCode)->m_controlFlowRecord;
+            if (record->reason() == ControlFlowRecord::NeedsJump) {
+                records.push_back(record);
+            }
+            break;
+        }
+        case TryOperationOpcode: {
+            TryOperation* cd = (TryOperation*)currentCode;
+            positionFields.push_back(&cd->m_catchPosition);
+            positionFields.push_back(&cd->m_tryCatchEndPosition);
+            positionFields.push_back(&cd->m_finallyEndPosition);
+            if (cd->m_hasCatch && cd->m_catchPosition < cd->m_tryCatchEndPosition && cd->m_tryCatchEndPosition < codeSize) {
+                regions.push_back({ cd->m_catchPosition, cd->m_tryCatchEndPosition, SIZE_MAX });
+            }
+            break;
+        }
+        case CheckLastEnumerateKeyOpcode:
+            positionFields.push_back(&((CheckLastEnumerateKey*)currentCode)->m_exitPosition);
+            break;
+        case IteratorOperationOpcode: {
+            IteratorOperation* cd = (IteratorOperation*)currentCode;
+            if (cd->m_operation == IteratorOperation::Operation::IteratorStep) {
+                positionFields.push_back(&cd->m_iteratorStepData.m_forOfEndPosition);
+            }
+            break;
+        }
+        case WithOperationOpcode:
+            positionFields.push_back(&((WithOperation*)currentCode)->m_withEndPostion);
+            break;
+        case BlockOperationOpcode:
+            positionFields.push_back(&((BlockOperation*)currentCode)->m_blockEndPosition);
+            break;
+        case InitializeObjectLiteralPropertyOpcode: {
+            InitializeObjectLiteralProperty* cd = (InitializeObjectLiteralProperty*)currentCode;
+            if (cd->m_createObjectCodePosition != SIZE_MAX) {
+                positionFields.push_back(&cd->m_createObjectCodePosition);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        positions.push_back(position);
+        position += byteCodeLengths[opcode];
+    }
+
+    if (regions.empty()) {
+        return;
+    }
+
+    auto isCodeStart = [&](size_t codePosition) -> bool {
+        return std::binary_search(positions.begin(), positions.end(), codePosition);
+    };
+
+    // every code position should point the start of a code in this block
+    for (size_t i = 0; i < positionFields.size(); i++) {
+        size_t target = *positionFields[i];
+        if (target != SIZE_MAX && (target >= codeSize || !isCodeStart(target))) {
+            return;
+        }
+    }
+    for (size_t i = 0; i < records.size(); i++) {
+        if (records[i]->wordValue() >= codeSize || !isCodeStart(records[i]->wordValue())) {
+            return;
+        }
+    }
+
+    // catch clause inside of another catch clause moves together with the outer one
+    std::sort(regions.begin(), regions.end(), [](const ByteCodeColdRegion& a, const ByteCodeColdRegion& b) -> bool {
+        return a.m_start < b.m_start;
+    });
+    size_t regionCount = 0;
+    size_t coldLength = 0;
+    for (size_t i = 0; i < regions.size(); i++) {
+        const ByteCodeColdRegion& r = regions[i];
+        if (regionCount && r.m_start < regions[regionCount - 1].m_end) {
+            continue;
+        }
+        size_t lastCodePosition = r.m_end - sizeof(TryCatchFinallyWithBlockBodyEnd);
+        if (!isCodeStart(r.m_start) || !isCodeStart(r.m_end) || !isCodeStart(lastCodePosition)
+            || opcodeBeforeRelocation((ByteCode*)(codeBase + lastCodePosition)) != TryCatchFinallyWithBlockBodyEndOpcode) {
+            return;
+        }
+        regions[regionCount++] = r;
+        coldLength += r.m_end - r.m_start;
+    }
+    regions.resize(regionCount);
+
+    size_t newStart = codeSize - coldLength;
+    for (size_t i = 0; i < regions.size(); i++) {
+        regions[i].m_newStart = newStart;
+        newStart += regions[i].m_end - regions[i].m_start;
+    }
+
+    for (size_t i = 0; i < positionFields.size(); i++) {
+        if (*positionFields[i] != SIZE_MAX) {
+            *positionFields[i] = positionAfterMovingColdCode(regions, *positionFields[i]);
+        }
+    }
+    for (size_t i = 0; i < records.size(); i++) {
+        records[i]->setWordValue(positionAfterMovingColdCode(regions, records[i]->wordValue()));
+    }
+
+    std::vector<char> oldCode(codeBase, codeBase + codeSize);
+    size_t hotStart = 0;
+    size_t hotPosition = 0;
+    for (size_t i = 0; i <= regions.size(); i++) {
+        size_t hotEnd = i < regions.size() ? regions[i].m_start : codeSize;
+        memcpy(codeBase + hotPosition, oldCode.data() + hotStart, hotEnd - hotStart);
+        hotPosition += hotEnd - hotStart;
+        if (i < regions.size()) {
+            memcpy(codeBase + regions[i].m_newStart, oldCode.data() + regions[i].m_start, regions[i].m_end - regions[i].m_start);
+            hotStart = regions[i].m_end;
+        }
+    }
+    ASSERT(hotPosition == codeSize - coldLength);
+
+    if (locData) {
+        for (size_t i = 0; i < locData->size(); i++) {
+            (*locData)[i].first = positionAfterMovingColdCode(regions, (*locData)[i].first);
+        }
+    }
+}
+
 ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBlock* codeBlock, Node* ast, ASTFunctionScopeContext* scopeCtx, bool isEvalMode, bool isOnGlobal, bool inWithFromRuntime, bool shouldGenerateLOCData)
 {
     ByteCodeBlock* block = new ByteCodeBlock(codeBlock);
@@ -134,10 +999,10 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         nData = nullptr;
     }
 
+    ByteCodeLOCData locData;
     ByteCodeGenerateContext ctx(codeBlock, block, info, nData);
-    ctx.m_shouldGenerateLOCData = shouldGenerateLOCData;
     if (shouldGenerateLOCData) {
-        block->m_locData = new ByteCodeLOCData();
+        ctx.m_locData = &locData;
     }
 
     // generate common codes
@@ -170,11 +1035,9 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         ThrowStaticErrorOperation code(ByteCodeLOC(err.m_index), ErrorObject::SyntaxError, data);
         block->m_code.resize(sizeof(ThrowStaticErrorOperation));
         memcpy(block->m_code.data(), &code, sizeof(ThrowStaticErrorOperation));
-        if (block->m_locData) {
-            delete block->m_locData;
-        }
-        block->m_locData = new ByteCodeLOCData();
-        block->m_locData->push_back(std::make_pair(0, err.m_index));
+        locData.clear();
+        locData.push_back(std::make_pair(0, err.m_index));
+        ctx.m_locData = &locData;
     } catch (const char* err) {
         // TODO
         RELEASE_ASSERT_NOT_REACHED();
@@ -194,6 +1057,20 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         }
     }
 
+#ifndef NDEBUG
+    size_t codeSizeBeforeCoalescing = block->m_code.size();
+    size_t registerCountBeforeCoalescing = block->m_requiredRegisterFileSizeInValueSize;
+#endif
+    ByteCodeRegisterCoalescer(block, ctx.m_locData).coalesce();
+
+    fuseSuperInstructions(block);
+
+    moveColdCodeToEnd(block, ctx.m_locData);
+
+    if (ctx.m_locData) {
+        block->m_locData = new ByteCodeLOCTable(locData);
+    }
+
     {
         ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
         ByteCodeRegisterIndex stackBaseWillBe = block->m_requiredRegisterFileSizeInValueSize;
@@ -205,7 +1082,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
 
         while (code < end) {
             ByteCode* currentCode = (ByteCode*)code;
-#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
             Opcode opcode = (Opcode)(size_t)currentCode->m_opcodeInAddress;
 #else
             Opcode opcode = currentCode->m_opcode;
@@ -213,7 +1090,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             currentCode->assignOpcodeInAddress();
 
             switch (opcode) {
-            case LoadLiteralOpcode: {
+            case LoadLiteralOpcode:
+            case LoadLiteralAndBinaryPlusOpcode: {
                 LoadLiteral* cd = (LoadLiteral*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
@@ -273,6 +1151,17 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case CreateObjectWithStructureOpcode: {
+                CreateObjectWithStructure* cd = (CreateObjectWithStructure*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
+            case InitializeObjectLiteralPropertyOpcode: {
+                InitializeObjectLiteralProperty* cd = (InitializeObjectLiteralProperty*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case CreateArrayOpcode: {
                 CreateArray* cd = (CreateArray*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -320,7 +1209,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                     ASSIGN_STACKINDEX_IF_NEEDED(cd->m_loadRegisterIndexs[i], stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
-            case GetObjectPreComputedCaseOpcode: {
+            case GetObjectPreComputedCaseOpcode:
+            case GetObjectPreComputedCaseAndCallOpcode: {
                 GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_storeRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -378,6 +1268,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             case ToNumberOpcode:
             case IncrementOpcode:
             case DecrementOpcode:
+            case IncrementAndJumpToRelationOpcode:
+            case DecrementAndJumpToRelationOpcode:
             case UnaryMinusOpcode:
             case UnaryNotOpcode:
             case UnaryBitwiseNotOpcode: {
@@ -553,7 +1445,15 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             case BinarySignedRightShiftOpcode:
             case BinaryUnsignedRightShiftOpcode:
             case BinaryInOperationOpcode:
-            case BinaryInstanceOfOperationOpcode: {
+            case BinaryInstanceOfOperationOpcode:
+            case BinaryEqualAndJumpIfFalseOpcode:
+            case BinaryNotEqualAndJumpIfFalseOpcode:
+            case BinaryStrictEqualAndJumpIfFalseOpcode:
+            case BinaryNotStrictEqualAndJumpIfFalseOpcode:
+            case BinaryLessThanAndJumpIfFalseOpcode:
+            case BinaryLessThanOrEqualAndJumpIfFalseOpcode:
+            case BinaryGreaterThanAndJumpIfFalseOpcode:
+            case BinaryGreaterThanOrEqualAndJumpIfFalseOpcode: {
                 BinaryPlus* plus = (BinaryPlus*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(plus->m_srcIndex0, stackBase, stackBaseWillBe, stackVariableSize);
                 ASSIGN_STACKINDEX_IF_NEEDED(plus->m_srcIndex1, stackBase, stackBaseWillBe, stackVariableSize);
@@ -677,6 +1577,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         }
 
         printf("]\n");
+        printf("register coalescing.. (code size %d -> %d, register count %d -> %d)\n", (int)codeSizeBeforeCoalescing, (int)block->m_code.size(), (int)registerCountBeforeCoalescing, (int)block->m_requiredRegisterFileSizeInValueSize);
 
         char* code = block->m_code.data();
         size_t idx = 0;
@@ -31,6 +31,9 @@ class CodeBlock;
 class ByteCodeBlock;
 class Node;
 
+// (bytecode position, source index) pairs collected while generating bytecode
+typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
+
 struct ClassContextInformation {
     ClassContextInformation()
         : m_constructorIndex(SIZE_MAX)
@@ -85,9 +88,9 @@ struct ByteCodeGenerateContext {
         , m_keepNumberalLiteralsInRegisterFile(numeralLiteralData)
         , m_inObjectDestruction(false)
         , m_inParameterInitialization(false)
-        , m_shouldGenerateLOCData(false)
         , m_forInOfVarBinding(false)
         , m_isLeftBindingAffectedByRightExpression(false)
+        , m_locData(nullptr)
         , m_registerStack(new std::vector<ByteCodeRegisterIndex>())
         , m_lexicallyDeclaredNames(new std::vector<std::pair<size_t, AtomicString>>())
         , m_positionToContinue(0)
@@ -120,9 +123,9 @@ struct ByteCodeGenerateContext {
         , m_inCallingExpressionScope(contextBefore.m_inCallingExpressionScope)
         , m_inObjectDestruction(contextBefore.m_inObjectDestruction)
         , m_inParameterInitialization(contextBefore.m_inParameterInitialization)
-        , m_shouldGenerateLOCData(contextBefore.m_shouldGenerateLOCData)
         , m_forInOfVarBinding(contextBefore.m_forInOfVarBinding)
         , m_isLeftBindingAffectedByRightExpression(contextBefore.m_isLeftBindingAffectedByRightExpression)
+        , m_locData(contextBefore.m_locData)
         , m_registerStack(contextBefore.m_registerStack)
         , m_lexicallyDeclaredNames(contextBefore.m_lexicallyDeclaredNames)
         , m_positionToContinue(contextBefore.m_positionToContinue)
@@ -339,10 +342,10 @@ struct ByteCodeGenerateContext {
     bool m_inObjectDestruction : 1;
     bool m_inParameterInitialization : 1;
     bool m_isHeadOfMemberExpression : 1;
-    bool m_shouldGenerateLOCData : 1;
     bool m_forInOfVarBinding : 1;
     bool m_isLeftBindingAffectedByRightExpression : 1; // x = delete x; or x = eval("var x"), 1;
 
+    ByteCodeLOCData* m_locData; // not null only when we should generate loc data
     std::shared_ptr<std::vector<ByteCodeRegisterIndex>> m_registerStack;
     std::shared_ptr<std::vector<std::pair<size_t, AtomicString>>> m_lexicallyDeclaredNames;
     std::vector<AtomicString> m_initializedParameterNames;
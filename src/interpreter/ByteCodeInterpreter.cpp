@@ -31,6 +31,7 @@
 #include "runtime/EnumerateObject.h"
 #include "runtime/ErrorObject.h"
 #include "runtime/ArrayObject.h"
+#include "runtime/TypedArrayObject.h"
 #include "runtime/VMInstance.h"
 #include "runtime/IteratorObject.h"
 #include "runtime/GeneratorObject.h"
@@ -61,6 +62,175 @@ ALWAYS_INLINE size_t resolveProgramCounter(char* codeBuffer, const size_t progra
     return programCounter - (size_t)codeBuffer;
 }
 
+ALWAYS_INLINE uint8_t binaryOperationTypeFeedback(const Value& left, const Value& right)
+{
+    if (left.isInt32() && right.isInt32()) {
+        return BinaryOperationTypeFeedbackInt32;
+    } else if (left.isNumber() && right.isNumber()) {
+        return BinaryOperationTypeFeedbackNumber;
+    }
+    return BinaryOperationTypeFeedbackOther;
+}
+
+template <typename TypeAdaptor>
+ALWAYS_INLINE Value getTypedArrayElement(ArrayBufferView* view, uint32_t index)
+{
+    return Value(((typename TypeAdaptor::Type*)view->rawBuffer())[index]);
+}
+
+template <typename TypeAdaptor>
+ALWAYS_INLINE void setTypedArrayElement(ExecutionState& state, ArrayBufferView* view, uint32_t index, const Value& value)
+{
+    ((typename TypeAdaptor::Type*)view->rawBuffer())[index] = TypeAdaptor::toNative(state, value);
+}
+
+// read element of cached typed array kind directly from its buffer
+ALWAYS_INLINE Value getTypedArrayElement(ArrayBufferView* view, uint8_t type, uint32_t index)
+{
+    switch (type) {
+    case TypedArrayType::Int8:
+        return getTypedArrayElement<Int8Adaptor>(view, index);
+    case TypedArrayType::Int16:
+        return getTypedArrayElement<Int16Adaptor>(view, index);
+    case TypedArrayType::Int32:
+        return getTypedArrayElement<Int32Adaptor>(view, index);
+    case TypedArrayType::Uint8:
+        return getTypedArrayElement<Uint8Adaptor>(view, index);
+    case TypedArrayType::Uint16:
+        return getTypedArrayElement<Uint16Adaptor>(view, index);
+    case TypedArrayType::Uint32:
+        return getTypedArrayElement<Uint32Adaptor>(view, index);
+    case TypedArrayType::Uint8Clamped:
+        return getTypedArrayElement<Uint8ClampedAdaptor>(view, index);
+    case TypedArrayType::Float32:
+        return getTypedArrayElement<Float32Adaptor>(view, index);
+    default:
+        ASSERT(type == TypedArrayType::Float64);
+        return getTypedArrayElement<Float64Adaptor>(view, index);
+    }
+}
+
+// write number into element of cached typed array kind. conversion of a number never calls user code
+ALWAYS_INLINE void setTypedArrayElement(ExecutionState& state, ArrayBufferView* view, uint8_t type, uint32_t index, const Value& value)
+{
+    ASSERT(value.isNumber());
+    switch (type) {
+    case TypedArrayType::Int8:
+        setTypedArrayElement<Int8Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Int16:
+        setTypedArrayElement<Int16Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Int32:
+        setTypedArrayElement<Int32Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Uint8:
+        setTypedArrayElement<Uint8Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Uint16:
+        setTypedArrayElement<Uint16Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Uint32:
+        setTypedArrayElement<Uint32Adaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Uint8Clamped:
+        setTypedArrayElement<Uint8ClampedAdaptor>(state, view, index, value);
+        break;
+    case TypedArrayType::Float32:
+        setTypedArrayElement<Float32Adaptor>(state, view, index, value);
+        break;
+    default:
+        ASSERT(type == TypedArrayType::Float64);
+        setTypedArrayElement<Float64Adaptor>(state, view, index, value);
+        break;
+    }
+}
+
+// quicken generic code into int32 or double variant while operand types are monomorphic
+template <typename CodeType>
+ALWAYS_INLINE void recordBinaryOperationTypeFeedback(CodeType* code, uint8_t observed, Opcode int32Opcode, Opcode doubleOpcode)
+{
+    uint8_t feedback = code->m_typeFeedback | observed;
+    if (UNLIKELY(feedback != code->m_typeFeedback)) {
+        code->m_typeFeedback = feedback;
+        if (feedback == BinaryOperationTypeFeedbackInt32) {
+            code->changeOpcode(int32Opcode);
+        } else if (!(feedback & BinaryOperationTypeFeedbackOther)) {
+            code->changeOpcode(doubleOpcode);
+        }
+    }
+}
+
+#define RECORD_BINARY_OPERATION_TYPE_FEEDBACK(CodeName, observed) \
+    recordBinaryOperationTypeFeedback(code, observed, CodeName##Int32Opcode, CodeName##DoubleOpcode)
+
+// restore generic code and execute it. generic code records the mismatched types
+#define DEQUICKEN_BINARY_OPERATION(CodeName) \
+    code->changeOpcode(CodeName##Opcode);    \
+    JUMP_INSTRUCTION(CodeName);
+
+// fused compare and jump. JumpIfFalse placed right after the fused code gives the jump position
+#define COMPARE_AND_JUMP_IF_FALSE(BaseCodeName, result)                                           \
+    if (!code->m_isResultUnused) {                                                                \
+        registerFile[code->m_dstIndex] = Value(result);                                           \
+    }                                                                                             \
+    if (result) {                                                                                 \
+        programCounter += sizeof(BaseCodeName) + sizeof(JumpIfFalse);                             \
+    } else {                                                                                      \
+        programCounter = ((JumpIfFalse*)(programCounter + sizeof(BaseCodeName)))->m_jumpPosition; \
+    }                                                                                             \
+    NEXT_INSTRUCTION();
+
+#define DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(BaseCodeName, compare)                      \
+    DEFINE_OPCODE(BaseCodeName##AndJumpIfFalse)                                             \
+        :                                                                                   \
+    {                                                                                       \
+        BaseCodeName##AndJumpIfFalse* code = (BaseCodeName##AndJumpIfFalse*)programCounter; \
+        const Value& left = registerFile[code->m_srcIndex0];                                \
+        const Value& right = registerFile[code->m_srcIndex1];                               \
+        bool result = compare;                                                              \
+        COMPARE_AND_JUMP_IF_FALSE(BaseCodeName, result)                                     \
+    }
+
+// generic code records type feedback like BinaryLessThan does, and quickened ones fall back to it on mismatch
+#define DEFINE_QUICKENED_COMPARE_AND_JUMP_IF_FALSE_OPCODES(BaseCodeName, compare, op)                                  \
+    DEFINE_OPCODE(BaseCodeName##AndJumpIfFalse)                                                                        \
+        :                                                                                                              \
+    {                                                                                                                  \
+        BaseCodeName##AndJumpIfFalse* code = (BaseCodeName##AndJumpIfFalse*)programCounter;                            \
+        const Value& left = registerFile[code->m_srcIndex0];                                                           \
+        const Value& right = registerFile[code->m_srcIndex1];                                                          \
+        RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BaseCodeName##AndJumpIfFalse, binaryOperationTypeFeedback(left, right)); \
+        bool result = compare;                                                                                         \
+        COMPARE_AND_JUMP_IF_FALSE(BaseCodeName, result)                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    DEFINE_OPCODE(BaseCodeName##AndJumpIfFalseInt32)                                                                   \
+        :                                                                                                              \
+    {                                                                                                                  \
+        BaseCodeName##AndJumpIfFalseInt32* code = (BaseCodeName##AndJumpIfFalseInt32*)programCounter;                  \
+        const Value& left = registerFile[code->m_srcIndex0];                                                           \
+        const Value& right = registerFile[code->m_srcIndex1];                                                          \
+        if (LIKELY(left.isInt32() && right.isInt32())) {                                                               \
+            bool result = left.asInt32() op right.asInt32();                                                           \
+            COMPARE_AND_JUMP_IF_FALSE(BaseCodeName, result)                                                            \
+        }                                                                                                              \
+        DEQUICKEN_BINARY_OPERATION(BaseCodeName##AndJumpIfFalse);                                                      \
+    }                                                                                                                  \
+                                                                                                                       \
+    DEFINE_OPCODE(BaseCodeName##AndJumpIfFalseDouble)                                                                  \
+        :                                                                                                              \
+    {                                                                                                                  \
+        BaseCodeName##AndJumpIfFalseDouble* code = (BaseCodeName##AndJumpIfFalseDouble*)programCounter;                \
+        const Value& left = registerFile[code->m_srcIndex0];                                                           \
+        const Value& right = registerFile[code->m_srcIndex1];                                                          \
+        if (LIKELY(left.isNumber() && right.isNumber())) {                                                             \
+            bool result = left.asNumber() op right.asNumber();                                                         \
+            COMPARE_AND_JUMP_IF_FALSE(BaseCodeName, result)                                                            \
+        }                                                                                                              \
+        DEQUICKEN_BINARY_OPERATION(BaseCodeName##AndJumpIfFalse);                                                      \
+    }
+
 class ExecutionStateProgramCounterBinder {
 public:
     ExecutionStateProgramCounterBinder(ExecutionState& state, size_t* newAddress)
@@ -99,8 +269,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
 #define DEFINE_OPCODE(codeName) codeName##OpcodeLbl
 #define DEFINE_DEFAULT
+#if defined(BYTECODE_OPCODE_IN_ADDRESS)
 #define NEXT_INSTRUCTION() \
     goto*(((ByteCode*)programCounter)->m_opcodeInAddress);
+#else
+#define NEXT_INSTRUCTION() \
+    goto*(g_opcodeTable.m_table[((ByteCode*)programCounter)->m_opcode]);
+#endif
 #define JUMP_INSTRUCTION(opcode) \
     goto opcode##OpcodeLbl;
 
@@ -150,10 +325,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             GetGlobalVariable* code = (GetGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
             Context* ctx = state->context();
             GlobalObject* globalObject = state->context()->globalObject();
-            auto slot = code->m_slot;
+            auto slot = ctx->globalVariableAccessCacheSlot(code->m_slotIndex);
             auto idx = slot->m_lexicalIndexCache;
             bool isCacheWork = false;
 
@@ -183,10 +357,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             SetGlobalVariable* code = (SetGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
             Context* ctx = state->context();
             GlobalObject* globalObject = state->context()->globalObject();
-            auto slot = code->m_slot;
+            auto slot = ctx->globalVariableAccessCacheSlot(code->m_slotIndex);
             auto idx = slot->m_lexicalIndexCache;
 
             bool isCacheWork = false;
@@ -230,10 +403,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 } else {
                     ret = Value(Value::EncodeAsDouble, (double)a + (double)b);
                 }
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryPlus, BinaryOperationTypeFeedbackInt32);
             } else if (v0.isNumber() && v1.isNumber()) {
                 ret = Value(v0.asNumber() + v1.asNumber());
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryPlus, BinaryOperationTypeFeedbackNumber);
             } else {
                 ret = plusSlowCase(*state, v0, v1);
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryPlus, BinaryOperationTypeFeedbackOther);
             }
             registerFile[code->m_dstIndex] = ret;
             ADD_PROGRAM_COUNTER(BinaryPlus);
@@ -257,7 +433,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 } else {
                     ret = Value(Value::EncodeAsDouble, (double)a - (double)b);
                 }
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryMinus, BinaryOperationTypeFeedbackInt32);
             } else {
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryMinus, binaryOperationTypeFeedback(left, right));
                 ret = Value(left.toNumber(*state) - right.toNumber(*state));
             }
             registerFile[code->m_dstIndex] = ret;
@@ -286,7 +464,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                         ret = Value(Value::EncodeAsDouble, a * (double)b);
                     }
                 }
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryMultiply, BinaryOperationTypeFeedbackInt32);
             } else {
+                RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryMultiply, binaryOperationTypeFeedback(left, right));
                 auto first = left.toNumber(*state);
                 auto second = right.toNumber(*state);
                 ret = Value(Value::EncodeAsDouble, first * second);
@@ -357,6 +537,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BinaryLessThan* code = (BinaryLessThan*)programCounter;
             const Value& left = registerFile[code->m_srcIndex0];
             const Value& right = registerFile[code->m_srcIndex1];
+            RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryLessThan, binaryOperationTypeFeedback(left, right));
             registerFile[code->m_dstIndex] = Value(abstractRelationalComparison(*state, left, right, true));
             ADD_PROGRAM_COUNTER(BinaryLessThan);
             NEXT_INSTRUCTION();
@@ -368,6 +549,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BinaryLessThanOrEqual* code = (BinaryLessThanOrEqual*)programCounter;
             const Value& left = registerFile[code->m_srcIndex0];
             const Value& right = registerFile[code->m_srcIndex1];
+            RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryLessThanOrEqual, binaryOperationTypeFeedback(left, right));
             registerFile[code->m_dstIndex] = Value(abstractRelationalComparisonOrEqual(*state, left, right, true));
             ADD_PROGRAM_COUNTER(BinaryLessThanOrEqual);
             NEXT_INSTRUCTION();
@@ -379,6 +561,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BinaryGreaterThan* code = (BinaryGreaterThan*)programCounter;
             const Value& left = registerFile[code->m_srcIndex0];
             const Value& right = registerFile[code->m_srcIndex1];
+            RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryGreaterThan, binaryOperationTypeFeedback(left, right));
             registerFile[code->m_dstIndex] = Value(abstractRelationalComparison(*state, right, left, false));
             ADD_PROGRAM_COUNTER(BinaryGreaterThan);
             NEXT_INSTRUCTION();
@@ -390,6 +573,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BinaryGreaterThanOrEqual* code = (BinaryGreaterThanOrEqual*)programCounter;
             const Value& left = registerFile[code->m_srcIndex0];
             const Value& right = registerFile[code->m_srcIndex1];
+            RECORD_BINARY_OPERATION_TYPE_FEEDBACK(BinaryGreaterThanOrEqual, binaryOperationTypeFeedback(left, right));
             registerFile[code->m_dstIndex] = Value(abstractRelationalComparisonOrEqual(*state, right, left, false));
             ADD_PROGRAM_COUNTER(BinaryGreaterThanOrEqual);
             NEXT_INSTRUCTION();
@@ -467,7 +651,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 if (LIKELY(arr->isFastModeArray())) {
                     uint32_t idx = property.tryToUseAsArrayIndex(*state);
                     if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < arr->getArrayLength(*state))) {
-                        const Value& v = arr->m_fastModeData[idx];
+                        Value v = arr->fastModeArrayValue(idx);
                         if (LIKELY(!v.isEmpty())) {
                             registerFile[code->m_storeRegisterIndex] = v;
                             ADD_PROGRAM_COUNTER(GetObject);
@@ -475,6 +659,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                         }
                     }
                 }
+            } else if (willBeObject.isObject() && code->m_elementInlineCache && v->hasTag(code->m_elementInlineCache->m_cachedTag)) {
+                ArrayBufferView* view = (ArrayBufferView*)v;
+                if (LIKELY(property.isUInt32() && property.asUInt32() < view->arrayLength())) {
+                    registerFile[code->m_storeRegisterIndex] = getTypedArrayElement(view, code->m_elementInlineCache->m_typedArrayType, property.asUInt32());
+                    ADD_PROGRAM_COUNTER(GetObject);
+                    NEXT_INSTRUCTION();
+                }
             }
             JUMP_INSTRUCTION(GetObjectOpcodeSlowCase);
         }
@@ -499,11 +690,19 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                                 JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
                             }
                         }
-                        arr->m_fastModeData[idx] = registerFile[code->m_loadRegisterIndex];
+                        arr->setFastModeArrayValue(idx, registerFile[code->m_loadRegisterIndex]);
                         ADD_PROGRAM_COUNTER(SetObjectOperation);
                         NEXT_INSTRUCTION();
                     }
                 }
+            } else if (willBeObject.isObject() && code->m_elementInlineCache && willBeObject.asPointerValue()->hasTag(code->m_elementInlineCache->m_cachedTag)) {
+                ArrayBufferView* view = (ArrayBufferView*)willBeObject.asPointerValue();
+                const Value& value = registerFile[code->m_loadRegisterIndex];
+                if (LIKELY(property.isUInt32() && property.asUInt32() < view->arrayLength() && value.isNumber())) {
+                    setTypedArrayElement(*state, view, code->m_elementInlineCache->m_typedArrayType, property.asUInt32(), value);
+                    ADD_PROGRAM_COUNTER(SetObjectOperation);
+                    NEXT_INSTRUCTION();
+                }
             }
             JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
         }
@@ -625,7 +824,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, errorMessage_NOT_Callable);
             }
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            registerFile[code->m_resultIndex] = callFunctionWithCallTargetCache(*state, code, callee.asPointerValue(), Value(), &registerFile[code->m_argumentsStartIndex], byteCodeBlock);
 
             ADD_PROGRAM_COUNTER(CallFunction);
             NEXT_INSTRUCTION();
@@ -645,7 +844,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, errorMessage_NOT_Callable);
             }
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            registerFile[code->m_resultIndex] = callFunctionWithCallTargetCache(*state, code, callee.asPointerValue(), receiver, &registerFile[code->m_argumentsStartIndex], byteCodeBlock);
 
             ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
             NEXT_INSTRUCTION();
@@ -818,7 +1017,6 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             InitializeGlobalVariable* code = (InitializeGlobalVariable*)programCounter;
-            ASSERT(byteCodeBlock->m_codeBlock->context() == state->context());
             initializeGlobalVariable(*state, code, registerFile[code->m_registerIndex]);
             ADD_PROGRAM_COUNTER(InitializeGlobalVariable);
             NEXT_INSTRUCTION();
@@ -900,7 +1098,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             GetObject* code = (GetObject*)programCounter;
-            getObjectOpcodeSlowCase(*state, code, registerFile);
+            getObjectOpcodeSlowCase(*state, code, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(GetObject);
             NEXT_INSTRUCTION();
         }
@@ -909,7 +1107,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             SetObjectOperation* code = (SetObjectOperation*)programCounter;
-            setObjectOpcodeSlowCase(*state, code, registerFile);
+            setObjectOpcodeSlowCase(*state, code, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(SetObjectOperation);
             NEXT_INSTRUCTION();
         }
@@ -918,7 +1116,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             LoadByName* code = (LoadByName*)programCounter;
-            registerFile[code->m_registerIndex] = loadByName(*state, state->lexicalEnvironment(), code->m_name);
+            registerFile[code->m_registerIndex] = loadByNameWithInlineCache(*state, code, byteCodeBlock);
             ADD_PROGRAM_COUNTER(LoadByName);
             NEXT_INSTRUCTION();
         }
@@ -927,7 +1125,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             StoreByName* code = (StoreByName*)programCounter;
-            storeByName(*state, state->lexicalEnvironment(), code->m_name, registerFile[code->m_registerIndex]);
+            storeByNameWithInlineCache(*state, code, registerFile[code->m_registerIndex], byteCodeBlock);
             ADD_PROGRAM_COUNTER(StoreByName);
             NEXT_INSTRUCTION();
         }
@@ -945,11 +1143,50 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             CreateObject* code = (CreateObject*)programCounter;
-            registerFile[code->m_registerIndex] = new Object(*state);
+            if (UNLIKELY(!code->m_allocationSite)) {
+                code->m_allocationSite = new ObjectAllocationSite();
+                byteCodeBlock->m_literalData.push_back(code->m_allocationSite);
+            }
+            registerFile[code->m_registerIndex] = code->m_allocationSite->allocate(*state);
             ADD_PROGRAM_COUNTER(CreateObject);
             NEXT_INSTRUCTION();
         }
 
+        DEFINE_OPCODE(CreateObjectWithStructure)
+            :
+        {
+            CreateObjectWithStructure* code = (CreateObjectWithStructure*)programCounter;
+            if (LIKELY(code->m_structure != nullptr)) {
+                registerFile[code->m_registerIndex] = Object::createWithStructure(*state, code->m_structure);
+            } else {
+                registerFile[code->m_registerIndex] = Object::createWithInlineSlots(*state, code->m_propertyCount);
+            }
+            ADD_PROGRAM_COUNTER(CreateObjectWithStructure);
+            NEXT_INSTRUCTION();
+        }
+
+        DEFINE_OPCODE(InitializeObjectLiteralProperty)
+            :
+        {
+            InitializeObjectLiteralProperty* code = (InitializeObjectLiteralProperty*)programCounter;
+            Object* obj = registerFile[code->m_objectRegisterIndex].asObject();
+            ObjectStructure* structure = obj->structure();
+            if (LIKELY(code->m_slotIndex < structure->propertyCount())) {
+                // object is created with structure of the literal
+                obj->writeDataSlot(code->m_slotIndex, structure->readProperty(code->m_slotIndex).m_descriptor, registerFile[code->m_loadRegisterIndex]);
+            } else {
+                obj->defineOwnProperty(*state, ObjectPropertyName(code->m_propertyName), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndex], ObjectPropertyDescriptor::AllPresent));
+            }
+            if (code->m_createObjectCodePosition != SIZE_MAX) {
+                CreateObjectWithStructure* createCode = (CreateObjectWithStructure*)(byteCodeBlock->m_code.data() + code->m_createObjectCodePosition);
+                if (UNLIKELY(createCode->m_structure != obj->structure())) {
+                    updateObjectLiteralStructure(obj, createCode, byteCodeBlock);
+                }
+            }
+            ADD_PROGRAM_COUNTER(InitializeObjectLiteralProperty);
+            NEXT_INSTRUCTION();
+        }
+
         DEFINE_OPCODE(CreateArray)
             :
         {
@@ -1154,7 +1391,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BinaryInOperation* code = (BinaryInOperation*)programCounter;
             const Value& left = registerFile[code->m_srcIndex0];
             const Value& right = registerFile[code->m_srcIndex1];
-            bool result = binaryInOperation(*state, left, right);
+            bool result = binaryInOperation(*state, code, left, right, byteCodeBlock);
             registerFile[code->m_dstIndex] = Value(result);
             ADD_PROGRAM_COUNTER(BinaryInOperation);
             NEXT_INSTRUCTION();
@@ -1164,7 +1401,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             BinaryInstanceOfOperation* code = (BinaryInstanceOfOperation*)programCounter;
-            instanceOfOperation(*state, code, registerFile);
+            instanceOfOperation(*state, code, registerFile, byteCodeBlock);
             ADD_PROGRAM_COUNTER(BinaryInstanceOfOperation);
             NEXT_INSTRUCTION();
         }
@@ -1314,6 +1551,282 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             NEXT_INSTRUCTION();
         }
 
+        DEFINE_OPCODE(GetObjectPreComputedCaseAndCall)
+            :
+        {
+            GetObjectPreComputedCaseAndCall* code = (GetObjectPreComputedCaseAndCall*)programCounter;
+            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+            Object* obj;
+            if (LIKELY(willBeObject.isObject())) {
+                obj = willBeObject.asObject();
+            } else {
+                obj = fastToObject(*state, willBeObject);
+            }
+            registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(*state, obj, willBeObject, code, byteCodeBlock);
+            ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
+            JUMP_INSTRUCTION(CallFunctionWithReceiver);
+        }
+
+        DEFINE_OPCODE(LoadLiteralAndBinaryPlus)
+            :
+        {
+            LoadLiteralAndBinaryPlus* code = (LoadLiteralAndBinaryPlus*)programCounter;
+            registerFile[code->m_registerIndex] = code->m_value;
+            ADD_PROGRAM_COUNTER(LoadLiteral);
+            JUMP_INSTRUCTION(BinaryPlus);
+        }
+
+        DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(BinaryEqual, left.abstractEqualsTo(*state, right))
+        DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(BinaryNotEqual, !left.abstractEqualsTo(*state, right))
+        DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(BinaryStrictEqual, left.equalsTo(*state, right))
+        DEFINE_COMPARE_AND_JUMP_IF_FALSE_OPCODE(BinaryNotStrictEqual, !left.equalsTo(*state, right))
+        DEFINE_QUICKENED_COMPARE_AND_JUMP_IF_FALSE_OPCODES(BinaryLessThan, abstractRelationalComparison(*state, left, right, true), <)
+        DEFINE_QUICKENED_COMPARE_AND_JUMP_IF_FALSE_OPCODES(BinaryLessThanOrEqual, abstractRelationalComparisonOrEqual(*state, left, right, true), <=)
+        DEFINE_QUICKENED_COMPARE_AND_JUMP_IF_FALSE_OPCODES(BinaryGreaterThan, abstractRelationalComparison(*state, right, left, false), >)
+        DEFINE_QUICKENED_COMPARE_AND_JUMP_IF_FALSE_OPCODES(BinaryGreaterThanOrEqual, abstractRelationalComparisonOrEqual(*state, right, left, false), >=)
+
+        DEFINE_OPCODE(IncrementAndJumpToRelation)
+            :
+        {
+            IncrementAndJumpToRelation* code = (IncrementAndJumpToRelation*)programCounter;
+            registerFile[code->m_dstIndex] = incrementOperation(*state, registerFile[code->m_srcIndex]);
+            programCounter = ((Jump*)(programCounter + sizeof(Increment)))->m_jumpPosition;
+            JUMP_INSTRUCTION(JumpIfRelation);
+        }
+
+        DEFINE_OPCODE(DecrementAndJumpToRelation)
+            :
+        {
+            DecrementAndJumpToRelation* code = (DecrementAndJumpToRelation*)programCounter;
+            registerFile[code->m_dstIndex] = decrementOperation(*state, registerFile[code->m_srcIndex]);
+            programCounter = ((Jump*)(programCounter + sizeof(Decrement)))->m_jumpPosition;
+            JUMP_INSTRUCTION(JumpIfRelation);
+        }
+
+        DEFINE_OPCODE(BinaryPlusInt32)
+            :
+        {
+            BinaryPlusInt32* code = (BinaryPlusInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                int32_t a = left.asInt32();
+                int32_t b = right.asInt32();
+                int32_t c;
+                bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::add(a, b, c);
+                if (LIKELY(result)) {
+                    registerFile[code->m_dstIndex] = Value(c);
+                } else {
+                    registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, (double)a + (double)b);
+                }
+                ADD_PROGRAM_COUNTER(BinaryPlus);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryPlus);
+        }
+
+        DEFINE_OPCODE(BinaryPlusDouble)
+            :
+        {
+            BinaryPlusDouble* code = (BinaryPlusDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() + right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryPlus);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryPlus);
+        }
+
+        DEFINE_OPCODE(BinaryMinusInt32)
+            :
+        {
+            BinaryMinusInt32* code = (BinaryMinusInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                int32_t a = left.asInt32();
+                int32_t b = right.asInt32();
+                int32_t c;
+                bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::sub(a, b, c);
+                if (LIKELY(result)) {
+                    registerFile[code->m_dstIndex] = Value(c);
+                } else {
+                    registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, (double)a - (double)b);
+                }
+                ADD_PROGRAM_COUNTER(BinaryMinus);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryMinus);
+        }
+
+        DEFINE_OPCODE(BinaryMinusDouble)
+            :
+        {
+            BinaryMinusDouble* code = (BinaryMinusDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() - right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryMinus);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryMinus);
+        }
+
+        DEFINE_OPCODE(BinaryMultiplyInt32)
+            :
+        {
+            BinaryMultiplyInt32* code = (BinaryMultiplyInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                int32_t a = left.asInt32();
+                int32_t b = right.asInt32();
+                if (UNLIKELY((!a || !b) && (a >> 31 || b >> 31))) { // -1 * 0 should be treated as -0, not +0
+                    registerFile[code->m_dstIndex] = Value(left.asNumber() * right.asNumber());
+                } else {
+                    int32_t c;
+                    bool result = ArithmeticOperations<int32_t, int32_t, int32_t>::multiply(a, b, c);
+                    if (LIKELY(result)) {
+                        registerFile[code->m_dstIndex] = Value(c);
+                    } else {
+                        registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, a * (double)b);
+                    }
+                }
+                ADD_PROGRAM_COUNTER(BinaryMultiply);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryMultiply);
+        }
+
+        DEFINE_OPCODE(BinaryMultiplyDouble)
+            :
+        {
+            BinaryMultiplyDouble* code = (BinaryMultiplyDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(Value::EncodeAsDouble, left.asNumber() * right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryMultiply);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryMultiply);
+        }
+
+        DEFINE_OPCODE(BinaryLessThanInt32)
+            :
+        {
+            BinaryLessThanInt32* code = (BinaryLessThanInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                registerFile[code->m_dstIndex] = Value(left.asInt32() < right.asInt32());
+                ADD_PROGRAM_COUNTER(BinaryLessThan);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryLessThan);
+        }
+
+        DEFINE_OPCODE(BinaryLessThanDouble)
+            :
+        {
+            BinaryLessThanDouble* code = (BinaryLessThanDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() < right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryLessThan);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryLessThan);
+        }
+
+        DEFINE_OPCODE(BinaryLessThanOrEqualInt32)
+            :
+        {
+            BinaryLessThanOrEqualInt32* code = (BinaryLessThanOrEqualInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                registerFile[code->m_dstIndex] = Value(left.asInt32() <= right.asInt32());
+                ADD_PROGRAM_COUNTER(BinaryLessThanOrEqual);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryLessThanOrEqual);
+        }
+
+        DEFINE_OPCODE(BinaryLessThanOrEqualDouble)
+            :
+        {
+            BinaryLessThanOrEqualDouble* code = (BinaryLessThanOrEqualDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() <= right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryLessThanOrEqual);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryLessThanOrEqual);
+        }
+
+        DEFINE_OPCODE(BinaryGreaterThanInt32)
+            :
+        {
+            BinaryGreaterThanInt32* code = (BinaryGreaterThanInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                registerFile[code->m_dstIndex] = Value(left.asInt32() > right.asInt32());
+                ADD_PROGRAM_COUNTER(BinaryGreaterThan);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryGreaterThan);
+        }
+
+        DEFINE_OPCODE(BinaryGreaterThanDouble)
+            :
+        {
+            BinaryGreaterThanDouble* code = (BinaryGreaterThanDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() > right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryGreaterThan);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryGreaterThan);
+        }
+
+        DEFINE_OPCODE(BinaryGreaterThanOrEqualInt32)
+            :
+        {
+            BinaryGreaterThanOrEqualInt32* code = (BinaryGreaterThanOrEqualInt32*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isInt32() && right.isInt32())) {
+                registerFile[code->m_dstIndex] = Value(left.asInt32() >= right.asInt32());
+                ADD_PROGRAM_COUNTER(BinaryGreaterThanOrEqual);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryGreaterThanOrEqual);
+        }
+
+        DEFINE_OPCODE(BinaryGreaterThanOrEqualDouble)
+            :
+        {
+            BinaryGreaterThanOrEqualDouble* code = (BinaryGreaterThanOrEqualDouble*)programCounter;
+            const Value& left = registerFile[code->m_srcIndex0];
+            const Value& right = registerFile[code->m_srcIndex1];
+            if (LIKELY(left.isNumber() && right.isNumber())) {
+                registerFile[code->m_dstIndex] = Value(left.asNumber() >= right.asNumber());
+                ADD_PROGRAM_COUNTER(BinaryGreaterThanOrEqual);
+                NEXT_INSTRUCTION();
+            }
+            DEQUICKEN_BINARY_OPERATION(BinaryGreaterThanOrEqual);
+        }
+
         DEFINE_DEFAULT
     }
 
@@ -1385,6 +1898,305 @@ NEVER_INLINE void ByteCodeInterpreter::storeByName(ExecutionState& state, Lexica
     o->setThrowsExceptionWhenStrictMode(state, name, value, o);
 }
 
+NEVER_INLINE Value ByteCodeInterpreter::loadByNameWithInlineCache(ExecutionState& state, LoadByName* code, ByteCodeBlock* block)
+{
+    ByNameInlineCache* inlineCache = code->m_inlineCache;
+    if (inlineCache) {
+        Object* holder = nullptr;
+        EnvironmentRecord* record = testByNameInlineCache(state, inlineCache, code->m_name, holder);
+        if (record) {
+            // cache hit!
+            switch (inlineCache->m_items[inlineCache->m_itemCount - 1].m_kind) {
+            case ByNameInlineCacheItem::DeclarativeIndexed:
+            case ByNameInlineCacheItem::Function:
+                return ((DeclarativeEnvironmentRecord*)record)->getHeapValueByIndex(state, inlineCache->m_index);
+            case ByNameInlineCacheItem::Object:
+                return holder->getOwnPropertyUtilForObject(state, inlineCache->m_index, ((ObjectEnvironmentRecord*)record)->bindingObject());
+            case ByNameInlineCacheItem::GlobalDeclarative: {
+                Value v = ((GlobalEnvironmentRecord*)record)->m_globalDeclarativeStorage->at(inlineCache->m_index);
+                if (LIKELY(!v.isEmpty())) {
+                    return v;
+                }
+                // TDZ error is thrown by loadByName
+                break;
+            }
+            case ByNameInlineCacheItem::GlobalObject:
+                return holder->getOwnPropertyUtilForObject(state, inlineCache->m_index, holder);
+            default:
+                break;
+            }
+        }
+    }
+
+    if (!inlineCache || inlineCache->m_missCount < 16) {
+        fillByNameInlineCache(state, code->m_name, false, code->m_inlineCache, block);
+    }
+    return loadByName(state, state.lexicalEnvironment(), code->m_name);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::storeByNameWithInlineCache(ExecutionState& state, StoreByName* code, const Value& value, ByteCodeBlock* block)
+{
+    ByNameInlineCache* inlineCache = code->m_inlineCache;
+    if (inlineCache) {
+        Object* holder = nullptr;
+        EnvironmentRecord* record = testByNameInlineCache(state, inlineCache, code->m_name, holder);
+        if (record) {
+            // cache hit!
+            switch (inlineCache->m_items[inlineCache->m_itemCount - 1].m_kind) {
+            case ByNameInlineCacheItem::DeclarativeIndexed:
+            case ByNameInlineCacheItem::Function:
+                record->setMutableBindingByBindingSlot(state, EnvironmentRecord::BindingSlot(record, inlineCache->m_index, inlineCache->m_isLexicallyDeclared), code->m_name, value);
+                return;
+            case ByNameInlineCacheItem::Object:
+            case ByNameInlineCacheItem::GlobalObject:
+                // only own writable data properties are cached for store
+                holder->m_values[inlineCache->m_index] = value;
+                return;
+            case ByNameInlineCacheItem::GlobalDeclarative: {
+                GlobalEnvironmentRecord* globalRecord = (GlobalEnvironmentRecord*)record;
+                if (LIKELY(!globalRecord->m_globalDeclarativeStorage->at(inlineCache->m_index).isEmpty() && globalRecord->m_globalDeclarativeRecord->at(inlineCache->m_index).m_isMutable)) {
+                    globalRecord->m_globalDeclarativeStorage->at(inlineCache->m_index) = value;
+                    return;
+                }
+                // TDZ and const errors are thrown by storeByName
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    if (!inlineCache || inlineCache->m_missCount < 16) {
+        fillByNameInlineCache(state, code->m_name, true, code->m_inlineCache, block);
+    }
+    storeByName(state, state.lexicalEnvironment(), code->m_name, value);
+}
+
+ALWAYS_INLINE EnvironmentRecord* ByteCodeInterpreter::testByNameInlineCache(ExecutionState& state, ByNameInlineCache* inlineCache, const AtomicString& name, Object*& holder)
+{
+    LexicalEnvironment* env = state.lexicalEnvironment();
+    const size_t itemCount = inlineCache->m_itemCount;
+    for (size_t i = 0; i < itemCount; i++) {
+        if (UNLIKELY(!env)) {
+            return nullptr;
+        }
+
+        EnvironmentRecord* record = env->record();
+        const ByNameInlineCacheItem& item = inlineCache->m_items[i];
+        if (*((size_t*)record) != item.m_recordTag) {
+            return nullptr;
+        }
+
+        switch (item.m_kind) {
+        case ByNameInlineCacheItem::DeclarativeIndexed:
+            if (((DeclarativeEnvironmentRecordIndexed*)record)->m_blockInfo != item.m_key) {
+                return nullptr;
+            }
+            break;
+        case ByNameInlineCacheItem::Function:
+            if (((FunctionEnvironmentRecord*)record)->functionObject()->codeBlock() != item.m_key) {
+                return nullptr;
+            }
+            break;
+        case ByNameInlineCacheItem::NotIndexed:
+            if (record->hasBinding(state, name).m_index != SIZE_MAX) {
+                return nullptr;
+            }
+            break;
+        case ByNameInlineCacheItem::Object: {
+            ObjectStructure** cachedHiddenClassChain = (ObjectStructure**)item.m_key;
+            Object* o = ((ObjectEnvironmentRecord*)record)->bindingObject();
+            for (size_t j = 0; j < item.m_keyLength; j++) {
+                if (!o || o->structure() != cachedHiddenClassChain[j] || UNLIKELY(!o->isInlineCacheable())) {
+                    return nullptr;
+                }
+                if (j == inlineCache->m_holderDepth) {
+                    holder = o;
+                }
+                o = o->Object::getPrototypeObject(state);
+            }
+            if (o) {
+                return nullptr;
+            }
+            break;
+        }
+        case ByNameInlineCacheItem::GlobalDeclarative:
+            if (((GlobalEnvironmentRecord*)record)->m_globalObject != item.m_key) {
+                return nullptr;
+            }
+            break;
+        case ByNameInlineCacheItem::GlobalObject: {
+            GlobalEnvironmentRecord* globalRecord = (GlobalEnvironmentRecord*)record;
+            if (globalRecord->m_globalObject != item.m_key || globalRecord->m_globalObject->structure() != item.m_extraKey
+                || globalRecord->m_globalDeclarativeRecord->size() != item.m_keyLength) {
+                return nullptr;
+            }
+            holder = globalRecord->m_globalObject;
+            break;
+        }
+        }
+
+        if (i + 1 == itemCount) {
+            return record;
+        }
+        env = env->outerEnvironment();
+    }
+    return nullptr;
+}
+
+NEVER_INLINE void ByteCodeInterpreter::fillByNameInlineCache(ExecutionState& state, const AtomicString& name, bool isStore, ByNameInlineCache*& inlineCache, ByteCodeBlock* block)
+{
+    auto& currentCodeSizeTotal = state.context()->vmInstance()->compiledByteCodeSize();
+    if (!inlineCache) {
+        inlineCache = new ByNameInlineCache();
+        block->m_inlineCacheDataSize += sizeof(ByNameInlineCache);
+        currentCodeSizeTotal += sizeof(ByNameInlineCache);
+        block->m_literalData.push_back(inlineCache);
+    }
+    // every attempt is counted, so sites which can't be cached stop trying too
+    inlineCache->m_missCount++;
+
+    VectorWithInlineStorage<8, ByNameInlineCacheItem, std::allocator<ByNameInlineCacheItem>> items;
+    size_t index = SIZE_MAX;
+    size_t holderDepth = 0;
+    bool isLexicallyDeclared = false;
+
+    LexicalEnvironment* env = state.lexicalEnvironment();
+    while (env && index == SIZE_MAX) {
+        EnvironmentRecord* record = env->record();
+        ByNameInlineCacheItem item;
+        item.m_recordTag = *((size_t*)record);
+        item.m_key = item.m_extraKey = nullptr;
+        item.m_keyLength = 0;
+
+        if (record->isDeclarativeEnvironmentRecord()) {
+            DeclarativeEnvironmentRecord* declarativeRecord = record->asDeclarativeEnvironmentRecord();
+            bool canHaveCachedBinding = true;
+            if (declarativeRecord->isDeclarativeEnvironmentRecordIndexed()) {
+                item.m_kind = ByNameInlineCacheItem::DeclarativeIndexed;
+                item.m_key = ((DeclarativeEnvironmentRecordIndexed*)declarativeRecord)->m_blockInfo;
+            } else if (declarativeRecord->isDeclarativeEnvironmentRecordNotIndexed()) {
+                item.m_kind = ByNameInlineCacheItem::NotIndexed;
+                canHaveCachedBinding = false;
+            } else if (declarativeRecord->isFunctionEnvironmentRecord()) {
+                FunctionEnvironmentRecord* functionRecord = declarativeRecord->asFunctionEnvironmentRecord();
+                if (functionRecord->isFunctionEnvironmentRecordOnHeap() || functionRecord->isFunctionEnvironmentRecordOnStack()) {
+                    item.m_kind = ByNameInlineCacheItem::Function;
+                    item.m_key = functionRecord->functionObject()->codeBlock();
+                } else if (functionRecord->isFunctionEnvironmentRecordNotIndexed() && !functionRecord->functionObject()->codeBlock()->needsVirtualIDOperation()) {
+                    item.m_kind = ByNameInlineCacheItem::NotIndexed;
+                    canHaveCachedBinding = false;
+                } else {
+                    return;
+                }
+            } else {
+                return;
+            }
+
+            auto slot = record->hasBinding(state, name);
+            if (slot.m_index != SIZE_MAX) {
+                if (!canHaveCachedBinding) {
+                    return;
+                }
+                index = slot.m_index;
+                isLexicallyDeclared = slot.m_isLexicallyDeclared;
+            }
+        } else if (record->isObjectEnvironmentRecord()) {
+            Object* bindingObject = record->asObjectEnvironmentRecord()->bindingObject();
+            VectorWithInlineStorage<8, ObjectStructure*, std::allocator<ObjectStructure*>> cachedHiddenClassChain;
+            ObjectStructurePropertyName unscopables(state.context()->vmInstance()->globalSymbols().unscopables);
+            Object* o = bindingObject;
+            while (o) {
+                if (UNLIKELY(!o->isInlineCacheable())) {
+                    return;
+                }
+                ObjectStructure* structure = o->structure();
+                // @@unscopables should be looked up when the binding is found
+                if (structure->findProperty(unscopables).first != SIZE_MAX) {
+                    return;
+                }
+                if (index == SIZE_MAX) {
+                    auto findResult = structure->findProperty(name);
+                    if (findResult.first != SIZE_MAX) {
+                        index = findResult.first;
+                        holderDepth = cachedHiddenClassChain.size();
+                        if (isStore) {
+                            const auto& desc = structure->readProperty(findResult.first).m_descriptor;
+                            if (holderDepth != 0 || !desc.isPlainDataProperty() || !desc.isWritable() || desc.hasDoubleRepresentation()) {
+                                return;
+                            }
+                        }
+                    }
+                }
+                cachedHiddenClassChain.push_back(structure);
+                o = o->Object::getPrototypeObject(state);
+            }
+
+            // exotic objects can have properties which are not in ObjectStructure
+            if ((index != SIZE_MAX) != (bool)bindingObject->hasProperty(state, ObjectPropertyName(name))) {
+                return;
+            }
+
+            item.m_kind = ByNameInlineCacheItem::Object;
+            item.m_keyLength = cachedHiddenClassChain.size();
+            item.m_key = GC_MALLOC(sizeof(ObjectStructure*) * item.m_keyLength);
+            memcpy(item.m_key, cachedHiddenClassChain.data(), sizeof(ObjectStructure*) * item.m_keyLength);
+        } else if (record->isGlobalEnvironmentRecord()) {
+            GlobalEnvironmentRecord* globalRecord = record->asGlobalEnvironmentRecord();
+            item.m_key = globalRecord->m_globalObject;
+
+            auto& globalDeclarativeRecord = *globalRecord->m_globalDeclarativeRecord;
+            for (size_t i = 0; i < globalDeclarativeRecord.size(); i++) {
+                if (globalDeclarativeRecord[i].m_name == name) {
+                    item.m_kind = ByNameInlineCacheItem::GlobalDeclarative;
+                    index = i;
+                    break;
+                }
+            }
+
+            if (index == SIZE_MAX) {
+                if (UNLIKELY(!globalRecord->m_globalObject->isInlineCacheable())) {
+                    return;
+                }
+                ObjectStructure* structure = globalRecord->m_globalObject->structure();
+                auto findResult = structure->findProperty(name);
+                if (findResult.first == SIZE_MAX) {
+                    return;
+                }
+                if (isStore) {
+                    const auto& desc = structure->readProperty(findResult.first).m_descriptor;
+                    if (!desc.isPlainDataProperty() || !desc.isWritable()) {
+                        return;
+                    }
+                }
+                item.m_kind = ByNameInlineCacheItem::GlobalObject;
+                item.m_extraKey = structure;
+                item.m_keyLength = globalDeclarativeRecord.size();
+                index = findResult.first;
+            }
+        } else {
+            return;
+        }
+
+        items.push_back(item);
+        env = env->outerEnvironment();
+    }
+
+    if (index == SIZE_MAX) {
+        return;
+    }
+
+    inlineCache->m_itemCount = items.size();
+    inlineCache->m_items = (ByNameInlineCacheItem*)GC_MALLOC(sizeof(ByNameInlineCacheItem) * items.size());
+    memcpy(inlineCache->m_items, items.data(), sizeof(ByNameInlineCacheItem) * items.size());
+    inlineCache->m_index = index;
+    inlineCache->m_holderDepth = holderDepth;
+    inlineCache->m_isLexicallyDeclared = isLexicallyDeclared;
+    block->m_inlineCacheDataSize += sizeof(ByNameInlineCacheItem) * items.size();
+    currentCodeSizeTotal += sizeof(ByNameInlineCacheItem) * items.size();
+}
+
 NEVER_INLINE void ByteCodeInterpreter::initializeByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool isLexicallyDeclaredName, const Value& value)
 {
     if (isLexicallyDeclaredName) {
@@ -1517,9 +2329,64 @@ NEVER_INLINE Value ByteCodeInterpreter::exponentialOperation(ExecutionState& sta
     return Value(pow(base, exp));
 }
 
-NEVER_INLINE void ByteCodeInterpreter::instanceOfOperation(ExecutionState& state, BinaryInstanceOfOperation* code, Value* registerFile)
+NEVER_INLINE void ByteCodeInterpreter::instanceOfOperation(ExecutionState& state, BinaryInstanceOfOperation* code, Value* registerFile, ByteCodeBlock* block)
 {
-    registerFile[code->m_dstIndex] = Value(registerFile[code->m_srcIndex0].instanceOf(state, registerFile[code->m_srcIndex1]));
+    const Value& O = registerFile[code->m_srcIndex0];
+    const Value& C = registerFile[code->m_srcIndex1];
+    auto inlineCache = code->m_inlineCache;
+
+    if (inlineCache && C.isObject()) {
+        Object* constructor = C.asObject();
+        if (constructor->structure() == inlineCache->m_cachedConstructorStructure && constructor->Object::getPrototypeObject(state) == inlineCache->m_cachedFunctionPrototype) {
+            // cache hit! this is OrdinaryHasInstance(C, O)
+            if (!O.isObject()) {
+                registerFile[code->m_dstIndex] = Value(false);
+                return;
+            }
+            Value P = constructor->getOwnPropertyUtilForObject(state, inlineCache->m_cachedPrototypeIndex, constructor);
+            if (!P.isObject()) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, errorMessage_InstanceOf_InvalidPrototypeProperty);
+            }
+            Value proto = O.asObject()->getPrototype(state);
+            while (!proto.isNull()) {
+                if (P == proto) {
+                    registerFile[code->m_dstIndex] = Value(true);
+                    return;
+                }
+                proto = proto.asObject()->getPrototype(state);
+            }
+            registerFile[code->m_dstIndex] = Value(false);
+            return;
+        }
+    }
+
+    bool result = O.instanceOf(state, C);
+
+    if (C.isObject() && (!inlineCache || inlineCache->m_missCount < 16)) {
+        Object* constructor = C.asObject();
+        FunctionObject* functionPrototype = state.context()->globalObject()->functionPrototype();
+        // @@hasInstance of Function.prototype is non-writable and non-configurable
+        // so it is enough to check that constructor inherits it directly
+        if (constructor->isFunctionObject() && !constructor->isBoundFunctionObject() && constructor->isInlineCacheable()
+            && constructor->Object::getPrototypeObject(state) == functionPrototype
+            && constructor->structure()->findProperty(state.context()->vmInstance()->globalSymbols().hasInstance).first == SIZE_MAX) {
+            auto findResult = constructor->structure()->findProperty(state.context()->staticStrings().prototype);
+            if (findResult.first != SIZE_MAX) {
+                if (!inlineCache) {
+                    inlineCache = code->m_inlineCache = new BinaryInstanceOfOperationInlineCache();
+                    block->m_inlineCacheDataSize += sizeof(BinaryInstanceOfOperationInlineCache);
+                    state.context()->vmInstance()->compiledByteCodeSize() += sizeof(BinaryInstanceOfOperationInlineCache);
+                    block->m_literalData.push_back(inlineCache);
+                }
+                inlineCache->m_missCount++;
+                inlineCache->m_cachedConstructorStructure = constructor->structure();
+                inlineCache->m_cachedFunctionPrototype = functionPrototype;
+                inlineCache->m_cachedPrototypeIndex = findResult.first;
+            }
+        }
+    }
+
+    registerFile[code->m_dstIndex] = Value(result);
 }
 
 NEVER_INLINE void ByteCodeInterpreter::templateOperation(ExecutionState& state, LexicalEnvironment* env, TemplateOperation* code, Value* registerFile)
@@ -1656,38 +2523,21 @@ ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(Execu
         auto inlineCache = code->m_inlineCache;
         const size_t cacheFillCount = inlineCache->m_cache.size();
         GetObjectInlineCacheData* cacheData = inlineCache->m_cache.data();
-        unsigned currentCacheIndex = 0;
-    TestCache:
-        for (; currentCacheIndex < cacheFillCount; currentCacheIndex++) {
+        ObjectStructure* structure = orgObj->structure();
+        for (size_t currentCacheIndex = 0; currentCacheIndex < cacheFillCount; currentCacheIndex++) {
             const GetObjectInlineCacheData& data = cacheData[currentCacheIndex];
-            const size_t cSiz = data.m_cachedhiddenClassChainLength - 1;
-            if (cSiz) {
-                obj = orgObj;
-                ObjectStructure** cachedHiddenClassChain = data.m_cachedhiddenClassChain;
-                size_t cachedIndex = data.m_cachedIndex;
-                for (size_t i = 0; i < cSiz; i++) {
-                    if (cachedHiddenClassChain[i] != obj->structure()) {
-                        currentCacheIndex++;
-                        goto TestCache;
-                    }
-                    Object* protoObject = obj->Object::getPrototypeObject(state);
-                    if (protoObject != nullptr) {
-                        obj = protoObject;
-                    } else {
-                        currentCacheIndex++;
-                        goto TestCache;
-                    }
-                }
-
-                if (LIKELY(cachedHiddenClassChain[cSiz] == obj->structure())) {
+            if (data.m_isPrototypeCase) {
+                GetObjectInlineCachePrototypeData* prototypeData = data.m_prototypeData;
+                if (prototypeData->m_receiverStructure == structure && LIKELY(prototypeData->m_validityCell->isValid())
+                    && orgObj->Object::getPrototypeObject(state) == prototypeData->m_prototype) {
                     if (LIKELY(data.m_cachedIndex != SIZE_MAX)) {
-                        return obj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
+                        return prototypeData->m_holder->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
                     } else {
                         return Value();
                     }
                 }
             } else {
-                if (LIKELY(data.m_cachedhiddenClass == orgObj->structure())) {
+                if (LIKELY(data.m_cachedhiddenClass == structure)) {
                     if (LIKELY(data.m_cachedIndex != SIZE_MAX)) {
                         return orgObj->getOwnPropertyUtilForObject(state, data.m_cachedIndex, receiver);
                     } else {
@@ -1707,13 +2557,13 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
         return Value(obj->asArrayObject()->getArrayLength(state));
     }
 
-    const int maxCacheMissCount = 16;
-    const int minCacheFillCount = 3;
+    const int maxCacheMissCount = PROPERTY_INLINE_CACHE_MAX_MISS_COUNT;
+    const int minCacheFillCount = PROPERTY_INLINE_CACHE_MIN_FILL_COUNT;
     const size_t maxCacheCount = 6;
 
     // cache miss.
     if (code->m_cacheMissCount > maxCacheMissCount) {
-        return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+        return getObjectPrecomputedCaseOperationMegamorphic(state, obj, receiver, code);
     }
 
     code->m_cacheMissCount++;
@@ -1744,8 +2594,18 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
 
     auto inlineCache = code->m_inlineCache;
 
+    // entries whose prototype chain is changed never hit again
+    for (size_t i = 0; i < inlineCache->m_cache.size();) {
+        const GetObjectInlineCacheData& data = inlineCache->m_cache[i];
+        if (data.m_isPrototypeCase && !data.m_prototypeData->m_validityCell->isValid()) {
+            inlineCache->m_cache.erase(i);
+        } else {
+            i++;
+        }
+    }
+
     if (inlineCache->m_cache.size() > maxCacheCount) {
-        return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+        return getObjectPrecomputedCaseOperationMegamorphic(state, obj, receiver, code);
     }
 
     Object* orgObj = obj;
@@ -1754,11 +2614,11 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
     currentCodeSizeTotal += sizeof(GetObjectInlineCacheData);
 
     auto& newItem = inlineCache->m_cache[0];
-    VectorWithInlineStorage<24, ObjectStructure*, std::allocator<ObjectStructure*>> cachedhiddenClassChain;
+    size_t chainLength = 0;
 
     while (true) {
         auto s = obj->structure();
-        cachedhiddenClassChain.push_back(s);
+        chainLength++;
         auto result = s->findProperty(code->m_propertyName);
 
         if (result.first != SIZE_MAX) {
@@ -1780,14 +2640,19 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
         }
     }
 
-    newItem.m_cachedhiddenClassChainLength = cachedhiddenClassChain.size();
-    if (newItem.m_cachedhiddenClassChainLength == 1) {
-        newItem.m_cachedhiddenClass = cachedhiddenClassChain[0];
+    if (chainLength == 1) {
+        newItem.m_cachedhiddenClass = orgObj->structure();
     } else {
-        block->m_inlineCacheDataSize += sizeof(size_t) * cachedhiddenClassChain.size();
-        currentCodeSizeTotal += sizeof(size_t) * cachedhiddenClassChain.size();
-        newItem.m_cachedhiddenClassChain = (ObjectStructure**)GC_MALLOC(sizeof(ObjectStructure*) * cachedhiddenClassChain.size());
-        memcpy(newItem.m_cachedhiddenClassChain, cachedhiddenClassChain.data(), sizeof(ObjectStructure*) * cachedhiddenClassChain.size());
+        block->m_inlineCacheDataSize += sizeof(GetObjectInlineCachePrototypeData);
+        currentCodeSizeTotal += sizeof(GetObjectInlineCachePrototypeData);
+        GetObjectInlineCachePrototypeData* prototypeData = new GetObjectInlineCachePrototypeData();
+        prototypeData->m_prototype = orgObj->Object::getPrototypeObject(state);
+        // creating cell can change structures of objects on the chain (but not their property indexes)
+        prototypeData->m_validityCell = prototypeData->m_prototype->ensurePrototypeValidityCell(state);
+        prototypeData->m_receiverStructure = orgObj->structure();
+        prototypeData->m_holder = newItem.m_cachedIndex != SIZE_MAX ? obj : nullptr;
+        newItem.m_prototypeData = prototypeData;
+        newItem.m_isPrototypeCase = true;
     }
 
     if (newItem.m_cachedIndex != SIZE_MAX) {
@@ -1797,6 +2662,57 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
     }
 }
 
+NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code)
+{
+    if (LIKELY(code->m_propertyName.hasAtomicString() && obj->isInlineCacheable())) {
+        ObjectStructure* structure = obj->structure();
+        String* propertyName = code->m_propertyName.asAtomicString().string();
+        PropertyAccessStubCache::GetEntry& entry = state.context()->vmInstance()->propertyAccessStubCache()->getEntry(structure, propertyName);
+
+        if (entry.m_structure == structure && entry.m_propertyName == propertyName) {
+            Object* holder = obj;
+            size_t i = 0;
+            for (; i < entry.m_prototypeChainLength; i++) {
+                holder = holder->Object::getPrototypeObject(state);
+                if (!holder || holder->structure() != entry.m_prototypeChain[i]) {
+                    break;
+                }
+            }
+            if (LIKELY(i == entry.m_prototypeChainLength)) {
+                // stub cache hit!
+                return holder->getOwnPropertyUtilForObject(state, entry.m_index, receiver);
+            }
+        }
+
+        ObjectStructure* prototypeChain[PropertyAccessStubCache::maxPrototypeChainLength];
+        size_t prototypeChainLength = 0;
+        Object* holder = obj;
+        while (true) {
+            auto result = holder->structure()->findProperty(code->m_propertyName);
+            if (result.first != SIZE_MAX) {
+                entry.m_structure = structure;
+                entry.m_propertyName = propertyName;
+                memcpy(entry.m_prototypeChain, prototypeChain, sizeof(ObjectStructure*) * prototypeChainLength);
+                entry.m_prototypeChainLength = prototypeChainLength;
+                entry.m_index = result.first;
+                return holder->getOwnPropertyUtilForObject(state, result.first, receiver);
+            }
+
+            if (prototypeChainLength == PropertyAccessStubCache::maxPrototypeChainLength) {
+                break;
+            }
+
+            holder = holder->Object::getPrototypeObject(state);
+            if (!holder || UNLIKELY(!holder->isInlineCacheable())) {
+                break;
+            }
+            prototypeChain[prototypeChainLength++] = holder->structure();
+        }
+    }
+
+    return obj->get(state, ObjectPropertyName(state, code->m_propertyName)).value(state, receiver);
+}
+
 ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(ExecutionState& state, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
     Object* obj;
@@ -1815,39 +2731,96 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
 
     auto inlineCache = code->m_inlineCache;
 
-    if (inlineCache) {
-        if (inlineCache->m_cachedhiddenClassChainLength == 1 && inlineCache->m_cachedHiddenClass == testItem) {
-            // cache hit!
-            obj->m_values[inlineCache->m_cachedIndex] = value;
-            return;
-        } else if (inlineCache->m_hiddenClassWillBe) {
-            const auto& cSiz = inlineCache->m_cachedhiddenClassChainLength;
-            bool miss = false;
-            for (size_t i = 0; i < cSiz - 1; i++) {
-                if (UNLIKELY(inlineCache->m_cachedHiddenClassChainData[i] != obj->structure())) {
-                    miss = true;
-                    break;
-                } else {
+    if (LIKELY(inlineCache != nullptr)) {
+        const size_t cacheFillCount = inlineCache->m_cache.size();
+        SetObjectInlineCacheData* cacheData = inlineCache->m_cache.data();
+        for (size_t currentCacheIndex = 0; currentCacheIndex < cacheFillCount; currentCacheIndex++) {
+            const SetObjectInlineCacheData& data = cacheData[currentCacheIndex];
+            if (!data.m_hiddenClassWillBe) {
+                if (data.m_cachedHiddenClass == testItem) {
+#if defined(ESCARGOT_64)
+                    if (data.m_isDoubleSlot) {
+                        if (UNLIKELY(!value.isNumber())) {
+                            // slow path generalizes the property
+                            break;
+                        }
+                        // cache hit!
+                        obj->m_values[data.m_cachedIndex] = SmallValue::fromUnboxedDouble(value.asNumber());
+                        return;
+                    }
+#endif
+                    // cache hit!
+                    obj->m_values[data.m_cachedIndex] = value;
+                    return;
+                }
+            } else if (data.m_cachedHiddenClassChainData[0] == testItem) {
+#if defined(ESCARGOT_64)
+                // the structure adds the property with double representation, so it is only for numbers
+                if (data.m_isDoubleSlot && !value.isNumber()) {
+                    continue;
+                }
+#endif
+                const auto& cSiz = data.m_cachedhiddenClassChainLength;
+                bool miss = false;
+                obj = originalObject;
+                for (size_t i = 1; i < cSiz; i++) {
                     Object* o = obj->Object::getPrototypeObject(state);
-                    if (UNLIKELY(!o)) {
+                    if (UNLIKELY(!o || data.m_cachedHiddenClassChainData[i] != o->structure())) {
                         miss = true;
                         break;
                     }
                     obj = o;
                 }
+                if (LIKELY(!miss)) {
+                    // cache hit!
+                    obj = originalObject;
+                    ASSERT(obj->structure()->inTransitionMode());
+#if defined(ESCARGOT_64)
+                    if (data.m_isDoubleSlot) {
+                        obj->appendValueSlot(SmallValue::fromUnboxedDouble(value.asNumber()), data.m_hiddenClassWillBe->propertyCount());
+                        obj->m_structure = data.m_hiddenClassWillBe;
+                        return;
+                    }
+#endif
+                    obj->appendValueSlot(value, data.m_hiddenClassWillBe->propertyCount());
+                    obj->m_structure = data.m_hiddenClassWillBe;
+                    return;
+                }
             }
-            if (LIKELY(!miss) && inlineCache->m_cachedHiddenClassChainData[cSiz - 1] == obj->structure()) {
-                // cache hit!
-                obj = originalObject;
-                ASSERT(obj->structure()->inTransitionMode());
-                obj->m_values.push_back(value, inlineCache->m_hiddenClassWillBe->propertyCount());
-                obj->m_structure = inlineCache->m_hiddenClassWillBe;
+        }
+    }
+
+    setObjectPreComputedCaseOperationCacheMiss(state, originalObject, willBeObject, value, code, block);
+}
+
+NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code)
+{
+    // only overwriting an own writable data property with tagged representation is served from the stub cache
+    if (LIKELY(willBeObject.isObject() && code->m_propertyName.hasAtomicString() && obj->isInlineCacheable())) {
+        ObjectStructure* structure = obj->structure();
+        String* propertyName = code->m_propertyName.asAtomicString().string();
+        PropertyAccessStubCache::SetEntry& entry = state.context()->vmInstance()->propertyAccessStubCache()->setEntry(structure, propertyName);
+
+        if (entry.m_structure == structure && entry.m_propertyName == propertyName) {
+            // stub cache hit!
+            obj->m_values[entry.m_index] = value;
+            return;
+        }
+
+        auto findResult = structure->findProperty(code->m_propertyName);
+        if (findResult.first != SIZE_MAX) {
+            const auto& desc = structure->readProperty(findResult.first).m_descriptor;
+            if (desc.isPlainDataProperty() && desc.isWritable() && !desc.hasDoubleRepresentation()) {
+                entry.m_structure = structure;
+                entry.m_propertyName = propertyName;
+                entry.m_index = findResult.first;
+                obj->m_values[findResult.first] = value;
                 return;
             }
         }
     }
 
-    setObjectPreComputedCaseOperationCacheMiss(state, originalObject, willBeObject, value, code, block);
+    obj->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
 }
 
 NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* originalObject, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block)
@@ -1859,20 +2832,31 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         return;
     }
 
+    const int maxCacheMissCount = PROPERTY_INLINE_CACHE_MAX_MISS_COUNT;
+    const int minCacheFillCount = PROPERTY_INLINE_CACHE_MIN_FILL_COUNT;
+    const size_t maxCacheCount = 4;
+
     // cache miss
-    if (code->m_missCount > 16) {
-        originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
+    if (code->m_missCount > maxCacheMissCount) {
+        setObjectPreComputedCaseOperationMegamorphic(state, originalObject, willBeObject, value, code);
         return;
     }
 
-    if (code->m_missCount < 3) {
-        code->m_missCount++;
+    code->m_missCount++;
+    if (code->m_missCount <= minCacheFillCount) {
         originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
         return;
     }
 
     if (UNLIKELY(!originalObject->isInlineCacheable())) {
-        code->m_missCount++;
+        originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
+        return;
+    }
+
+    if (UNLIKELY(code->m_missCount == maxCacheMissCount)) {
+        if (code->m_inlineCache) {
+            code->m_inlineCache->invalidateCache();
+        }
         originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
         return;
     }
@@ -1888,10 +2872,13 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
 
     auto inlineCache = code->m_inlineCache;
 
-    inlineCache->invalidateCache();
-    code->m_missCount++;
+    if (inlineCache->m_cache.size() >= maxCacheCount) {
+        setObjectPreComputedCaseOperationMegamorphic(state, originalObject, willBeObject, value, code);
+        return;
+    }
 
     Object* obj = originalObject;
+    SetObjectInlineCacheData newItem;
 
     auto findResult = obj->structure()->findProperty(code->m_propertyName);
     if (findResult.first != SIZE_MAX) {
@@ -1909,14 +2896,16 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         const auto& propertyData = obj->structure()->readProperty(findResult.first);
         const auto& desc = propertyData.m_descriptor;
         if (propertyData.m_propertyName == code->m_propertyName && desc.isPlainDataProperty() && desc.isWritable()) {
-            inlineCache->m_cachedIndex = findResult.first;
-            inlineCache->m_cachedhiddenClassChainLength = 1;
-            inlineCache->m_cachedHiddenClass = obj->structure();
+            newItem.m_cachedIndex = findResult.first;
+            newItem.m_cachedhiddenClassChainLength = 1;
+            newItem.m_cachedHiddenClass = obj->structure();
+            newItem.m_isDoubleSlot = desc.hasDoubleRepresentation();
+        } else {
+            return;
         }
     } else {
         Object* orgObject = obj;
         if (UNLIKELY(!obj->structure()->inTransitionMode())) {
-            inlineCache->invalidateCache();
             orgObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
             return;
         }
@@ -1928,7 +2917,6 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
             obj = proto.asObject();
 
             if (!UNLIKELY(obj->isInlineCacheable())) {
-                code->m_missCount++;
                 originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
                 return;
             }
@@ -1937,35 +2925,67 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
             proto = obj->getPrototype(state);
         }
 
-        inlineCache->m_hiddenClassWillBe = nullptr;
-        inlineCache->m_cachedhiddenClassChainLength = cachedhiddenClassChain.size();
-        inlineCache->m_cachedHiddenClassChainData = (ObjectStructure**)GC_MALLOC(sizeof(ObjectStructure*) * inlineCache->m_cachedhiddenClassChainLength);
-        memcpy(inlineCache->m_cachedHiddenClassChainData, cachedhiddenClassChain.data(), sizeof(ObjectStructure*) * inlineCache->m_cachedhiddenClassChainLength);
-
-        block->m_inlineCacheDataSize += sizeof(size_t) * inlineCache->m_cachedhiddenClassChainLength;
-        currentCodeSizeTotal += sizeof(size_t) * inlineCache->m_cachedhiddenClassChainLength;
         bool s = orgObject->set(state, ObjectPropertyName(state, code->m_propertyName), value, willBeObject);
         if (UNLIKELY(!s)) {
             if (state.inStrictMode()) {
                 orgObject->throwCannotWriteError(state, code->m_propertyName);
             }
-
-            inlineCache->invalidateCache();
             return;
         }
         if (!orgObject->structure()->inTransitionMode()) {
-            inlineCache->invalidateCache();
             return;
         }
 
         auto result = orgObject->get(state, ObjectPropertyName(state, code->m_propertyName));
         if (!result.hasValue() || !result.isDataProperty()) {
-            inlineCache->invalidateCache();
             return;
         }
 
-        inlineCache->m_hiddenClassWillBe = orgObject->structure();
+        newItem.m_cachedhiddenClassChainLength = cachedhiddenClassChain.size();
+        newItem.m_cachedHiddenClassChainData = (ObjectStructure**)GC_MALLOC(sizeof(ObjectStructure*) * newItem.m_cachedhiddenClassChainLength);
+        memcpy(newItem.m_cachedHiddenClassChainData, cachedhiddenClassChain.data(), sizeof(ObjectStructure*) * newItem.m_cachedhiddenClassChainLength);
+        newItem.m_hiddenClassWillBe = orgObject->structure();
+        newItem.m_isDoubleSlot = newItem.m_hiddenClassWillBe->readProperty(newItem.m_hiddenClassWillBe->propertyCount() - 1).m_descriptor.hasDoubleRepresentation();
+
+        block->m_inlineCacheDataSize += sizeof(size_t) * newItem.m_cachedhiddenClassChainLength;
+        currentCodeSizeTotal += sizeof(size_t) * newItem.m_cachedhiddenClassChainLength;
     }
+
+    inlineCache->m_cache.insert(0, newItem);
+    block->m_inlineCacheDataSize += sizeof(SetObjectInlineCacheData);
+    currentCodeSizeTotal += sizeof(SetObjectInlineCacheData);
+}
+
+template <typename CodeType>
+ALWAYS_INLINE Value ByteCodeInterpreter::callFunctionWithCallTargetCache(ExecutionState& state, CodeType* code, PointerValue* callee, const Value& receiver, Value* argv, ByteCodeBlock* block)
+{
+    CallFunctionInlineCache* inlineCache = code->m_inlineCache;
+    if (LIKELY(inlineCache && callee->isScriptFunctionObject() && callee->asScriptFunctionObject()->codeBlock() == inlineCache->m_cachedCodeBlock)) {
+        return callee->asScriptFunctionObject()->callWithEnvironmentOnStack(state, receiver, code->m_argumentCount, argv);
+    }
+
+    return callFunctionCallTargetCacheMiss(state, code->m_inlineCache, callee, receiver, code->m_argumentCount, argv, block);
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::callFunctionCallTargetCacheMiss(ExecutionState& state, CallFunctionInlineCache*& inlineCache, PointerValue* callee, const Value& receiver, const size_t argc, Value* argv, ByteCodeBlock* block)
+{
+    if (callee->isScriptFunctionObject() && (!inlineCache || inlineCache->m_missCount < 16)) {
+        // functions which override ScriptFunctionObject::call or need environment on heap are not cached
+        CodeBlock* codeBlock = callee->asScriptFunctionObject()->codeBlock();
+        if (!codeBlock->isArrowFunctionExpression() && !codeBlock->isClassConstructor() && !codeBlock->isGenerator() && !codeBlock->isAsync()
+            && codeBlock->canAllocateEnvironmentOnStack()) {
+            if (!inlineCache) {
+                inlineCache = new CallFunctionInlineCache();
+                block->m_inlineCacheDataSize += sizeof(CallFunctionInlineCache);
+                state.context()->vmInstance()->compiledByteCodeSize() += sizeof(CallFunctionInlineCache);
+                block->m_literalData.push_back(inlineCache);
+            }
+            inlineCache->m_missCount++;
+            inlineCache->m_cachedCodeBlock = codeBlock->asInterpretedCodeBlock();
+        }
+    }
+
+    return callee->call(state, receiver, argc, argv);
 }
 
 ALWAYS_INLINE Object* ByteCodeInterpreter::fastToObject(ExecutionState& state, const Value& obj)
@@ -2599,16 +3619,77 @@ NEVER_INLINE Value ByteCodeInterpreter::blockOperation(ExecutionState*& state, B
     }
 }
 
-NEVER_INLINE bool ByteCodeInterpreter::binaryInOperation(ExecutionState& state, const Value& left, const Value& right)
+NEVER_INLINE bool ByteCodeInterpreter::binaryInOperation(ExecutionState& state, BinaryInOperation* code, const Value& left, const Value& right, ByteCodeBlock* block)
 {
     if (!right.isObject()) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "type of rvalue is not Object");
         return false;
     }
 
+    Object* obj = right.asObject();
+    auto inlineCache = code->m_inlineCache;
+
+    if (inlineCache && left.isPointerValue() && left.asPointerValue() == inlineCache->m_cachedKey) {
+        Object* o = obj;
+        size_t i = 0;
+        for (; i < inlineCache->m_cachedHiddenClassChainLength; i++) {
+            if (!o || o->structure() != inlineCache->m_cachedHiddenClassChain[i] || UNLIKELY(!o->isInlineCacheable())) {
+                break;
+            }
+            o = o->Object::getPrototypeObject(state);
+        }
+        if (i == inlineCache->m_cachedHiddenClassChainLength && (inlineCache->m_cachedResult || !o)) {
+            // cache hit!
+            return inlineCache->m_cachedResult;
+        }
+    }
+
     // https://www.ecma-international.org/ecma-262/5.1/#sec-11.8.7
     // Return the result of calling the [[HasProperty]] internal method of rval with argument ToString(lval).
-    return right.toObject(state)->hasProperty(state, ObjectPropertyName(state, left));
+    ObjectPropertyName propertyName(state, left);
+    bool result = obj->hasProperty(state, propertyName);
+
+    // only cache named properties; indexed properties are not always stored in ObjectStructure
+    if ((left.isString() || left.isSymbol()) && !propertyName.isUIntType() && (!inlineCache || inlineCache->m_missCount < 16)) {
+        ObjectStructurePropertyName name = propertyName.toObjectStructurePropertyName(state);
+        VectorWithInlineStorage<8, ObjectStructure*, std::allocator<ObjectStructure*>> cachedHiddenClassChain;
+        bool found = false;
+        Object* o = obj;
+        while (o) {
+            if (UNLIKELY(!o->isInlineCacheable())) {
+                return result;
+            }
+            cachedHiddenClassChain.push_back(o->structure());
+            if (o->structure()->findProperty(name).first != SIZE_MAX) {
+                found = true;
+                break;
+            }
+            o = o->Object::getPrototypeObject(state);
+        }
+
+        // exotic objects can have properties which are not in ObjectStructure
+        if (found != result) {
+            return result;
+        }
+
+        auto& currentCodeSizeTotal = state.context()->vmInstance()->compiledByteCodeSize();
+        if (!inlineCache) {
+            inlineCache = code->m_inlineCache = new BinaryInOperationInlineCache();
+            block->m_inlineCacheDataSize += sizeof(BinaryInOperationInlineCache);
+            currentCodeSizeTotal += sizeof(BinaryInOperationInlineCache);
+            block->m_literalData.push_back(inlineCache);
+        }
+        inlineCache->m_missCount++;
+        inlineCache->m_cachedKey = left.asPointerValue();
+        inlineCache->m_cachedResult = result;
+        inlineCache->m_cachedHiddenClassChainLength = cachedHiddenClassChain.size();
+        inlineCache->m_cachedHiddenClassChain = (ObjectStructure**)GC_MALLOC(sizeof(ObjectStructure*) * cachedHiddenClassChain.size());
+        memcpy(inlineCache->m_cachedHiddenClassChain, cachedHiddenClassChain.data(), sizeof(ObjectStructure*) * cachedHiddenClassChain.size());
+        block->m_inlineCacheDataSize += sizeof(size_t) * cachedHiddenClassChain.size();
+        currentCodeSizeTotal += sizeof(size_t) * cachedHiddenClassChain.size();
+    }
+
+    return result;
 }
 
 NEVER_INLINE void ByteCodeInterpreter::callFunctionComplexCase(ExecutionState& state, CallFunctionComplexCase* code, Value* registerFile, ByteCodeBlock* byteCodeBlock)
@@ -2781,7 +3862,7 @@ NEVER_INLINE void ByteCodeInterpreter::spreadFunctionArguments(ExecutionState& s
             ArrayObject* spreadArray = arg.asObject()->asArrayObject();
             ASSERT(spreadArray->isFastModeArray());
             for (size_t i = 0; i < spreadArray->getArrayLength(state); i++) {
-                argVector.push_back(spreadArray->m_fastModeData[i]);
+                argVector.push_back(spreadArray->fastModeArrayValue(i));
             }
         } else {
             argVector.push_back(arg);
@@ -2969,11 +4050,20 @@ NEVER_INLINE void ByteCodeInterpreter::objectDefineOwnPropertyOperation(Executio
         value.asFunction()->defineOwnProperty(state, state.context()->staticStrings().name, ObjectPropertyDescriptor(fnName));
     }
 
-    // http://www.ecma-international.org/ecma-262/6.0/#sec-__proto__-property-names-in-object-initializers
-    if (!willBeObject.asObject()->isScriptClassConstructorPrototypeObject() && (propertyStringOrSymbol.isString() && propertyStringOrSymbol.asString()->equals("__proto__"))) {
-        willBeObject.asObject()->setPrototype(state, value);
-    } else {
-        willBeObject.asObject()->defineOwnProperty(state, ObjectPropertyName(state, propertyStringOrSymbol), ObjectPropertyDescriptor(value, code->m_presentAttribute));
+    // computed property name `__proto__` defines own property.
+    // `'__proto__': value` is generated into ObjectDefineOwnPropertyWithNameOperation
+    willBeObject.asObject()->defineOwnProperty(state, ObjectPropertyName(state, propertyStringOrSymbol), ObjectPropertyDescriptor(value, code->m_presentAttribute));
+}
+
+NEVER_INLINE void ByteCodeInterpreter::updateObjectLiteralStructure(Object* obj, CreateObjectWithStructure* code, ByteCodeBlock* block)
+{
+    // structure is changed when a slot with double representation got another value
+    // or it is the first execution of the literal
+    ObjectStructure* structure = obj->structure();
+    if (structure->inTransitionMode() && structure->propertyCount() == code->m_propertyCount && code->m_structureUpdateCount < CreateObjectWithStructure::maxStructureUpdateCount) {
+        code->m_structure = structure;
+        code->m_structureUpdateCount++;
+        block->m_literalData.push_back(structure);
     }
 }
 
@@ -2982,7 +4072,11 @@ NEVER_INLINE void ByteCodeInterpreter::objectDefineOwnPropertyWithNameOperation(
     const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
     // http://www.ecma-international.org/ecma-262/6.0/#sec-__proto__-property-names-in-object-initializers
     if (!willBeObject.asObject()->isScriptClassConstructorPrototypeObject() && (code->m_propertyName == state.context()->staticStrings().__proto__)) {
-        willBeObject.asObject()->setPrototype(state, registerFile[code->m_loadRegisterIndex]);
+        // If Type(propValue) is either Object or Null, then return object.[[SetPrototypeOf]](propValue)
+        const Value& proto = registerFile[code->m_loadRegisterIndex];
+        if (proto.isObject() || proto.isNull()) {
+            willBeObject.asObject()->setPrototype(state, proto);
+        }
     } else {
         willBeObject.asObject()->defineOwnProperty(state, ObjectPropertyName(code->m_propertyName), ObjectPropertyDescriptor(registerFile[code->m_loadRegisterIndex], code->m_presentAttribute));
     }
@@ -2994,7 +4088,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyOperation(Execution
     if (LIKELY(arr->isFastModeArray())) {
         for (size_t i = 0; i < code->m_count; i++) {
             if (LIKELY(code->m_loadRegisterIndexs[i] != REGISTER_LIMIT)) {
-                arr->m_fastModeData[i + code->m_baseIndex] = registerFile[code->m_loadRegisterIndexs[i]];
+                arr->setFastModeArrayValue(i + code->m_baseIndex, registerFile[code->m_loadRegisterIndexs[i]]);
             }
         }
     } else {
@@ -3035,11 +4129,11 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ArrayObject* spreadArray = element.asObject()->asArrayObject();
                     ASSERT(spreadArray->isFastModeArray());
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->getArrayLength(state); spreadIndex++) {
-                        arr->m_fastModeData[baseIndex + elementIndex] = spreadArray->m_fastModeData[spreadIndex];
+                        arr->setFastModeArrayValue(baseIndex + elementIndex, spreadArray->fastModeArrayValue(spreadIndex));
                         elementIndex++;
                     }
                 } else {
-                    arr->m_fastModeData[baseIndex + elementIndex] = element;
+                    arr->setFastModeArrayValue(baseIndex + elementIndex, element);
                     elementIndex++;
                 }
             } else {
@@ -3067,7 +4161,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ASSERT(spreadArray->isFastModeArray());
                     Value spreadElement;
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->getArrayLength(state); spreadIndex++) {
-                        spreadElement = spreadArray->m_fastModeData[spreadIndex];
+                        spreadElement = spreadArray->fastModeArrayValue(spreadIndex);
                         arr->defineOwnProperty(state, ObjectPropertyName(state, baseIndex + elementIndex), ObjectPropertyDescriptor(spreadElement, ObjectPropertyDescriptor::AllPresent));
                         elementIndex++;
                     }
@@ -3350,7 +4444,19 @@ NEVER_INLINE Object* ByteCodeInterpreter::restBindOperation(ExecutionState& stat
     return result;
 }
 
-NEVER_INLINE void ByteCodeInterpreter::getObjectOpcodeSlowCase(ExecutionState& state, GetObject* code, Value* registerFile)
+static void fillElementInlineCache(ExecutionState& state, ElementInlineCache*& inlineCache, Object* obj, ByteCodeBlock* block)
+{
+    if (!inlineCache) {
+        inlineCache = new ElementInlineCache();
+        block->m_inlineCacheDataSize += sizeof(ElementInlineCache);
+        state.context()->vmInstance()->compiledByteCodeSize() += sizeof(ElementInlineCache);
+        block->m_literalData.push_back(inlineCache);
+    }
+    inlineCache->m_cachedTag = obj->getTag();
+    inlineCache->m_typedArrayType = obj->asArrayBufferView()->typedArrayType();
+}
+
+NEVER_INLINE void ByteCodeInterpreter::getObjectOpcodeSlowCase(ExecutionState& state, GetObject* code, Value* registerFile, ByteCodeBlock* block)
 {
     const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
     const Value& property = registerFile[code->m_propertyRegisterIndex];
@@ -3360,10 +4466,13 @@ NEVER_INLINE void ByteCodeInterpreter::getObjectOpcodeSlowCase(ExecutionState& s
     } else {
         obj = fastToObject(state, willBeObject);
     }
+    if (obj->isTypedArrayObject()) {
+        fillElementInlineCache(state, code->m_elementInlineCache, obj, block);
+    }
     registerFile[code->m_storeRegisterIndex] = obj->getIndexedProperty(state, property).value(state, willBeObject);
 }
 
-NEVER_INLINE void ByteCodeInterpreter::setObjectOpcodeSlowCase(ExecutionState& state, SetObjectOperation* code, Value* registerFile)
+NEVER_INLINE void ByteCodeInterpreter::setObjectOpcodeSlowCase(ExecutionState& state, SetObjectOperation* code, Value* registerFile, ByteCodeBlock* block)
 {
     const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
     const Value& property = registerFile[code->m_propertyRegisterIndex];
@@ -3372,6 +4481,10 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectOpcodeSlowCase(ExecutionState& s
         obj->preventExtensions(state);
     }
 
+    if (obj->isTypedArrayObject()) {
+        fillElementInlineCache(state, code->m_elementInlineCache, obj, block);
+    }
+
     bool result = obj->setIndexedProperty(state, property, registerFile[code->m_loadRegisterIndex]);
     if (UNLIKELY(!result) && state.inStrictMode()) {
         Object::throwCannotWriteError(state, ObjectStructurePropertyName(state, property.toString(state)));
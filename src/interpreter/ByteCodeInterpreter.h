@@ -28,6 +28,8 @@
 namespace Escargot {
 
 class Context;
+class PointerValue;
+struct CallFunctionInlineCache;
 class ByteCodeBlock;
 class LexicalEnvironment;
 class GetObjectPreComputedCase;
@@ -46,6 +48,7 @@ class WithOperation;
 class BlockOperation;
 class ReplaceBlockLexicalEnvironmentOperation;
 class TryOperation;
+class BinaryInOperation;
 class BinaryInstanceOfOperation;
 class UnaryDelete;
 class TemplateOperation;
@@ -53,10 +56,15 @@ class DeclareFunctionDeclarations;
 class NewTargetOperation;
 class ObjectDefineOwnPropertyOperation;
 class ObjectDefineOwnPropertyWithNameOperation;
+class CreateObjectWithStructure;
 class ArrayDefineOwnPropertyOperation;
 class ArrayDefineOwnPropertyBySpreadElementOperation;
 class CreateSpreadArrayObject;
 class ObjectDefineGetterSetter;
+class LoadByName;
+class StoreByName;
+struct ByNameInlineCache;
+class EnvironmentRecord;
 class ResolveNameAddress;
 class StoreByNameWithAddress;
 class GlobalObject;
@@ -75,6 +83,10 @@ private:
     static Value loadByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool throwException = true);
     static EnvironmentRecord* getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException = true);
     static void storeByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, const Value& value);
+    static Value loadByNameWithInlineCache(ExecutionState& state, LoadByName* code, ByteCodeBlock* block);
+    static void storeByNameWithInlineCache(ExecutionState& state, StoreByName* code, const Value& value, ByteCodeBlock* block);
+    static EnvironmentRecord* testByNameInlineCache(ExecutionState& state, ByNameInlineCache* inlineCache, const AtomicString& name, Object*& holder);
+    static void fillByNameInlineCache(ExecutionState& state, const AtomicString& name, bool isStore, ByNameInlineCache*& inlineCache, ByteCodeBlock* block);
     static void initializeByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool isLexicallyDeclaredName, const Value& value);
     static void resolveNameAddress(ExecutionState& state, ResolveNameAddress* code, Value* registerFile);
     static void storeByNameWithAddress(ExecutionState& state, StoreByNameWithAddress* code, Value* registerFile);
@@ -82,7 +94,7 @@ private:
     static Value plusSlowCase(ExecutionState& state, const Value& a, const Value& b);
     static Value modOperation(ExecutionState& state, const Value& left, const Value& right);
     static Value exponentialOperation(ExecutionState& state, const Value& left, const Value& right);
-    static void instanceOfOperation(ExecutionState& state, BinaryInstanceOfOperation* code, Value* registerFile);
+    static void instanceOfOperation(ExecutionState& state, BinaryInstanceOfOperation* code, Value* registerFile, ByteCodeBlock* block);
     static void deleteOperation(ExecutionState& state, LexicalEnvironment* env, UnaryDelete* code, Value* registerFile, ByteCodeBlock* byteCodeBlock);
     static void templateOperation(ExecutionState& state, LexicalEnvironment* env, TemplateOperation* code, Value* registerFile);
 
@@ -94,8 +106,14 @@ private:
 
     static Value getObjectPrecomputedCaseOperation(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block);
     static Value getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block);
+    static Value getObjectPrecomputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code);
     static void setObjectPreComputedCaseOperation(ExecutionState& state, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block);
     static void setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block);
+    static void setObjectPreComputedCaseOperationMegamorphic(ExecutionState& state, Object* obj, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code);
+
+    template <typename CodeType>
+    static Value callFunctionWithCallTargetCache(ExecutionState& state, CodeType* code, PointerValue* callee, const Value& receiver, Value* argv, ByteCodeBlock* block);
+    static Value callFunctionCallTargetCacheMiss(ExecutionState& state, CallFunctionInlineCache*& inlineCache, PointerValue* callee, const Value& receiver, const size_t argc, Value* argv, ByteCodeBlock* block);
 
     static Object* fastToObject(ExecutionState& state, const Value& obj);
 
@@ -114,7 +132,7 @@ private:
     static Value withOperation(ExecutionState*& state, size_t& programCounter, ByteCodeBlock* byteCodeBlock, Value* registerFile);
     static Value blockOperation(ExecutionState*& state, BlockOperation* code, size_t& programCounter, ByteCodeBlock* byteCodeBlock, Value* registerFile);
     static void replaceBlockLexicalEnvironmentOperation(ExecutionState& state, size_t programCounter, ByteCodeBlock* byteCodeBlock);
-    static bool binaryInOperation(ExecutionState& state, const Value& left, const Value& right);
+    static bool binaryInOperation(ExecutionState& state, BinaryInOperation* code, const Value& left, const Value& right, ByteCodeBlock* block);
     static void callFunctionComplexCase(ExecutionState& state, CallFunctionComplexCase* code, Value* registerFile, ByteCodeBlock* byteCodeBlock);
     static void spreadFunctionArguments(ExecutionState& state, const Value* argv, const size_t argc, ValueVector& argVector);
 
@@ -130,6 +148,7 @@ private:
     static void newTargetOperation(ExecutionState& state, NewTargetOperation* code, Value* registerFile);
 
     static void objectDefineOwnPropertyOperation(ExecutionState& state, ObjectDefineOwnPropertyOperation* code, Value* registerFile);
+    static void updateObjectLiteralStructure(Object* obj, CreateObjectWithStructure* code, ByteCodeBlock* block);
     static void objectDefineOwnPropertyWithNameOperation(ExecutionState& state, ObjectDefineOwnPropertyWithNameOperation* code, Value* registerFile);
     static void arrayDefineOwnPropertyOperation(ExecutionState& state, ArrayDefineOwnPropertyOperation* code, Value* registerFile);
     static void arrayDefineOwnPropertyBySpreadElementOperation(ExecutionState& state, ArrayDefineOwnPropertyBySpreadElementOperation* code, Value* registerFile);
@@ -138,8 +157,8 @@ private:
     static Value incrementOperation(ExecutionState& state, const Value& value);
     static Value decrementOperation(ExecutionState& state, const Value& value);
 
-    static void getObjectOpcodeSlowCase(ExecutionState& state, GetObject* code, Value* registerFile);
-    static void setObjectOpcodeSlowCase(ExecutionState& state, SetObjectOperation* code, Value* registerFile);
+    static void getObjectOpcodeSlowCase(ExecutionState& state, GetObject* code, Value* registerFile, ByteCodeBlock* block);
+    static void setObjectOpcodeSlowCase(ExecutionState& state, SetObjectOperation* code, Value* registerFile, ByteCodeBlock* block);
 
     static void unaryTypeof(ExecutionState& state, UnaryTypeof* code, Value* registerFile);
 
@@ -356,6 +356,31 @@ InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringV
     initBlockScopeInformation(scopeCtx);
 }
 
+InterpretedCodeBlock::InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ExtendedNodeLOC functionStart, InterpretedCodeBlock* parentBlock)
+    : m_script(script)
+    , m_src(src)
+    , m_parameterCount(0)
+    , m_functionBodyBlockIndex(0)
+    , m_identifierOnStackCount(0)
+    , m_identifierOnHeapCount(0)
+    , m_lexicalBlockStackAllocatedIdentifierMaximumDepth(0)
+    , m_lexicalBlockIndexFunctionLocatedIn(0)
+    , m_identifierInfoMap(nullptr)
+    , m_parentCodeBlock(parentBlock)
+    , m_firstChild(nullptr)
+    , m_nextSibling(nullptr)
+    , m_functionStart(functionStart)
+#ifndef NDEBUG
+    , m_bodyEndLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX)
+    , m_scopeContext(nullptr)
+#endif
+{
+    m_context = ctx;
+    m_functionLength = 0;
+    m_hasCallNativeFunctionCode = false;
+    m_byteCodeBlock = nullptr;
+}
+
 void InterpretedCodeBlock::captureArguments()
 {
     AtomicString arguments = m_context->staticStrings().arguments;
@@ -75,6 +75,9 @@ class CodeBlock : public gc {
     friend class ScriptFunctionObject;
     friend class InterpretedCodeBlock;
     friend class VMInstance;
+    friend class CodeCache;
+    friend class CodeCacheReader;
+    friend class CodeCacheWriter;
     friend int getValidValueInCodeBlock(void* ptr, GC_mark_custom_result* arr);
 
 public:
@@ -359,6 +362,8 @@ class InterpretedCodeBlock : public CodeBlock {
     friend class ByteCodeGenerator;
     friend class FunctionObject;
     friend class ByteCodeInterpreter;
+    friend class CodeCacheReader;
+    friend class CodeCacheWriter;
 
     friend int getValidValueInInterpretedCodeBlock(void* ptr, GC_mark_custom_result* arr);
 
@@ -733,6 +738,8 @@ protected:
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ASTFunctionScopeContext* scopeCtx, bool isEvalCode, bool isEvalCodeInFunction);
     // init function codeBlock
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ASTFunctionScopeContext* scopeCtx, InterpretedCodeBlock* parentBlock, bool isEvalCode, bool isEvalCodeInFunction);
+    // init codeBlock loaded from code cache (CodeCacheReader fills the others)
+    InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ExtendedNodeLOC functionStart, InterpretedCodeBlock* parentBlock);
 
     void computeBlockVariables(LexicalBlockIndex currentBlockIndex, size_t currentStackAllocatedVariableIndex, size_t& maxStackAllocatedVariableDepth);
     void initBlockScopeInformation(ASTFunctionScopeContext* scopeCtx);
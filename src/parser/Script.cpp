@@ -463,17 +463,21 @@ Value Script::execute(ExecutionState& state, bool isExecuteOnEvalFunction, bool
 
     ByteCodeBlock* byteCodeBlock = m_topCodeBlock->byteCodeBlock();
 
-    ExecutionState newState(context(), state.stackLimit());
+    // global code runs on Context of state. it can be other Context than the one which compiled this script
+    Context* ctx = state.context();
+    ASSERT(ctx->vmInstance() == context()->vmInstance());
+
+    ExecutionState newState(ctx, state.stackLimit());
     ExecutionState* codeExecutionState = &newState;
 
-    EnvironmentRecord* globalRecord = new GlobalEnvironmentRecord(state, m_topCodeBlock, context()->globalObject(), context()->globalDeclarativeRecord(), context()->globalDeclarativeStorage());
+    EnvironmentRecord* globalRecord = new GlobalEnvironmentRecord(state, m_topCodeBlock, ctx->globalObject(), ctx->globalDeclarativeRecord(), ctx->globalDeclarativeStorage());
     LexicalEnvironment* globalLexicalEnvironment = new LexicalEnvironment(globalRecord, nullptr);
     newState.setLexicalEnvironment(globalLexicalEnvironment, m_topCodeBlock->isStrict());
 
     if (inStrictMode && isExecuteOnEvalFunction) {
         // NOTE: ES5 10.4.2.1 eval in strict mode
         EnvironmentRecord* newVariableRecord = new DeclarativeEnvironmentRecordNotIndexed(state, true);
-        ExecutionState* newVariableState = new ExecutionState(context());
+        ExecutionState* newVariableState = new ExecutionState(ctx);
         newVariableState->setLexicalEnvironment(new LexicalEnvironment(newVariableRecord, globalLexicalEnvironment), m_topCodeBlock->isStrict());
         newVariableState->setParent(&newState);
         codeExecutionState = newVariableState;
@@ -508,7 +512,7 @@ Value Script::execute(ExecutionState& state, bool isExecuteOnEvalFunction, bool
         }
     }
 
-    Value thisValue(context()->globalObject());
+    Value thisValue(ctx->globalObject());
 
     size_t literalStorageSize = byteCodeBlock->m_numeralLiteralData.size();
     Value* registerFile = (Value*)ALLOCA((byteCodeBlock->m_requiredRegisterFileSizeInValueSize + 1 + literalStorageSize + m_topCodeBlock->lexicalBlockStackAllocatedIdentifierMaximumDepth()) * sizeof(Value), Value, state);
@@ -525,7 +529,9 @@ Value Script::execute(ExecutionState& state, bool isExecuteOnEvalFunction, bool
     clearStack<512>();
 
     // we give up program bytecodeblock after first excution for reducing memory usage
-    m_topCodeBlock->m_byteCodeBlock = nullptr;
+    if (!m_isSharedAcrossContexts) {
+        m_topCodeBlock->m_byteCodeBlock = nullptr;
+    }
 
     return resultValue;
 }
@@ -30,6 +30,7 @@ class ModuleEnvironmentRecord;
 
 class Script : public gc {
     friend class ScriptParser;
+    friend class CodeCache;
     friend class GlobalObject;
     friend class ModuleNamespaceObject;
 
@@ -94,6 +95,12 @@ public:
         return m_sourceCode;
     }
 
+    // false for scripts loaded from precompiled bundle. their functions cannot be compiled again
+    bool hasSourceCode()
+    {
+        return m_hasSourceCode;
+    }
+
     InterpretedCodeBlock* topCodeBlock()
     {
         return m_topCodeBlock;
@@ -116,9 +123,25 @@ public:
 
     bool isExecuted();
 
+    // keeps ByteCodeBlock of global code after execution,
+    // so this script can be executed again on any Context of its VMInstance without parsing
+    // module cannot be shared because module record belongs to one Context
+    bool isSharedAcrossContexts()
+    {
+        return m_isSharedAcrossContexts;
+    }
+
+    void setSharedAcrossContexts()
+    {
+        ASSERT(!isModule());
+        m_isSharedAcrossContexts = true;
+    }
+
 private:
     Script(String* src, String* sourceCode, ModuleData* moduleData, bool canExecuteAgain)
         : m_canExecuteAgain(canExecuteAgain && !moduleData)
+        , m_hasSourceCode(true)
+        , m_isSharedAcrossContexts(false)
         , m_src(src)
         , m_sourceCode(sourceCode)
         , m_topCodeBlock(nullptr)
@@ -161,6 +184,8 @@ private:
     // http://www.ecma-international.org/ecma-262/6.0/#sec-getexportednames
     AtomicStringVector exportedNames(ExecutionState& state, std::vector<Script*>& exportStarSet);
     bool m_canExecuteAgain;
+    bool m_hasSourceCode;
+    bool m_isSharedAcrossContexts;
     String* m_src;
     String* m_sourceCode;
     InterpretedCodeBlock* m_topCodeBlock;
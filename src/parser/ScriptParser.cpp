@@ -28,14 +28,45 @@
 #include "parser/CodeBlock.h"
 #include "runtime/Environment.h"
 #include "runtime/EnvironmentRecord.h"
+#include "codecache/CodeCache.h"
 
 namespace Escargot {
 
 ScriptParser::ScriptParser(Context* c)
     : m_context(c)
+    , m_codeCacheDirectory(nullptr)
 {
 }
 
+void ScriptParser::setCodeCacheDirectory(const char* directory)
+{
+    if (directory) {
+        size_t length = strlen(directory);
+        m_codeCacheDirectory = (char*)GC_MALLOC_ATOMIC(length + 1);
+        memcpy(m_codeCacheDirectory, directory, length + 1);
+    } else {
+        m_codeCacheDirectory = nullptr;
+    }
+}
+
+ScriptParser::InitializeScriptResult ScriptParser::initializeScriptWithBundle(const char* data, size_t length, String* fileName)
+{
+    ScriptParser::InitializeScriptResult result;
+    Script* script = CodeCache::loadBundle(m_context, fileName, data, length);
+    if (script) {
+        result.script = script;
+    } else {
+        result.parseErrorCode = ErrorObject::Code::SyntaxError;
+        result.parseErrorMessage = new ASCIIString("invalid or incompatible bundle");
+    }
+    return result;
+}
+
+bool ScriptParser::writeBundle(Script* script, const char* filePath)
+{
+    return CodeCache::storeBundle(m_context, script, filePath);
+}
+
 InterpretedCodeBlock* ScriptParser::generateCodeBlockTreeFromASTWalker(Context* ctx, StringView source, Script* script, ASTFunctionScopeContext* scopeCtx, InterpretedCodeBlock* parentCodeBlock, bool isEvalCode, bool isEvalCodeInFunction)
 {
     InterpretedCodeBlock* codeBlock;
@@ -205,6 +236,19 @@ void ScriptParser::generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCode
 
 ScriptParser::InitializeScriptResult ScriptParser::initializeScript(StringView scriptSource, String* fileName, bool isModule, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, bool isEvalMode, bool inWithOperation, size_t stackSizeRemain, bool needByteCodeGeneration, bool allowSuperCall, bool allowSuperProperty, bool allowNewTarget)
 {
+    // only ordinary top-level scripts are cached. eval and module codes depend on their caller
+    bool canUseCodeCache = m_codeCacheDirectory && !parentCodeBlock && !isModule && !isEvalMode && !isEvalCodeInFunction
+        && !strictFromOutside && !inWithOperation && needByteCodeGeneration;
+    if (canUseCodeCache) {
+        Script* cachedScript = CodeCache::load(m_context, m_codeCacheDirectory, fileName, scriptSource);
+        if (cachedScript) {
+            applyWarmUpProfile(cachedScript);
+            ScriptParser::InitializeScriptResult result;
+            result.script = cachedScript;
+            return result;
+        }
+    }
+
     GC_disable();
 
     bool inWith = (parentCodeBlock ? parentCodeBlock->inWith() : false) || inWithOperation;
@@ -246,12 +290,19 @@ ScriptParser::InitializeScriptResult ScriptParser::initializeScript(StringView s
         // Generate ByteCode
         if (LIKELY(needByteCodeGeneration)) {
             topCodeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(m_context, topCodeBlock, programNode, programNode->scopeContext(), isEvalMode, !isEvalCodeInFunction, inWith);
+            if (canUseCodeCache) {
+                CodeCache::store(m_context, m_codeCacheDirectory, script);
+            }
         }
 
         // reset ASTAllocator
         m_context->astAllocator().reset();
         GC_enable();
 
+        if (!parentCodeBlock && !isEvalMode && needByteCodeGeneration) {
+            applyWarmUpProfile(script);
+        }
+
         ScriptParser::InitializeScriptResult result;
         result.script = script;
         return result;
@@ -293,6 +344,19 @@ void ScriptParser::generateFunctionByteCode(ExecutionState& state, InterpretedCo
     // reset ASTAllocator
     m_context->astAllocator().reset();
     GC_enable();
+
+    if (UNLIKELY(m_context->vmInstance()->warmUpProfile() != nullptr)) {
+        m_context->vmInstance()->warmUpProfile()->applyToByteCodeBlock(codeBlock);
+    }
+}
+
+void ScriptParser::applyWarmUpProfile(Script* script)
+{
+    WarmUpProfile* profile = m_context->vmInstance()->warmUpProfile();
+    if (UNLIKELY(profile != nullptr)) {
+        profile->applyToByteCodeBlock(script->topCodeBlock());
+        profile->compileProfiledFunctions(m_context, script);
+    }
 }
 
 #ifndef NDEBUG
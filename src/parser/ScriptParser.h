@@ -66,7 +66,17 @@ public:
 
     void generateFunctionByteCode(ExecutionState& state, InterpretedCodeBlock* codeBlock, size_t stackSizeRemain);
 
+    // top-level scripts are loaded from (and stored into) code cache files in this directory
+    // passing nullptr disables code cache
+    void setCodeCacheDirectory(const char* directory);
+
+    // precompiled bundle (see CodeCache). loaded script has no source code
+    InitializeScriptResult initializeScriptWithBundle(const char* data, size_t length, String* fileName);
+    bool writeBundle(Script* script, const char* filePath);
+
 private:
+    // feedback of previous run (see WarmUpProfile)
+    void applyWarmUpProfile(Script* script);
     InterpretedCodeBlock* generateCodeBlockTreeFromAST(Context* ctx, StringView source, Script* script, ProgramNode* program, bool isEvalCode, bool isEvalCodeInFunction);
     InterpretedCodeBlock* generateCodeBlockTreeFromASTWalker(Context* ctx, StringView source, Script* script, ASTFunctionScopeContext* scopeCtx, InterpretedCodeBlock* parentCodeBlock, bool isEvalCode, bool isEvalCodeInFunction);
     void generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCodeBlock* cb);
@@ -75,6 +85,7 @@ private:
 #endif
 
     Context* m_context;
+    char* m_codeCacheDirectory;
 };
 }
 
@@ -24,6 +24,7 @@
 #include "Node.h"
 
 #include "runtime/Context.h"
+#include "runtime/VMInstance.h"
 
 namespace Escargot {
 
@@ -170,7 +171,7 @@ public:
                     if (isLexicallyDeclaredBindingInitialization) {
                         codeBlock->pushCode(InitializeGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, m_name), context, this);
                     } else {
-                        codeBlock->pushCode(SetGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, codeBlock->m_codeBlock->context()->ensureGlobalVariableAccessCacheSlot(m_name)), context, this);
+                        codeBlock->pushCode(SetGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, codeBlock->m_codeBlock->context()->vmInstance()->globalVariableAccessCacheSlotIndex(m_name)), context, this);
                     }
                 }
             } else {
@@ -191,7 +192,7 @@ public:
                         if (isLexicallyDeclaredBindingInitialization) {
                             codeBlock->pushCode(InitializeGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, m_name), context, this);
                         } else {
-                            codeBlock->pushCode(SetGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, codeBlock->m_codeBlock->context()->ensureGlobalVariableAccessCacheSlot(m_name)), context, this);
+                            codeBlock->pushCode(SetGlobalVariable(ByteCodeLOC(m_loc.index), srcRegister, codeBlock->m_codeBlock->context()->vmInstance()->globalVariableAccessCacheSlotIndex(m_name)), context, this);
                         }
                     } else {
                         if (isLexicallyDeclaredBindingInitialization || isVarDeclaredBindingInitialization) {
@@ -240,7 +241,7 @@ public:
                 if (codeBlock->m_codeBlock->hasAncestorUsesNonIndexedVariableStorage()) {
                     codeBlock->pushCode(LoadByName(ByteCodeLOC(m_loc.index), dstRegister, m_name), context, this);
                 } else {
-                    codeBlock->pushCode(GetGlobalVariable(ByteCodeLOC(m_loc.index), dstRegister, codeBlock->m_codeBlock->context()->ensureGlobalVariableAccessCacheSlot(m_name)), context, this);
+                    codeBlock->pushCode(GetGlobalVariable(ByteCodeLOC(m_loc.index), dstRegister, codeBlock->m_codeBlock->context()->vmInstance()->globalVariableAccessCacheSlotIndex(m_name)), context, this);
                 }
             } else {
                 if (info.m_isStackAllocated) {
@@ -252,7 +253,7 @@ public:
                         codeBlock->pushCode(Move(ByteCodeLOC(m_loc.index), REGULAR_REGISTER_LIMIT + info.m_index, dstRegister), context, this);
                 } else {
                     if (info.m_isGlobalLexicalVariable) {
-                        codeBlock->pushCode(GetGlobalVariable(ByteCodeLOC(m_loc.index), dstRegister, codeBlock->m_codeBlock->context()->ensureGlobalVariableAccessCacheSlot(m_name)), context, this);
+                        codeBlock->pushCode(GetGlobalVariable(ByteCodeLOC(m_loc.index), dstRegister, codeBlock->m_codeBlock->context()->vmInstance()->globalVariableAccessCacheSlotIndex(m_name)), context, this);
                     } else {
                         codeBlock->pushCode(LoadByHeapIndex(ByteCodeLOC(m_loc.index), dstRegister, info.m_upperIndex, info.m_index), context, this);
                     }
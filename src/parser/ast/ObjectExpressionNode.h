@@ -44,6 +44,12 @@ public:
     virtual ASTNodeType type() override { return ASTNodeType::ObjectExpression; }
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister) override
     {
+        size_t propertyCount = propertyCountOfPlainLiteral(codeBlock);
+        if (propertyCount) {
+            generatePlainLiteralByteCode(codeBlock, context, dstRegister, propertyCount);
+            return;
+        }
+
         codeBlock->pushCode(CreateObject(ByteCodeLOC(m_loc.index), dstRegister), context, this);
         size_t objIndex = dstRegister;
         for (SentinelNode* property = m_properties.begin(); property != m_properties.end(); property = property->next()) {
@@ -69,6 +75,9 @@ public:
                 if (p->kind() == PropertyNode::Kind::Init) {
                     if (hasKeyName) {
                         codeBlock->pushCode(ObjectDefineOwnPropertyWithNameOperation(ByteCodeLOC(m_loc.index), objIndex, p->key()->asIdentifier()->name(), valueIndex, ObjectPropertyDescriptor::AllPresent), context, this);
+                    } else if (isProtoStringLiteralKey(p)) {
+                        // `'__proto__': value` sets [[Prototype]] like `__proto__: value`. computed `['__proto__']` does not
+                        codeBlock->pushCode(ObjectDefineOwnPropertyWithNameOperation(ByteCodeLOC(m_loc.index), objIndex, codeBlock->m_codeBlock->context()->staticStrings().__proto__, valueIndex, ObjectPropertyDescriptor::AllPresent), context, this);
                     } else {
                         bool hasFunctionOnRightSide = p->value()->type() == ASTNodeType::FunctionExpression || p->value()->type() == ASTNodeType::ArrowFunctionExpression;
                         bool hasClassOnRightSide = p->value()->type() == ASTNodeType::ClassExpression && !p->value()->asClassExpression()->classNode().classBody()->hasStaticMemberName(codeBlock->m_codeBlock->context()->staticStrings().name);
@@ -167,6 +176,69 @@ public:
     }
 
 private:
+    static bool isProtoStringLiteralKey(PropertyNode* p)
+    {
+        if (p->computed() || !p->key()->isLiteral()) {
+            return false;
+        }
+        const Value& key = p->key()->asLiteral()->value();
+        return key.isString() && key.asString()->equals("__proto__");
+    }
+
+    // returns number of properties if every property is `name: value` with distinct name except __proto__
+    // returns 0 otherwise
+    size_t propertyCountOfPlainLiteral(ByteCodeBlock* codeBlock)
+    {
+        std::vector<AtomicString> names;
+        AtomicString protoName = codeBlock->m_codeBlock->context()->staticStrings().__proto__;
+        for (SentinelNode* property = m_properties.begin(); property != m_properties.end(); property = property->next()) {
+            if (!property->astNode()->isProperty()) {
+                return 0;
+            }
+            PropertyNode* p = property->astNode()->asProperty();
+            if (p->kind() != PropertyNode::Kind::Init || p->computed() || !p->key()->isIdentifier()) {
+                return 0;
+            }
+            AtomicString name = p->key()->asIdentifier()->name();
+            if (name == protoName || std::find(names.begin(), names.end(), name) != names.end()) {
+                return 0;
+            }
+            names.push_back(name);
+            if (names.size() > ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MODE_MAX_SIZE) {
+                return 0;
+            }
+        }
+        return names.size();
+    }
+
+    // object is created with structure of the previous execution, and values are written into its slots in order
+    void generatePlainLiteralByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister, size_t propertyCount)
+    {
+        size_t createPosition = codeBlock->currentCodeSize();
+        codeBlock->pushCode(CreateObjectWithStructure(ByteCodeLOC(m_loc.index), dstRegister, propertyCount), context, this);
+
+        size_t slotIndex = 0;
+        size_t lastPropertyPosition = SIZE_MAX;
+        for (SentinelNode* property = m_properties.begin(); property != m_properties.end(); property = property->next()) {
+            PropertyNode* p = property->astNode()->asProperty();
+            size_t valueIndex = p->value()->getRegister(codeBlock, context);
+            const ClassContextInformation classInfoBefore = context->m_classInfo;
+            context->m_classInfo.m_prototypeIndex = dstRegister;
+            context->m_classInfo.m_constructorIndex = SIZE_MAX;
+            context->m_classInfo.m_superIndex = SIZE_MAX;
+            p->value()->generateExpressionByteCode(codeBlock, context, valueIndex);
+            context->m_classInfo = classInfoBefore;
+
+            lastPropertyPosition = codeBlock->currentCodeSize();
+            codeBlock->pushCode(InitializeObjectLiteralProperty(ByteCodeLOC(m_loc.index), dstRegister, p->key()->asIdentifier()->name(), valueIndex, slotIndex++), context, this);
+            context->giveUpRegister(); // for drop value index
+        }
+        ASSERT(slotIndex == propertyCount);
+        codeBlock->peekCode<InitializeObjectLiteralProperty>(lastPropertyPosition)->m_createObjectCodePosition = createPosition;
+
+        codeBlock->m_shouldClearStack = true;
+    }
+
     NodeList m_properties;
 };
 }
@@ -31,6 +31,9 @@ size_t g_arrayObjectTag;
 ArrayObject::ArrayObject(ExecutionState& state)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, false)
     , m_arrayLength(0)
+#if defined(ESCARGOT_64)
+    , m_elementsKind(SmiElements)
+#endif
     , m_fastModeData(nullptr)
 {
     Object::setPrototypeForIntrinsicObjectCreation(state, state.context()->globalObject()->arrayPrototype());
@@ -195,7 +198,7 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
                     goto NonFastPath;
                 }
             }
-            m_fastModeData[idx] = desc.value();
+            setFastModeArrayValue(idx, desc.value());
             return true;
         }
     }
@@ -231,7 +234,7 @@ bool ArrayObject::deleteOwnProperty(ExecutionState& state, const ObjectPropertyN
             uint64_t len = getArrayLength(state);
             if (idx < len) {
                 if (!m_fastModeData[idx].isEmpty()) {
-                    m_fastModeData[idx] = Value(Value::EmptyValue);
+                    m_fastModeData[idx] = SmallValue(SmallValue::EmptyValue);
                     ensureObjectRareData()->m_shouldUpdateEnumerateObject = true;
                 }
                 return true;
@@ -274,7 +277,7 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
             Value* tempBuffer = canUseStack ? (Value*)alloca(byteLength) : CustomAllocator<Value>().allocate(orgLength);
 
             for (size_t i = 0; i < orgLength; i++) {
-                tempBuffer[i] = m_fastModeData[i];
+                tempBuffer[i] = fastModeArrayValue(i);
             }
 
             if (orgLength) {
@@ -296,7 +299,11 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
 
             if (isFastModeArray()) {
                 for (size_t i = 0; i < orgLength; i++) {
-                    m_fastModeData[i] = tempBuffer[i];
+                    if (tempBuffer[i].isEmpty()) {
+                        m_fastModeData[i] = SmallValue(SmallValue::EmptyValue);
+                    } else {
+                        setFastModeArrayValue(i, tempBuffer[i]);
+                    }
                 }
             }
 
@@ -331,7 +338,7 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
     auto length = getArrayLength(state);
     for (size_t i = 0; i < length; i++) {
         if (!m_fastModeData[i].isEmpty()) {
-            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(m_fastModeData[i], ObjectPropertyDescriptor::AllPresent));
+            defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(fastModeArrayValue(i), ObjectPropertyDescriptor::AllPresent));
         }
     }
 
@@ -339,6 +346,33 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
     m_fastModeData = nullptr;
 }
 
+#if defined(ESCARGOT_64)
+void ArrayObject::generalizeElementsKind(const Value& newValue)
+{
+    ASSERT(isFastModeArray());
+    ASSERT(m_elementsKind != TaggedElements);
+
+    if (m_elementsKind == SmiElements && newValue.isNumber()) {
+        for (size_t i = 0; i < m_arrayLength; i++) {
+            if (!m_fastModeData[i].isEmpty()) {
+                m_fastModeData[i] = SmallValue::fromUnboxedDouble(Value(m_fastModeData[i]).asNumber());
+            }
+        }
+        m_elementsKind = DoubleElements;
+    } else {
+        if (m_elementsKind == DoubleElements) {
+            // box every element once
+            for (size_t i = 0; i < m_arrayLength; i++) {
+                if (!m_fastModeData[i].isEmpty()) {
+                    m_fastModeData[i] = SmallValue(Value(m_fastModeData[i].asUnboxedDouble()));
+                }
+            }
+        }
+        m_elementsKind = TaggedElements;
+    }
+}
+#endif
+
 bool ArrayObject::setArrayLength(ExecutionState& state, const Value& newLength)
 {
     bool isPrimitiveValue;
@@ -492,7 +526,7 @@ ObjectGetResult ArrayObject::getVirtualValue(ExecutionState& state, const Object
     if (LIKELY(isFastModeArray())) {
         uint64_t idx = P.tryToUseAsArrayIndex();
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < getArrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -507,7 +541,7 @@ ObjectHasPropertyResult ArrayObject::hasIndexedProperty(ExecutionState& state, c
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = propertyName.tryToUseAsArrayIndex(state);
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < getArrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectHasPropertyResult(ObjectGetResult(v, true, true, true));
             }
@@ -521,7 +555,7 @@ ObjectGetResult ArrayObject::getIndexedProperty(ExecutionState& state, const Val
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = property.tryToUseAsArrayIndex(state);
         if (LIKELY(idx != Value::InvalidArrayIndexValue) && LIKELY(idx < getArrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = fastModeArrayValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -546,11 +580,11 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
                 }
                 // fast, non-fast mode can be changed while changing length
                 if (LIKELY(isFastModeArray())) {
-                    m_fastModeData[idx] = value;
+                    setFastModeArrayValue(idx, value);
                     return true;
                 }
             } else {
-                m_fastModeData[idx] = value;
+                setFastModeArrayValue(idx, value);
                 return true;
             }
         }
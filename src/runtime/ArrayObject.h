@@ -119,6 +119,41 @@ private:
     {
         ASSERT(isFastModeArray());
         ASSERT(idx < getArrayLength(state));
+        setFastModeArrayValue(idx, v);
+    }
+
+    // element of fast mode array. returns EmptyValue for hole
+    ALWAYS_INLINE Value fastModeArrayValue(size_t idx)
+    {
+#if defined(ESCARGOT_64)
+        if (m_elementsKind == DoubleElements && !m_fastModeData[idx].isEmpty()) {
+            return Value(m_fastModeData[idx].asUnboxedDouble());
+        }
+#endif
+        return m_fastModeData[idx];
+    }
+
+    // v should not be EmptyValue. holes are written as SmallValue::EmptyValue directly
+    ALWAYS_INLINE void setFastModeArrayValue(size_t idx, const Value& v)
+    {
+        ASSERT(isFastModeArray());
+        ASSERT(!v.isEmpty());
+#if defined(ESCARGOT_64)
+        if (m_elementsKind != TaggedElements) {
+            if (m_elementsKind == SmiElements) {
+                if (UNLIKELY(!v.isInt32() || !SmallValueImpl::PlatformSmiTagging::IsValidSmi(v.asInt32()))) {
+                    generalizeElementsKind(v);
+                }
+            } else if (UNLIKELY(!v.isNumber())) {
+                generalizeElementsKind(v);
+            }
+
+            if (m_elementsKind == DoubleElements) {
+                m_fastModeData[idx] = SmallValue::fromUnboxedDouble(v.asNumber());
+                return;
+            }
+        }
+#endif
         m_fastModeData[idx] = v;
     }
 
@@ -133,7 +168,26 @@ private:
 
     ObjectGetResult getVirtualValue(ExecutionState& state, const ObjectPropertyName& P);
 
+#if defined(ESCARGOT_64)
+    // representation of m_fastModeData. it only moves forward (SmiElements -> DoubleElements -> TaggedElements)
+    // so numeric arrays store doubles without allocating DoubleInSmallValue
+    enum ElementsKind : uint8_t {
+        // every element is a hole or SMI
+        SmiElements,
+        // every element is a hole or double encoded by SmallValue::fromUnboxedDouble
+        DoubleElements,
+        // elements are SmallValue
+        TaggedElements,
+    };
+
+    // changes kind of elements so that newValue can be stored
+    void generalizeElementsKind(const Value& newValue);
+#endif
+
     uint32_t m_arrayLength;
+#if defined(ESCARGOT_64)
+    ElementsKind m_elementsKind;
+#endif
     SmallValue* m_fastModeData;
 };
 
@@ -53,7 +53,7 @@ Context::Context(VMInstance* instance)
     , m_scriptParser(new ScriptParser(this))
     , m_globalDeclarativeRecord(new IdentifierRecordVector())
     , m_globalDeclarativeStorage(new SmallValueVector())
-    , m_globalVariableAccessCache(new (GC) GlobalVariableAccessCache)
+    , m_globalVariableAccessCache(new GlobalVariableAccessCache())
     , m_loadedModules(new LoadedModuleVector())
     , m_bumpPointerAllocator(instance->m_bumpPointerAllocator)
     , m_regexpCache(instance->m_regexpCache)
@@ -96,19 +96,18 @@ void Context::throwException(ExecutionState& state, const Value& exception)
     }
 }
 
-GlobalVariableAccessCacheItem* Context::ensureGlobalVariableAccessCacheSlot(AtomicString as)
+GlobalVariableAccessCacheItem* Context::ensureGlobalVariableAccessCacheSlot(size_t index)
 {
-    auto iter = m_globalVariableAccessCache->find(as);
-    if (iter == m_globalVariableAccessCache->end()) {
-        GlobalVariableAccessCacheItem* slot = new GlobalVariableAccessCacheItem();
-        slot->m_lexicalIndexCache = std::numeric_limits<size_t>::max();
-        slot->m_propertyName = as;
-        slot->m_cachedAddress = nullptr;
-        slot->m_cachedStructure = nullptr;
-        m_globalVariableAccessCache->insert(std::make_pair(as, slot));
-        return slot;
+    if (index >= m_globalVariableAccessCache->size()) {
+        m_globalVariableAccessCache->resize(index + 1, nullptr);
     }
 
-    return iter->second;
+    GlobalVariableAccessCacheItem* slot = new GlobalVariableAccessCacheItem();
+    slot->m_lexicalIndexCache = std::numeric_limits<size_t>::max();
+    slot->m_propertyName = m_instance->globalVariableAccessCacheSlotName(index);
+    slot->m_cachedAddress = nullptr;
+    slot->m_cachedStructure = nullptr;
+    (*m_globalVariableAccessCache)[index] = slot;
+    return slot;
 }
 }
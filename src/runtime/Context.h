@@ -68,9 +68,9 @@ struct GlobalVariableAccessCacheItem : public gc {
     void* operator new[](size_t size) = delete;
 };
 
-typedef std::unordered_map<AtomicString, GlobalVariableAccessCacheItem*, std::hash<AtomicString>, std::equal_to<AtomicString>,
-                           GCUtil::gc_malloc_allocator<std::pair<AtomicString const, GlobalVariableAccessCacheItem*>>>
-    GlobalVariableAccessCache;
+// indexed by VM-wide slot index of VMInstance::globalVariableAccessCacheSlotIndex
+// items are created lazily, so bytecode compiled on other Context can use this Context's cache too
+typedef Vector<GlobalVariableAccessCacheItem*, GCUtil::gc_malloc_allocator<GlobalVariableAccessCacheItem*>> GlobalVariableAccessCache;
 
 class Context : public gc {
     friend class AtomicString;
@@ -217,7 +217,13 @@ public:
         return m_globalDeclarativeStorage;
     }
 
-    GlobalVariableAccessCacheItem* ensureGlobalVariableAccessCacheSlot(AtomicString as);
+    GlobalVariableAccessCacheItem* globalVariableAccessCacheSlot(size_t index)
+    {
+        if (LIKELY(index < m_globalVariableAccessCache->size() && (*m_globalVariableAccessCache)[index])) {
+            return (*m_globalVariableAccessCache)[index];
+        }
+        return ensureGlobalVariableAccessCacheSlot(index);
+    }
 
     LoadedModuleVector* loadedModules()
     {
@@ -230,6 +236,8 @@ public:
     }
 
 private:
+    NEVER_INLINE GlobalVariableAccessCacheItem* ensureGlobalVariableAccessCacheSlot(size_t index);
+
     VMInstance* m_instance;
 
     // these data actually store in VMInstance
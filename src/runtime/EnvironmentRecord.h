@@ -281,6 +281,8 @@ private:
 
 // http://www.ecma-international.org/ecma-262/6.0/index.html#sec-global-environment-records
 class GlobalEnvironmentRecord : public EnvironmentRecord {
+    friend class ByteCodeInterpreter;
+
 public:
     GlobalEnvironmentRecord(ExecutionState& state, InterpretedCodeBlock* codeBlock, GlobalObject* global, IdentifierRecordVector* globalDeclarativeRecord, SmallValueVector* globalDeclarativeStorage);
     ~GlobalEnvironmentRecord() {}
@@ -384,6 +386,8 @@ public:
 };
 
 class DeclarativeEnvironmentRecordIndexed : public DeclarativeEnvironmentRecord {
+    friend class ByteCodeInterpreter;
+
 public:
     DeclarativeEnvironmentRecordIndexed(ExecutionState& state, InterpretedCodeBlock::BlockInfo* blockInfo)
         : DeclarativeEnvironmentRecord()
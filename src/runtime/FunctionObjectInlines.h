@@ -49,7 +49,7 @@ public:
         // --> thisMode is always not lexcial because this is class ctor.
         // Let calleeRealm be the value of F’s [[Realm]] internal slot.
         // Let localEnv be the LexicalEnvironment of calleeContext.
-        ASSERT(calleeState.context() == self->codeBlock()->context());
+        ASSERT(calleeState.context() == self->getFunctionRealm(calleeState));
 
         if (isStrict) {
             // If thisMode is strict, let thisValue be thisArgument.
@@ -106,7 +106,8 @@ private:
     }
 
 public:
-    template <typename FunctionObjectType, bool isConstructCall, bool hasNewTargetOnEnvironment, bool canBindThisValueOnEnvironment, typename ThisValueBinder, typename NewTargetBinder, typename ReturnValueBinder>
+    // isEnvironmentOnStack is true when caller already knows that environment of callee can be allocated on stack
+    template <typename FunctionObjectType, bool isConstructCall, bool hasNewTargetOnEnvironment, bool canBindThisValueOnEnvironment, typename ThisValueBinder, typename NewTargetBinder, typename ReturnValueBinder, bool isEnvironmentOnStack = false>
     static ALWAYS_INLINE Value processCall(ExecutionState& state, FunctionObjectType* self, const Value& thisArgument, const size_t argc, Value* argv, Object* newTarget) // newTarget is null on [[call]]
     {
         volatile int sp;
@@ -129,7 +130,8 @@ public:
         }
 
         ByteCodeBlock* blk = codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
-        Context* ctx = codeBlock->context();
+        Context* ctx = self->m_realm;
+        blk->m_age = 0;
         bool isStrict = codeBlock->isStrict();
         size_t registerSize = blk->m_requiredRegisterFileSizeInValueSize;
         size_t identifierOnStackCount = codeBlock->asInterpretedCodeBlock()->identifierOnStackCount();
@@ -141,7 +143,7 @@ public:
         FunctionEnvironmentRecord* record;
         LexicalEnvironment* lexEnv;
 
-        if (LIKELY(codeBlock->canAllocateEnvironmentOnStack())) {
+        if (isEnvironmentOnStack || LIKELY(codeBlock->canAllocateEnvironmentOnStack())) {
             // no capture, very simple case
             record = new (alloca(sizeof(FunctionEnvironmentRecord))) FunctionEnvironmentRecordOnStack<canBindThisValueOnEnvironment, hasNewTargetOnEnvironment>(self);
             lexEnv = new (alloca(sizeof(LexicalEnvironment))) LexicalEnvironment(record, self->outerEnvironment()
@@ -266,6 +268,15 @@ public:
 
         return returnValue;
     }
+
+    // [[Call]] of plain function whose environment can be allocated on stack
+    // it is processCall<ScriptFunctionObject, false, false, false, ...> without the environment check
+    template <typename FunctionObjectType>
+    static ALWAYS_INLINE Value processCallWithEnvironmentOnStack(ExecutionState& state, FunctionObjectType* self, const Value& thisArgument, const size_t argc, Value* argv)
+    {
+        ASSERT(self->codeBlock()->canAllocateEnvironmentOnStack());
+        return processCall<FunctionObjectType, false, false, false, FunctionObjectThisValueBinder, FunctionObjectNewTargetBinder, FunctionObjectReturnValueBinder, true>(state, self, thisArgument, argc, argv, nullptr);
+    }
 };
 }
 
@@ -1117,6 +1117,81 @@ void GlobalObject::installOthers(ExecutionState& state)
     m_generator->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().arguments), desc);
 }
 
+static ObjectPropertyNativeGetterSetterData lazyBuiltinGetterSetterData(
+    true, false, true, &GlobalObject::lazyBuiltinNativeGetter, &GlobalObject::lazyBuiltinNativeSetter);
+
+static AtomicString lazyBuiltinName(ExecutionState& state, GlobalObject::LazyBuiltin kind)
+{
+    switch (kind) {
+#define RETURN_LAZY_BUILTIN_NAME(name, member) \
+    case GlobalObject::LazyBuiltin##name:      \
+        return state.context()->staticStrings().name;
+        FOR_EACH_LAZY_BUILTIN(RETURN_LAZY_BUILTIN_NAME)
+#undef RETURN_LAZY_BUILTIN_NAME
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void GlobalObject::defineLazyBuiltinProperty(ExecutionState& state, LazyBuiltin kind)
+{
+    defineNativeDataAccessorProperty(state, ObjectPropertyName(lazyBuiltinName(state, kind)), &lazyBuiltinGetterSetterData, Value((int32_t)kind));
+}
+
+Value GlobalObject::lazyBuiltinNativeGetter(ExecutionState& state, Object* self, const SmallValue& privateDataFromObjectPrivateArea)
+{
+    GlobalObject* globalObject = self->asGlobalObject();
+    LazyBuiltin kind = (LazyBuiltin)Value(privateDataFromObjectPrivateArea).asInt32();
+    Value builtin = globalObject->installLazyBuiltin(state, kind);
+    globalObject->resolveLazyBuiltinProperty(state, kind, builtin);
+    return builtin;
+}
+
+bool GlobalObject::lazyBuiltinNativeSetter(ExecutionState& state, Object* self, SmallValue& privateDataFromObjectPrivateArea, const Value& setterInputData)
+{
+    LazyBuiltin kind = (LazyBuiltin)Value(privateDataFromObjectPrivateArea).asInt32();
+    self->asGlobalObject()->resolveLazyBuiltinProperty(state, kind, setterInputData);
+    return true;
+}
+
+void GlobalObject::installLazyBuiltin(LazyBuiltin kind)
+{
+    ExecutionState state(m_context);
+    installLazyBuiltin(state, kind);
+}
+
+Object* GlobalObject::installLazyBuiltin(ExecutionState& state, LazyBuiltin kind)
+{
+    // state may come from another realm (e.g. otherGlobal.Map)
+    ExecutionState stateForInstall(m_context, state.stackLimit());
+    switch (kind) {
+#define INSTALL_LAZY_BUILTIN(name, member)                   \
+    case LazyBuiltin##name:                                  \
+        if (!member) {                                       \
+            install##name(stateForInstall);                  \
+            convertBuiltinObjectsToNonTransitionStructure(); \
+        }                                                    \
+        return member;
+        FOR_EACH_LAZY_BUILTIN(INSTALL_LAZY_BUILTIN)
+#undef INSTALL_LAZY_BUILTIN
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void GlobalObject::resolveLazyBuiltinProperty(ExecutionState& state, LazyBuiltin kind, const Value& value)
+{
+    // keep attributes which could be changed by defineProperty before resolving
+    auto findResult = structure()->findProperty(lazyBuiltinName(state, kind));
+    ASSERT(findResult.first != SIZE_MAX);
+    ASSERT(findResult.second.value()->m_descriptor.isNativeAccessorProperty());
+    size_t attributes = findResult.second.value()->m_descriptor.nativeGetterSetterData()->m_presentAttributes;
+    // global object can be in prototype chain of other objects (e.g. with Object.create(globalThis))
+    invalidatePrototypeValidityCell();
+    m_structure = m_structure->replacePropertyDescriptor(findResult.first, ObjectStructurePropertyDescriptor::createDataDescriptor((ObjectStructurePropertyDescriptor::PresentAttribute)attributes));
+    m_values[findResult.first] = value;
+}
+
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
 static String* icuLocaleToBCP47Tag(String* string)
 {
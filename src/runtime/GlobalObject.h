@@ -42,12 +42,36 @@ class FunctionObject;
 
 Value builtinSpeciesGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
 
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+#define FOR_EACH_LAZY_BUILTIN_INTL(F) F(Intl, m_intl)
+#else
+#define FOR_EACH_LAZY_BUILTIN_INTL(F)
+#endif
+
+// builtins which are installed on the first access of their global property
+// F(name of global property and install function, member which is set first while installing)
+#define FOR_EACH_LAZY_BUILTIN(F)  \
+    FOR_EACH_LAZY_BUILTIN_INTL(F) \
+    F(Proxy, m_proxy)             \
+    F(Reflect, m_reflect)         \
+    F(DataView, m_dataView)       \
+    F(Map, m_map)                 \
+    F(Set, m_set)                 \
+    F(WeakMap, m_weakMap)         \
+    F(WeakSet, m_weakSet)
+
 class GlobalObject : public Object {
 public:
     friend class ByteCodeInterpreter;
     friend class GlobalEnvironmentRecord;
     friend class IdentifierNode;
 
+    enum LazyBuiltin {
+#define DECLARE_LAZY_BUILTIN(name, member) LazyBuiltin##name,
+        FOR_EACH_LAZY_BUILTIN(DECLARE_LAZY_BUILTIN)
+#undef DECLARE_LAZY_BUILTIN
+    };
+
     explicit GlobalObject(ExecutionState& state)
         : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, false)
         , m_context(state.context())
@@ -160,7 +184,7 @@ public:
     {
         m_objectPrototype = Object::createBuiltinObjectPrototype(state);
         m_objectPrototype->markAsPrototypeObject(state);
-        m_objectPrototype->markThisObjectDontNeedStructureTransitionTable();
+        markBuiltinObjectDontNeedStructureTransitionTable(m_objectPrototype);
         Object::setPrototype(state, m_objectPrototype);
 
         m_structure = m_structure->convertToNonTransitionStructure();
@@ -187,25 +211,53 @@ public:
         installRegExp(state);
         installJSON(state);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-        installIntl(state);
+        defineLazyBuiltinProperty(state, LazyBuiltinIntl);
 #endif
         installPromise(state);
-        installProxy(state);
-        installReflect(state);
-        installDataView(state);
+        defineLazyBuiltinProperty(state, LazyBuiltinProxy);
+        defineLazyBuiltinProperty(state, LazyBuiltinReflect);
+        defineLazyBuiltinProperty(state, LazyBuiltinDataView);
         installTypedArray(state);
-        installMap(state);
-        installSet(state);
-        installWeakMap(state);
-        installWeakSet(state);
+        defineLazyBuiltinProperty(state, LazyBuiltinMap);
+        defineLazyBuiltinProperty(state, LazyBuiltinSet);
+        defineLazyBuiltinProperty(state, LazyBuiltinWeakMap);
+        defineLazyBuiltinProperty(state, LazyBuiltinWeakSet);
         installGenerator(state);
         installAsyncFunction(state);
         installAsyncIterator(state);
         installAsyncFromSyncIterator(state);
         installAsyncGeneratorFunction(state);
         installOthers(state);
+
+        convertBuiltinObjectsToNonTransitionStructure();
     }
 
+    // Builtin objects stay in transition mode until installBuiltins ends.
+    // Transition chains of default structures are shared by every Context of a VMInstance,
+    // so the first Context records the structures of builtin objects and later Contexts
+    // just follow the chains instead of allocating a new structure for each property.
+    // After installing, each object is converted to non-transition structure at once.
+    void markBuiltinObjectDontNeedStructureTransitionTable(Object* obj)
+    {
+        m_builtinObjectsOnTransitionChain.pushBack(obj);
+    }
+
+    void convertBuiltinObjectsToNonTransitionStructure()
+    {
+        for (size_t i = 0; i < m_builtinObjectsOnTransitionChain.size(); i++) {
+            m_builtinObjectsOnTransitionChain[i]->markThisObjectDontNeedStructureTransitionTable();
+        }
+        m_builtinObjectsOnTransitionChain.clear();
+    }
+
+    // The global property of a lazy builtin starts as a native data accessor.
+    // Reading it installs the builtin and turns the property into a plain data property,
+    // so GlobalVariableAccessCache only caches the property after that.
+    // Writing it just stores the new value without installing.
+    void defineLazyBuiltinProperty(ExecutionState& state, LazyBuiltin kind);
+    static Value lazyBuiltinNativeGetter(ExecutionState& state, Object* self, const SmallValue& privateDataFromObjectPrivateArea);
+    static bool lazyBuiltinNativeSetter(ExecutionState& state, Object* self, SmallValue& privateDataFromObjectPrivateArea, const Value& setterInputData);
+
     void installFunction(ExecutionState& state);
     void installObject(ExecutionState& state);
     void installError(ExecutionState& state);
@@ -445,11 +497,17 @@ public:
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
     Object* intl()
     {
+        if (UNLIKELY(!m_intl)) {
+            installLazyBuiltin(LazyBuiltinIntl);
+        }
         return m_intl;
     }
 
     FunctionObject* intlCollator()
     {
+        if (UNLIKELY(!m_intl)) {
+            installLazyBuiltin(LazyBuiltinIntl);
+        }
         return m_intlCollator;
     }
 
@@ -457,6 +515,9 @@ public:
 
     FunctionObject* intlDateTimeFormat()
     {
+        if (UNLIKELY(!m_intl)) {
+            installLazyBuiltin(LazyBuiltinIntl);
+        }
         return m_intlDateTimeFormat;
     }
 
@@ -464,6 +525,9 @@ public:
 
     FunctionObject* intlNumberFormat()
     {
+        if (UNLIKELY(!m_intl)) {
+            installLazyBuiltin(LazyBuiltinIntl);
+        }
         return m_intlNumberFormat;
     }
 
@@ -479,6 +543,9 @@ public:
     }
     FunctionObject* proxy()
     {
+        if (UNLIKELY(!m_proxy)) {
+            installLazyBuiltin(LazyBuiltinProxy);
+        }
         return m_proxy;
     }
     FunctionObject* arrayBuffer()
@@ -491,10 +558,16 @@ public:
     }
     FunctionObject* dataView()
     {
+        if (UNLIKELY(!m_dataView)) {
+            installLazyBuiltin(LazyBuiltinDataView);
+        }
         return m_dataView;
     }
     Object* dataViewPrototype()
     {
+        if (UNLIKELY(!m_dataView)) {
+            installLazyBuiltin(LazyBuiltinDataView);
+        }
         return m_dataViewPrototype;
     }
     Object* typedArray()
@@ -580,51 +653,81 @@ public:
 
     FunctionObject* map()
     {
+        if (UNLIKELY(!m_map)) {
+            installLazyBuiltin(LazyBuiltinMap);
+        }
         return m_map;
     }
 
     Object* mapPrototype()
     {
+        if (UNLIKELY(!m_map)) {
+            installLazyBuiltin(LazyBuiltinMap);
+        }
         return m_mapPrototype;
     }
 
     Object* mapIteratorPrototype()
     {
+        if (UNLIKELY(!m_map)) {
+            installLazyBuiltin(LazyBuiltinMap);
+        }
         return m_mapIteratorPrototype;
     }
 
     FunctionObject* set()
     {
+        if (UNLIKELY(!m_set)) {
+            installLazyBuiltin(LazyBuiltinSet);
+        }
         return m_set;
     }
 
     Object* setPrototype()
     {
+        if (UNLIKELY(!m_set)) {
+            installLazyBuiltin(LazyBuiltinSet);
+        }
         return m_setPrototype;
     }
 
     Object* setIteratorPrototype()
     {
+        if (UNLIKELY(!m_set)) {
+            installLazyBuiltin(LazyBuiltinSet);
+        }
         return m_setIteratorPrototype;
     }
 
     FunctionObject* weakMap()
     {
+        if (UNLIKELY(!m_weakMap)) {
+            installLazyBuiltin(LazyBuiltinWeakMap);
+        }
         return m_weakMap;
     }
 
     Object* weakMapPrototype()
     {
+        if (UNLIKELY(!m_weakMap)) {
+            installLazyBuiltin(LazyBuiltinWeakMap);
+        }
         return m_weakMapPrototype;
     }
 
     FunctionObject* weakSet()
     {
+        if (UNLIKELY(!m_weakSet)) {
+            installLazyBuiltin(LazyBuiltinWeakSet);
+        }
         return m_weakSet;
     }
 
     Object* weakSetPrototype()
     {
+        if (UNLIKELY(!m_weakSet)) {
+            installLazyBuiltin(LazyBuiltinWeakSet);
+        }
         return m_weakSetPrototype;
     }
 
@@ -732,6 +835,11 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
+    // accessors of members below call this when the builtin is not installed yet
+    NEVER_INLINE void installLazyBuiltin(LazyBuiltin kind);
+    Object* installLazyBuiltin(ExecutionState& state, LazyBuiltin kind);
+    void resolveLazyBuiltinProperty(ExecutionState& state, LazyBuiltin kind, const Value& value);
+
     Context* m_context;
 
     FunctionObject* m_object;
@@ -871,6 +979,9 @@ private:
     Object* m_asyncGenerator; // %AsyncGenerator%
     Object* m_asyncGeneratorPrototype; // %AsyncGeneratorPrototype%
     FunctionObject* m_asyncGeneratorFunction; // %AsyncGeneratorFunction%
+
+    // builtin objects which are still on the shared structure transition chains while installing builtins
+    Vector<Object*, GCUtil::gc_malloc_allocator<Object*>> m_builtinObjectsOnTransitionChain;
 };
 }
 
@@ -58,7 +58,7 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         if (argc > 1 || !val.isInt32()) {
             if (array->isFastModeArray()) {
                 for (size_t idx = 0; idx < argc; idx++) {
-                    array->m_fastModeData[idx] = argv[idx];
+                    array->setFastModeArrayValue(idx, argv[idx]);
                 }
             } else {
                 for (size_t idx = 0; idx < argc; idx++) {
@@ -1891,7 +1891,7 @@ public:
 void GlobalObject::installArray(ExecutionState& state)
 {
     m_array = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().Array, builtinArrayConstructor, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_array->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_array);
     m_array->setPrototype(state, m_functionPrototype);
 
     {
@@ -1903,7 +1903,7 @@ void GlobalObject::installArray(ExecutionState& state)
 
     m_arrayPrototype = m_objectPrototype;
     m_arrayPrototype = new ArrayObjectPrototype(state);
-    m_arrayPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_arrayPrototype);
     m_arrayPrototype->setPrototype(state, m_objectPrototype);
     m_arrayPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_array, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
@@ -250,7 +250,7 @@ void GlobalObject::installAsyncFromSyncIterator(ExecutionState& state)
 {
     // https://www.ecma-international.org/ecma-262/10.0/#sec-%asyncfromsynciteratorprototype%-object
     m_asyncFromSyncIteratorPrototype = new Object(state);
-    m_asyncFromSyncIteratorPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_asyncFromSyncIteratorPrototype);
 
     m_asyncFromSyncIteratorPrototype->setPrototype(state, m_asyncIteratorPrototype);
 
@@ -38,7 +38,7 @@ static Value builtinAsyncFunction(ExecutionState& state, Value thisValue, size_t
 void GlobalObject::installAsyncFunction(ExecutionState& state)
 {
     m_asyncFunction = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().AsyncFunction, builtinAsyncFunction, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_asyncFunction->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_asyncFunction);
     m_asyncFunction->setPrototype(state, m_function);
 
     m_asyncFunctionPrototype = new Object(state);
@@ -53,7 +53,7 @@ void GlobalObject::installAsyncGeneratorFunction(ExecutionState& state)
 {
     // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-asyncgeneratorfunction
     m_asyncGeneratorFunction = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().AsyncGeneratorFunction, builtinAsyncGeneratorFunction, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_asyncGeneratorFunction->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_asyncGeneratorFunction);
     m_asyncGeneratorFunction->setPrototype(state, m_function);
 
     // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-properties-of-asyncgeneratorfunction-prototype
@@ -70,7 +70,7 @@ void GlobalObject::installAsyncGeneratorFunction(ExecutionState& state)
 
     // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-properties-of-asyncgenerator-prototype
     m_asyncGeneratorPrototype = new Object(state);
-    m_asyncGeneratorPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_asyncGeneratorPrototype);
     m_asyncGeneratorPrototype->setPrototype(state, m_asyncIteratorPrototype);
 
     m_asyncGenerator->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().prototype), ObjectPropertyDescriptor(m_asyncGeneratorPrototype, ObjectPropertyDescriptor::ConfigurablePresent));
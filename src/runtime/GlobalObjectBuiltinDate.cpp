@@ -553,11 +553,11 @@ static Value builtinDateToPrimitive(ExecutionState& state, Value thisValue, size
 void GlobalObject::installDate(ExecutionState& state)
 {
     m_date = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().Date, builtinDateConstructor, 7), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_date->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_date);
     m_date->setPrototype(state, m_functionPrototype);
     m_datePrototype = m_objectPrototype;
     m_datePrototype = new DatePrototypeObject(state);
-    m_datePrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_datePrototype);
     m_datePrototype->setPrototype(state, m_objectPrototype);
 
     m_datePrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_date, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -26,6 +26,7 @@
 #include "runtime/ScriptFunctionObject.h"
 #include "runtime/ScriptClassConstructorFunctionObject.h"
 #include "parser/Lexer.h"
+#include "parser/Script.h"
 
 namespace Escargot {
 
@@ -64,7 +65,9 @@ static Value builtinFunctionToString(ExecutionState& state, Value thisValue, siz
             return fn->asScriptFunctionObject()->asScriptClassConstructorFunctionObject()->classSourceCode();
         } else {
             StringBuilder builder;
-            if (fn->codeBlock()->isInterpretedCodeBlock() && fn->codeBlock()->asInterpretedCodeBlock()->script() != nullptr) {
+            Script* script = fn->codeBlock()->isInterpretedCodeBlock() ? fn->codeBlock()->asInterpretedCodeBlock()->script() : nullptr;
+            // functions loaded from bundle have no source
+            if (script && script->hasSourceCode()) {
                 StringView src = fn->codeBlock()->asInterpretedCodeBlock()->src();
                 while (src.length() && EscargotLexer::isWhiteSpaceOrLineTerminator(src[src.length() - 1])) {
                     src = StringView(src, 0, src.length() - 1);
@@ -205,10 +208,10 @@ void GlobalObject::installFunction(ExecutionState& state)
 
     m_functionPrototype = emptyFunction;
     m_functionPrototype->setPrototype(state, m_objectPrototype);
-    m_functionPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_functionPrototype);
 
     m_function = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().Function, builtinFunctionConstructor, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_function->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_function);
 
     m_function->setPrototype(state, emptyFunction);
     m_function->setFunctionPrototype(state, emptyFunction);
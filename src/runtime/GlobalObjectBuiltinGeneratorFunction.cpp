@@ -55,7 +55,7 @@ void GlobalObject::installGenerator(ExecutionState& state)
 {
     // %GeneratorFunction% : The constructor of generator objects
     m_generatorFunction = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().GeneratorFunction, builtinGeneratorFunction, 0), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_generatorFunction->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_generatorFunction);
     m_generatorFunction->setPrototype(state, m_functionPrototype);
 
     // %Generator% : The initial value of the prototype property of %GeneratorFunction%
@@ -79,7 +79,7 @@ void GlobalObject::installGenerator(ExecutionState& state)
                                                   ObjectPropertyDescriptor(Value(state.context()->staticStrings().GeneratorFunction.string()), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::NonWritablePresent | ObjectPropertyDescriptor::NonEnumerablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_generatorPrototype->setPrototype(state, m_iteratorPrototype);
-    m_generatorPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_generatorPrototype);
     // The initial value of Generator.prototype.constructor is the intrinsic object %Generator%.
     m_generatorPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_generator, ObjectPropertyDescriptor::ConfigurablePresent));
 
@@ -443,11 +443,9 @@ static Value builtinIntlGetCanonicalLocales(ExecutionState& state, Value thisVal
 void GlobalObject::installIntl(ExecutionState& state)
 {
     m_intl = new Object(state);
-    m_intl->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_intl);
 
     const StaticStrings* strings = &state.context()->staticStrings();
-    defineOwnProperty(state, ObjectPropertyName(strings->Intl),
-                      ObjectPropertyDescriptor(m_intl, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_intlCollator = new NativeFunctionObject(state, NativeFunctionInfo(strings->Collator, builtinIntlCollatorConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
 
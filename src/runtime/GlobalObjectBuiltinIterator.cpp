@@ -34,7 +34,7 @@ static Value builtinIteratorIterator(ExecutionState& state, Value thisValue, siz
 void GlobalObject::installIterator(ExecutionState& state)
 {
     m_iteratorPrototype = new Object(state);
-    m_iteratorPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_iteratorPrototype);
 
     // https://www.ecma-international.org/ecma-262/10.0/index.html#sec-%iteratorprototype%-@@iterator
     FunctionObject* fn = new NativeFunctionObject(state, NativeFunctionInfo(AtomicString(state, String::fromASCII("[Symbol.iterator]")), builtinIteratorIterator, 0, NativeFunctionInfo::Strict));
@@ -197,7 +197,7 @@ static Value builtinMapIteratorNext(ExecutionState& state, Value thisValue, size
 void GlobalObject::installMap(ExecutionState& state)
 {
     m_map = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().Map, builtinMapConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_map->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_map);
     m_map->setPrototype(state, m_functionPrototype);
 
     {
@@ -209,7 +209,7 @@ void GlobalObject::installMap(ExecutionState& state)
 
     m_mapPrototype = m_objectPrototype;
     m_mapPrototype = new MapObject(state);
-    m_mapPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_mapPrototype);
     m_mapPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_map, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_mapPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().clear),
@@ -263,7 +263,5 @@ void GlobalObject::installMap(ExecutionState& state)
 
 
     m_map->setFunctionPrototype(state, m_mapPrototype);
-    defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().Map),
-                      ObjectPropertyDescriptor(m_map, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 }
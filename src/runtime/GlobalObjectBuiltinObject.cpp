@@ -659,7 +659,7 @@ void GlobalObject::installObject(ExecutionState& state)
 
     FunctionObject* emptyFunction = m_functionPrototype;
     m_object = new NativeFunctionObject(state, NativeFunctionInfo(strings.Object, builtinObjectConstructor, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_object->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_object);
     m_object->setPrototype(state, emptyFunction);
     m_object->setFunctionPrototype(state, m_objectPrototype);
     // $19.1.2.2 Object.create (O [,Properties])
@@ -311,9 +311,8 @@ static Value builtinReflectSetPrototypeOf(ExecutionState& state, Value thisValue
 
 void GlobalObject::installReflect(ExecutionState& state)
 {
-    const StaticStrings* strings = &state.context()->staticStrings();
     m_reflect = new Object(state);
-    m_reflect->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_reflect);
 
     m_reflect->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().apply),
                                                 ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().apply, builtinReflectApply, 3, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -353,8 +352,5 @@ void GlobalObject::installReflect(ExecutionState& state)
 
     m_reflect->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().setPrototypeOf),
                                                 ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().setPrototypeOf, builtinReflectSetPrototypeOf, 2, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
-
-    defineOwnProperty(state, ObjectPropertyName(strings->Reflect),
-                      ObjectPropertyDescriptor(m_reflect, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 } // namespace Escargot
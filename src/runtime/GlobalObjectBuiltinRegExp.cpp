@@ -612,7 +612,7 @@ public:
 void GlobalObject::installRegExp(ExecutionState& state)
 {
     m_regexp = new GlobalRegExpFunctionObject(state);
-    m_regexp->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_regexp);
     m_regexp->setPrototype(state, m_functionPrototype);
 
     {
@@ -624,7 +624,7 @@ void GlobalObject::installRegExp(ExecutionState& state)
 
     m_regexpPrototype = m_objectPrototype;
     m_regexpPrototype = new RegExpObjectPrototype(state);
-    m_regexpPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_regexpPrototype);
     m_regexpPrototype->setPrototype(state, m_objectPrototype);
     m_regexpPrototype->deleteOwnProperty(state, state.context()->staticStrings().lastIndex);
 
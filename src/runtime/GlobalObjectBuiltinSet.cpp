@@ -181,7 +181,7 @@ static Value builtinSetIteratorNext(ExecutionState& state, Value thisValue, size
 void GlobalObject::installSet(ExecutionState& state)
 {
     m_set = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().Set, builtinSetConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_set->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_set);
     m_set->setPrototype(state, m_functionPrototype);
 
     {
@@ -193,7 +193,7 @@ void GlobalObject::installSet(ExecutionState& state)
 
     m_setPrototype = m_objectPrototype;
     m_setPrototype = new SetPrototypeObject(state);
-    m_setPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_setPrototype);
     m_setPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_set, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_setPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().clear),
@@ -240,7 +240,5 @@ void GlobalObject::installSet(ExecutionState& state)
                                                              ObjectPropertyDescriptor(Value(String::fromASCII("Set Iterator")), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_set->setFunctionPrototype(state, m_setPrototype);
-    defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().Set),
-                      ObjectPropertyDescriptor(m_set, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 } // namespace Escargot
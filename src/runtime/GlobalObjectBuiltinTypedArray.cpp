@@ -1587,11 +1587,11 @@ FunctionObject* GlobalObject::installTypedArray(ExecutionState& state, AtomicStr
 {
     const StaticStrings* strings = &state.context()->staticStrings();
     NativeFunctionObject* taConstructor = new NativeFunctionObject(state, NativeFunctionInfo(taName, builtinTypedArrayConstructor<TA, elementSize, TypeAdaptor>, 3), NativeFunctionObject::__ForBuiltinConstructor__);
-    taConstructor->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(taConstructor);
 
     *proto = m_objectPrototype;
     Object* taPrototype = new TypedArrayObjectPrototype(state);
-    taPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(taPrototype);
     taPrototype->setPrototype(state, typedArrayFunction->getFunctionPrototype(state));
 
     taConstructor->setPrototype(state, typedArrayFunction); // %TypedArray%
@@ -1648,7 +1648,7 @@ static Value builtinTypedArrayToStringTagGetter(ExecutionState& state, Value thi
 void GlobalObject::installTypedArray(ExecutionState& state)
 {
     m_arrayBuffer = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().ArrayBuffer, builtinArrayBufferConstructor, 1), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_arrayBuffer->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_arrayBuffer);
     m_arrayBuffer->setPrototype(state, m_functionPrototype);
     m_arrayBuffer->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().isView),
                                      ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().isView, builtinArrayBufferIsView, 1, NativeFunctionInfo::Strict)),
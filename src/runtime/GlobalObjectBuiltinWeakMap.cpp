@@ -141,11 +141,11 @@ static Value builtinWeakMapSet(ExecutionState& state, Value thisValue, size_t ar
 void GlobalObject::installWeakMap(ExecutionState& state)
 {
     m_weakMap = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().WeakMap, builtinWeakMapConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_weakMap->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_weakMap);
     m_weakMap->setPrototype(state, m_functionPrototype);
     m_weakMapPrototype = m_objectPrototype;
     m_weakMapPrototype = new WeakMapObject(state);
-    m_weakMapPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_weakMapPrototype);
     m_weakMapPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_weakMap, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_weakMapPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().stringDelete),
@@ -164,7 +164,5 @@ void GlobalObject::installWeakMap(ExecutionState& state)
                                                          ObjectPropertyDescriptor(Value(state.context()->staticStrings().WeakMap.string()), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_weakMap->setFunctionPrototype(state, m_weakMapPrototype);
-    defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().WeakMap),
-                      ObjectPropertyDescriptor(m_weakMap, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 }
@@ -126,11 +126,11 @@ static Value builtinWeakSetHas(ExecutionState& state, Value thisValue, size_t ar
 void GlobalObject::installWeakSet(ExecutionState& state)
 {
     m_weakSet = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().WeakSet, builtinWeakSetConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
-    m_weakSet->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_weakSet);
     m_weakSet->setPrototype(state, m_functionPrototype);
     m_weakSetPrototype = m_objectPrototype;
     m_weakSetPrototype = new WeakSetPrototypeObject(state);
-    m_weakSetPrototype->markThisObjectDontNeedStructureTransitionTable();
+    markBuiltinObjectDontNeedStructureTransitionTable(m_weakSetPrototype);
     m_weakSetPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_weakSet, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_weakSetPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().stringDelete),
@@ -146,7 +146,5 @@ void GlobalObject::installWeakSet(ExecutionState& state)
                                                          ObjectPropertyDescriptor(Value(state.context()->staticStrings().WeakSet.string()), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_weakSet->setFunctionPrototype(state, m_weakSetPrototype);
-    defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().WeakSet),
-                      ObjectPropertyDescriptor(m_weakSet, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 }
@@ -97,6 +97,7 @@ ObjectRareData::ObjectRareData(Object* obj)
     m_hasNonWritableLastIndexRegexpObject = false;
     m_arrayObjectFastModeBufferExpandCount = 0;
     m_extraData = nullptr;
+    m_prototypeValidityCell = nullptr;
     m_internalSlot = nullptr;
 }
 
@@ -108,6 +109,7 @@ void* ObjectRareData::operator new(size_t size)
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectRareData)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_prototype));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_extraData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_prototypeValidityCell));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_internalSlot));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectRareData));
         typeInited = true;
@@ -115,6 +117,34 @@ void* ObjectRareData::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+void PrototypeValidityCell::addDependentCell(PrototypeValidityCell* cell)
+{
+    ASSERT(m_isValid);
+    // drop cells invalidated by their owners
+    size_t j = 0;
+    for (size_t i = 0; i < m_dependentCells.size(); i++) {
+        if (m_dependentCells[i]->isValid()) {
+            m_dependentCells[j++] = m_dependentCells[i];
+        }
+    }
+    if (j != m_dependentCells.size()) {
+        m_dependentCells.erase(j, m_dependentCells.size());
+    }
+    m_dependentCells.pushBack(cell);
+}
+
+void PrototypeValidityCell::invalidate()
+{
+    if (!m_isValid) {
+        return;
+    }
+    m_isValid = false;
+    for (size_t i = 0; i < m_dependentCells.size(); i++) {
+        m_dependentCells[i]->invalidate();
+    }
+    m_dependentCells.clear();
+}
+
 Value ObjectGetResult::valueSlowCase(ExecutionState& state, const Value& receiver) const
 {
 #ifdef ESCARGOT_32
@@ -440,6 +470,62 @@ Object::Object(ExecutionState& state)
     initPlainObject(state);
 }
 
+COMPILE_ASSERT(((sizeof(Object) + sizeof(size_t)) / sizeof(size_t)) % 2 == 1, "inline slots should not start at GC granule boundary");
+
+Object* Object::createWithInlineSlots(ExecutionState& state, size_t inlineSlotCount)
+{
+    ASSERT(inlineSlotCount > 0);
+    void* buffer = GC_MALLOC(sizeof(Object) + sizeof(size_t) + sizeof(SmallValue) * inlineSlotCount);
+    Object* obj = new (buffer) Object(state);
+    ASSERT(!obj->m_values.data());
+    size_t* header = obj->inlineSlotHeader();
+    *header = inlineSlotCount;
+    obj->m_values.referExternalBuffer((SmallValue*)(header + 1));
+    return obj;
+}
+
+Object* Object::createWithStructure(ExecutionState& state, ObjectStructure* structure)
+{
+    ASSERT(structure->inTransitionMode());
+    Object* obj = createWithInlineSlots(state, structure->propertyCount());
+    obj->m_structure = structure;
+    return obj;
+}
+
+Object* ObjectAllocationSite::allocateWhileSlackTracking(ExecutionState& state)
+{
+    if (m_lastInstance) {
+        size_t count = m_lastInstance->structure()->propertyCount();
+        if (count > MaxInlineSlotCount) {
+            count = MaxInlineSlotCount;
+        }
+        if (count > m_inlineSlotCount) {
+            m_inlineSlotCount = count;
+        }
+        m_lastInstance = nullptr;
+    }
+
+    m_trackedInstanceCount++;
+    if (m_trackedInstanceCount > SlackTrackingInstanceCount) {
+        // slack tracking is done
+        return allocate(state);
+    }
+
+    m_lastInstance = Object::createWithInlineSlots(state, MaxInlineSlotCount);
+    return m_lastInstance;
+}
+
+void ObjectAllocationSite::setPrototypeOfInstance(ExecutionState& state, Object* obj, const Value& functionPrototype, Context* realm)
+{
+    if (!functionPrototype.isObject()) {
+        obj->setPrototype(state, realm->globalObject()->objectPrototype());
+        return;
+    }
+
+    obj->setPrototype(state, functionPrototype);
+    m_prototype = functionPrototype.asObject();
+}
+
 // https://www.ecma-international.org/ecma-262/6.0/#sec-isconcatspreadable
 bool Object::isConcatSpreadable(ExecutionState& state)
 {
@@ -485,6 +571,7 @@ void Object::setPrototypeForIntrinsicObjectCreation(ExecutionState& state, Objec
 {
     o->ensureObjectRareData()->m_isEverSetAsPrototypeObject = true;
 
+    invalidatePrototypeValidityCell();
     if (rareData()) {
         rareData()->m_prototype = o;
     } else {
@@ -539,6 +626,7 @@ bool Object::setPrototype(ExecutionState& state, const Value& proto)
         o->markAsPrototypeObject(state);
     }
 
+    invalidatePrototypeValidityCell();
     if (rareData()) {
         rareData()->m_prototype = o;
     } else {
@@ -549,6 +637,29 @@ bool Object::setPrototype(ExecutionState& state, const Value& proto)
     return true;
 }
 
+PrototypeValidityCell* Object::ensurePrototypeValidityCell(ExecutionState& state)
+{
+    ASSERT(isInlineCacheable());
+    ObjectRareData* data = ensureObjectRareData();
+    // cell can be invalidated by one of prototypes while this object keeps it,
+    // and an invalid cell never becomes valid again, so it is replaced
+    if (!data->m_prototypeValidityCell || !data->m_prototypeValidityCell->isValid()) {
+        // structure of object with validity cell is not shared with other objects,
+        // so property addition through transition cache never happens on it
+        if (m_structure->inTransitionMode()) {
+            m_structure = m_structure->convertToNonTransitionStructure();
+        }
+
+        PrototypeValidityCell* cell = new PrototypeValidityCell();
+        Object* proto = Object::getPrototypeObject(state);
+        if (proto && proto->isInlineCacheable()) {
+            proto->ensurePrototypeValidityCell(state)->addDependentCell(cell);
+        }
+        data->m_prototypeValidityCell = cell;
+    }
+    return data->m_prototypeValidityCell;
+}
+
 void Object::markAsPrototypeObject(ExecutionState& state)
 {
     ensureObjectRareData();
@@ -572,7 +683,7 @@ ObjectGetResult Object::getOwnProperty(ExecutionState& state, const ObjectProper
         auto presentAttributes = desc.descriptorData().presentAttributes();
         if (desc.isDataProperty()) {
             if (LIKELY(!desc.isNativeAccessorProperty())) {
-                return ObjectGetResult(m_values[findResult.first], presentAttributes & ObjectStructurePropertyDescriptor::WritablePresent, presentAttributes & ObjectStructurePropertyDescriptor::EnumerablePresent, presentAttributes & ObjectStructurePropertyDescriptor::ConfigurablePresent);
+                return ObjectGetResult(readDataSlot(findResult.first, desc), presentAttributes & ObjectStructurePropertyDescriptor::WritablePresent, presentAttributes & ObjectStructurePropertyDescriptor::EnumerablePresent, presentAttributes & ObjectStructurePropertyDescriptor::ConfigurablePresent);
             } else {
                 ObjectPropertyNativeGetterSetterData* data = desc.nativeGetterSetterData();
                 return ObjectGetResult(data->m_getter(state, this, m_values[findResult.first]), presentAttributes & ObjectStructurePropertyDescriptor::WritablePresent, presentAttributes & ObjectStructurePropertyDescriptor::EnumerablePresent, presentAttributes & ObjectStructurePropertyDescriptor::ConfigurablePresent);
@@ -603,15 +714,27 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
             return false;
         }
 
+        invalidatePrototypeValidityCell();
         auto structureBefore = m_structure;
-        m_structure = m_structure->addProperty(propertyName, desc.toObjectStructurePropertyDescriptor());
-        ASSERT(structureBefore != m_structure);
         if (LIKELY(desc.isDataProperty())) {
             const Value& val = desc.isValuePresent() ? desc.value() : Value();
-            m_values.pushBack(val, m_structure->propertyCount());
+            ObjectStructurePropertyDescriptor newDesc = desc.toObjectStructurePropertyDescriptor();
+#if defined(ESCARGOT_64)
+            // global object keeps SmallValue in every slot because global variable access caches read its slots directly
+            if (val.isNumber() && newDesc.isWritable() && !isGlobalObject()) {
+                m_structure = m_structure->addProperty(propertyName, newDesc.toDoubleRepresentation());
+                ASSERT(structureBefore != m_structure);
+                appendValueSlot(SmallValue::fromUnboxedDouble(val.asNumber()), m_structure->propertyCount());
+                return true;
+            }
+#endif
+            m_structure = m_structure->addProperty(propertyName, newDesc);
+            appendValueSlot(val, m_structure->propertyCount());
         } else {
-            m_values.pushBack(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
+            m_structure = m_structure->addProperty(propertyName, desc.toObjectStructurePropertyDescriptor());
+            appendValueSlot(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
         }
+        ASSERT(structureBefore != m_structure);
 
         // ASSERT(m_values.size() == m_structure->propertyCount());
         return true;
@@ -633,7 +756,7 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
         }
 
         bool shouldDelete = false;
-        Value v = current.isNativeAccessorProperty() ? this->get(state, ObjectPropertyName(state, propertyName)).value(state, this) : Value(m_values[idx]);
+        Value v = current.isNativeAccessorProperty() ? this->get(state, ObjectPropertyName(state, propertyName)).value(state, this) : readDataSlot(idx, current);
         ObjectPropertyDescriptor newDesc = ObjectPropertyDescriptor::fromObjectStructurePropertyDescriptor(current, v);
 
         // If IsGenericDescriptor(Desc) is true, then
@@ -746,12 +869,19 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
                 m_values[idx] = Value(new JSGetterSetter(newDesc.getterSetter()));
             }
         } else {
+            invalidatePrototypeValidityCell();
             auto oldDesc = findResult.second.value();
             if (newDesc.isDataDescriptor() && oldDesc->m_descriptor.isNativeAccessorProperty()) {
                 auto newNative = new ObjectPropertyNativeGetterSetterData(newDesc.isWritable(), newDesc.isEnumerable(), newDesc.isConfigurable(),
                                                                           oldDesc->m_descriptor.nativeGetterSetterData()->m_getter, oldDesc->m_descriptor.nativeGetterSetterData()->m_setter);
                 m_structure = m_structure->replacePropertyDescriptor(idx, ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(newNative));
             } else {
+#if defined(ESCARGOT_64)
+                if (current.hasDoubleRepresentation()) {
+                    // descriptors made from attributes have tagged representation
+                    generalizePropertyRepresentation(idx);
+                }
+#endif
                 m_structure = m_structure->replacePropertyDescriptor(idx, newDesc.toObjectStructurePropertyDescriptor());
             }
 
@@ -1275,10 +1405,35 @@ ValueVector Object::createListFromArrayLike(ExecutionState& state, Value obj, ui
     return list;
 }
 
+#if defined(ESCARGOT_64)
+void Object::generalizePropertyRepresentation(size_t idx)
+{
+    ASSERT(m_structure->readProperty(idx).m_descriptor.hasDoubleRepresentation());
+    SmallValue boxedValue(Value(m_values[idx].asUnboxedDouble()));
+    invalidatePrototypeValidityCell();
+    m_structure = m_structure->generalizePropertyRepresentation(idx);
+    m_values[idx] = boxedValue;
+}
+#endif
+
+void Object::eraseValueSlot(size_t idx, size_t currentSize)
+{
+    if (hasInlineSlots()) {
+        // inline slots keep their capacity
+        for (size_t i = idx + 1; i < currentSize; i++) {
+            m_values[i - 1] = m_values[i];
+        }
+        m_values[currentSize - 1] = SmallValue();
+        return;
+    }
+    m_values.erase(idx, currentSize);
+}
+
 void Object::deleteOwnProperty(ExecutionState& state, size_t idx)
 {
+    invalidatePrototypeValidityCell();
     m_structure = m_structure->removeProperty(idx);
-    m_values.erase(idx, m_structure->propertyCount() + 1);
+    eraseValueSlot(idx, m_structure->propertyCount() + 1);
 
     // ASSERT(m_values.size() == m_structure->propertyCount());
 }
@@ -1481,8 +1636,9 @@ bool Object::defineNativeDataAccessorProperty(ExecutionState& state, const Objec
     ASSERT(!hasOwnProperty(state, P));
     ASSERT(isExtensible(state));
 
+    invalidatePrototypeValidityCell();
     m_structure = m_structure->addProperty(P.toObjectStructurePropertyName(state), ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(data));
-    m_values.pushBack(objectInternalData, m_structure->propertyCount());
+    appendValueSlot(objectInternalData, m_structure->propertyCount());
 
     return true;
 }
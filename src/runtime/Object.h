@@ -44,6 +44,31 @@ extern size_t g_objectRareDataTag;
 
 #define OBJECT_PROPERTY_NAME_UINT32_VIAS 2
 
+// Validity of prototype chain which starts at a prototype object
+// The cell is invalidated when structure or [[Prototype]] of any object on the chain is changed,
+// so inline caches can check the whole chain at once.
+// Chain ends at null or at the first object which is not inline cacheable.
+class PrototypeValidityCell : public gc {
+public:
+    PrototypeValidityCell()
+        : m_isValid(true)
+    {
+    }
+
+    bool isValid() const
+    {
+        return m_isValid;
+    }
+
+    // cell of an object whose [[Prototype]] is owner of this cell
+    void addDependentCell(PrototypeValidityCell* cell);
+    void invalidate();
+
+private:
+    bool m_isValid;
+    Vector<PrototypeValidityCell*, GCUtil::gc_malloc_allocator<PrototypeValidityCell*>> m_dependentCells;
+};
+
 struct ObjectRareData : public PointerValue {
     bool m_isExtensible : 1;
     bool m_isEverSetAsPrototypeObject : 1;
@@ -55,6 +80,7 @@ struct ObjectRareData : public PointerValue {
     uint8_t m_arrayObjectFastModeBufferExpandCount : 8;
     void* m_extraData;
     Object* m_prototype;
+    PrototypeValidityCell* m_prototypeValidityCell;
     union {
         Object* m_internalSlot;
         StorePositiveIntergerAsOdd m_arrayObjectFastModeBufferCapacity;
@@ -715,10 +741,16 @@ class Object : public PointerValue {
     friend class EnumerateObjectWithDestruction;
     friend class EnumerateObjectWithIteration;
     friend struct ObjectRareData;
+    friend class ObjectAllocationSite;
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
 
 public:
     explicit Object(ExecutionState& state);
+    // creates plain object which stores first inlineSlotCount property values in the same allocation
+    static Object* createWithInlineSlots(ExecutionState& state, size_t inlineSlotCount);
+    // creates plain object which has every property of structure already
+    // values of properties are not initialized, so caller should write every slot before the object is exposed
+    static Object* createWithStructure(ExecutionState& state, ObjectStructure* structure);
     static Object* createFunctionPrototypeObject(ExecutionState& state, FunctionObject* function);
 
     virtual bool isObjectByVTable() const override
@@ -850,7 +882,7 @@ public:
         for (size_t i = 0; i < l; i++) {
             if (items[i].m_propertyName.isPlainString() && items[i].m_propertyName.plainString()->equals("constructor")) {
                 if (items[i].m_descriptor.isDataProperty()) {
-                    return Value(m_values[i]);
+                    return readDataSlot(i, items[i].m_descriptor);
                 }
                 break;
             }
@@ -930,9 +962,25 @@ public:
 
     void markThisObjectDontNeedStructureTransitionTable()
     {
+        if (m_structure->inTransitionMode()) {
+            invalidatePrototypeValidityCell();
+        }
         m_structure = m_structure->convertToNonTransitionStructure();
     }
 
+    // returns cell for prototype chain starting at this object
+    PrototypeValidityCell* ensurePrototypeValidityCell(ExecutionState& state);
+
+    // should be called when structure or [[Prototype]] of this object is changed
+    ALWAYS_INLINE void invalidatePrototypeValidityCell()
+    {
+        ObjectRareData* data = rareData();
+        if (UNLIKELY(data && data->m_prototypeValidityCell)) {
+            data->m_prototypeValidityCell->invalidate();
+            data->m_prototypeValidityCell = nullptr;
+        }
+    }
+
     // returns existence of index
     static bool nextIndexForward(ExecutionState& state, Object* obj, const int64_t cur, const int64_t len, int64_t& nextIndex);
     static bool nextIndexBackward(ExecutionState& state, Object* obj, const int64_t cur, const int64_t end, int64_t& nextIndex);
@@ -1072,6 +1120,36 @@ protected:
         }
         return nullptr;
     }
+
+    // object created by createWithInlineSlots has [slot capacity][slots...] right after itself
+    // m_values refers the inline slots until the object outgrows them
+    // inline slots start at odd word of GC granule, so a buffer allocated separately can never be there
+    size_t* inlineSlotHeader()
+    {
+        return (size_t*)((char*)this + sizeof(Object));
+    }
+
+    bool hasInlineSlots()
+    {
+        return m_values.data() == (SmallValue*)(inlineSlotHeader() + 1);
+    }
+
+    ALWAYS_INLINE void appendValueSlot(const SmallValue& value, size_t newSize)
+    {
+        if (hasInlineSlots()) {
+            if (LIKELY(newSize <= *inlineSlotHeader())) {
+                m_values[newSize - 1] = value;
+                return;
+            }
+            m_values.detachExternalBuffer(newSize - 1, newSize);
+            m_values[newSize - 1] = value;
+            return;
+        }
+        m_values.pushBack(value, newSize);
+    }
+
+    void eraseValueSlot(size_t idx, size_t currentSize);
+
     ObjectStructure* m_structure;
     Object* m_prototype;
     TightVectorWithNoSizeUseGCRealloc<SmallValue> m_values;
@@ -1086,16 +1164,50 @@ protected:
 
     ALWAYS_INLINE Value uncheckedGetOwnDataProperty(ExecutionState& state, size_t idx)
     {
-        ASSERT(m_structure->readProperty(idx).m_descriptor.isDataProperty());
-        return m_values[idx];
+        const ObjectStructureItem& item = m_structure->readProperty(idx);
+        ASSERT(item.m_descriptor.isDataProperty());
+        return readDataSlot(idx, item.m_descriptor);
     }
 
     ALWAYS_INLINE void uncheckedSetOwnDataProperty(ExecutionState& state, size_t idx, const Value& newValue)
     {
-        ASSERT(m_structure->readProperty(idx).m_descriptor.isDataProperty());
+        const ObjectStructureItem& item = m_structure->readProperty(idx);
+        ASSERT(item.m_descriptor.isDataProperty());
+        writeDataSlot(idx, item.m_descriptor, newValue);
+    }
+
+    // slot of plain data property with double representation holds unboxed double (see SmallValue::fromUnboxedDouble)
+    ALWAYS_INLINE Value readDataSlot(size_t idx, const ObjectStructurePropertyDescriptor& desc)
+    {
+#if defined(ESCARGOT_64)
+        if (desc.hasDoubleRepresentation()) {
+            return Value(m_values[idx].asUnboxedDouble());
+        }
+#endif
+        return m_values[idx];
+    }
+
+    // desc should not be used after calling this because structure can be changed
+    ALWAYS_INLINE void writeDataSlot(size_t idx, const ObjectStructurePropertyDescriptor& desc, const Value& newValue)
+    {
+#if defined(ESCARGOT_64)
+        if (desc.hasDoubleRepresentation()) {
+            if (LIKELY(newValue.isNumber())) {
+                m_values[idx] = SmallValue::fromUnboxedDouble(newValue.asNumber());
+                return;
+            }
+            generalizePropertyRepresentation(idx);
+        }
+#endif
         m_values[idx] = newValue;
     }
 
+#if defined(ESCARGOT_64)
+    // changes property at idx from double representation to tagged representation
+    // value of the property is boxed into SmallValue
+    void generalizePropertyRepresentation(size_t idx);
+#endif
+
     ALWAYS_INLINE Value getOwnDataPropertyUtilForObject(ExecutionState& state, size_t idx)
     {
         return getOwnDataPropertyUtilForObject(state, idx, this);
@@ -1106,7 +1218,7 @@ protected:
         ASSERT(m_structure->readProperty(idx).m_descriptor.isDataProperty());
         const ObjectStructureItem& item = m_structure->readProperty(idx);
         if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-            return m_values[idx];
+            return readDataSlot(idx, item.m_descriptor);
         } else {
             return item.m_descriptor.nativeGetterSetterData()->m_getter(state, this, m_values[idx]);
         }
@@ -1115,7 +1227,7 @@ protected:
     ALWAYS_INLINE bool setOwnDataPropertyUtilForObjectInner(ExecutionState& state, size_t idx, const ObjectStructureItem& item, const Value& newValue)
     {
         if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-            m_values[idx] = newValue;
+            writeDataSlot(idx, item.m_descriptor, newValue);
             return true;
         } else {
             return item.m_descriptor.nativeGetterSetterData()->m_setter(state, this, m_values[idx], newValue);
@@ -1138,7 +1250,7 @@ protected:
         const ObjectStructureItem& item = m_structure->readProperty(idx);
         if (LIKELY(item.m_descriptor.isDataProperty())) {
             if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-                return m_values[idx];
+                return readDataSlot(idx, item.m_descriptor);
             } else {
                 return item.m_descriptor.nativeGetterSetterData()->m_getter(state, this, m_values[idx]);
             }
@@ -1170,6 +1282,61 @@ protected:
     void markAsPrototypeObject(ExecutionState& state);
     void deleteOwnProperty(ExecutionState& state, size_t idx);
 };
+
+// Allocation site of plain objects (object literal or constructor function)
+// First instances get generous inline slots, and property count of each instance is observed when the next one is allocated.
+// After that, instances of the site get as many inline slots as the largest observed instance needed.
+// Site of constructor function also remembers the last prototype of instances, so that following instances skip [[SetPrototypeOf]].
+class ObjectAllocationSite : public gc {
+public:
+    ObjectAllocationSite()
+        : m_lastInstance(nullptr)
+        , m_prototype(nullptr)
+        , m_trackedInstanceCount(0)
+        , m_inlineSlotCount(0)
+    {
+    }
+
+    ALWAYS_INLINE Object* allocate(ExecutionState& state)
+    {
+        if (LIKELY(m_trackedInstanceCount > SlackTrackingInstanceCount)) {
+            if (m_inlineSlotCount) {
+                return Object::createWithInlineSlots(state, m_inlineSlotCount);
+            }
+            return new Object(state);
+        }
+        return allocateWhileSlackTracking(state);
+    }
+
+    // allocates instance of constructor whose `prototype` property has functionPrototype
+    // realm is used when functionPrototype is not an object
+    ALWAYS_INLINE Object* allocateInstance(ExecutionState& state, const Value& functionPrototype, Context* realm)
+    {
+        Object* obj = allocate(state);
+        if (LIKELY(functionPrototype.isObject() && functionPrototype.asObject() == m_prototype)) {
+            // m_prototype is already marked as prototype object,
+            // and new object can't be in its prototype chain
+            obj->setPrototypeForIntrinsicObjectCreation(state, m_prototype);
+        } else {
+            setPrototypeOfInstance(state, obj, functionPrototype, realm);
+        }
+        return obj;
+    }
+
+    static const size_t SlackTrackingInstanceCount = 8;
+    static const size_t MaxInlineSlotCount = 16;
+
+private:
+    Object* allocateWhileSlackTracking(ExecutionState& state);
+    void setPrototypeOfInstance(ExecutionState& state, Object* obj, const Value& functionPrototype, Context* realm);
+
+    Object* m_lastInstance;
+    // `prototype` of constructor which is used by the last instance
+    // instances get another prototype when `prototype` property is reassigned
+    Object* m_prototype;
+    uint8_t m_trackedInstanceCount;
+    uint8_t m_inlineSlotCount;
+};
 }
 
 #endif
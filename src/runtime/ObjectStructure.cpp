@@ -141,6 +141,11 @@ ObjectStructure* ObjectStructureWithoutTransition::replacePropertyDescriptor(siz
     return newStructure;
 }
 
+ObjectStructure* ObjectStructureWithoutTransition::generalizePropertyRepresentation(size_t idx)
+{
+    return replacePropertyDescriptor(idx, readProperty(idx).m_descriptor.toTaggedRepresentation());
+}
+
 ObjectStructure* ObjectStructureWithoutTransition::convertToNonTransitionStructure()
 {
     return this;
@@ -203,7 +208,7 @@ size_t ObjectStructureWithTransition::propertyCount() const
     return m_properties.size();
 }
 
-ObjectStructure* ObjectStructureWithTransition::addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc)
+ObjectStructure* ObjectStructureWithTransition::findTransition(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc)
 {
     if (m_doesTransitionTableUseMap) {
         auto iter = m_transitionTableMap->find(ObjectStructureTransitionMapItem(name, desc));
@@ -220,6 +225,50 @@ ObjectStructure* ObjectStructureWithTransition::addProperty(const ObjectStructur
         }
     }
 
+    return nullptr;
+}
+
+void ObjectStructureWithTransition::insertTransition(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc, ObjectStructure* structure)
+{
+    ObjectStructureTransitionVectorItem newTransitionItem(name, desc, structure);
+
+    if (m_doesTransitionTableUseMap) {
+        m_transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(newTransitionItem.m_propertyName, newTransitionItem.m_descriptor),
+                                                    newTransitionItem.m_structure));
+    } else {
+        if (m_transitionTableVectorBufferSize + 1 > ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE) {
+            ObjectStructureTransitionTableMap* transitionTableMap = new (GC) ObjectStructureTransitionTableMap();
+            for (size_t i = 0; i < m_transitionTableVectorBufferSize; i++) {
+                transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(m_transitionTableVectorBuffer[i].m_propertyName, m_transitionTableVectorBuffer[i].m_descriptor),
+                                                          m_transitionTableVectorBuffer[i].m_structure));
+            }
+            transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(newTransitionItem.m_propertyName, newTransitionItem.m_descriptor),
+                                                      newTransitionItem.m_structure));
+
+            GC_FREE(m_transitionTableVectorBuffer);
+            m_doesTransitionTableUseMap = true;
+            m_transitionTableMap = transitionTableMap;
+            m_transitionTableVectorBufferCapacity = 0;
+            m_transitionTableVectorBufferSize = 0;
+        } else {
+            if (m_transitionTableVectorBufferCapacity <= (size_t)(m_transitionTableVectorBufferSize + 1)) {
+                size_t oldc = m_transitionTableVectorBufferCapacity;
+                m_transitionTableVectorBufferCapacity = std::min(computeVectorAllocateSize(m_transitionTableVectorBufferSize + 1), (size_t)std::numeric_limits<uint8_t>::max());
+                m_transitionTableVectorBuffer = (ObjectStructureTransitionVectorItem*)GC_REALLOC(m_transitionTableVectorBuffer, sizeof(ObjectStructureTransitionVectorItem) * m_transitionTableVectorBufferCapacity);
+            }
+            m_transitionTableVectorBuffer[m_transitionTableVectorBufferSize] = newTransitionItem;
+            m_transitionTableVectorBufferSize++;
+        }
+    }
+}
+
+ObjectStructure* ObjectStructureWithTransition::addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc)
+{
+    ObjectStructure* cachedStructure = findTransition(name, desc);
+    if (cachedStructure) {
+        return cachedStructure;
+    }
+
     ObjectStructureItem newItem(name, desc);
     bool nameIsIndexString = m_hasIndexPropertyName ? true : name.isIndexString();
     bool hasNonAtomicName = m_hasNonAtomicPropertyName ? true : !name.hasAtomicString();
@@ -234,36 +283,7 @@ ObjectStructure* ObjectStructureWithTransition::addProperty(const ObjectStructur
     } else {
         ObjectStructureItemTightVector newProperties(m_properties, newItem);
         newObjectStructure = new ObjectStructureWithTransition(std::move(newProperties), nameIsIndexString, hasNonAtomicName);
-        ObjectStructureTransitionVectorItem newTransitionItem(name, desc, newObjectStructure);
-
-        if (m_doesTransitionTableUseMap) {
-            m_transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(newTransitionItem.m_propertyName, newTransitionItem.m_descriptor),
-                                                        newTransitionItem.m_structure));
-        } else {
-            if (m_transitionTableVectorBufferSize + 1 > ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE) {
-                ObjectStructureTransitionTableMap* transitionTableMap = new (GC) ObjectStructureTransitionTableMap();
-                for (size_t i = 0; i < m_transitionTableVectorBufferSize; i++) {
-                    transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(m_transitionTableVectorBuffer[i].m_propertyName, m_transitionTableVectorBuffer[i].m_descriptor),
-                                                              m_transitionTableVectorBuffer[i].m_structure));
-                }
-                transitionTableMap->insert(std::make_pair(ObjectStructureTransitionMapItem(newTransitionItem.m_propertyName, newTransitionItem.m_descriptor),
-                                                          newTransitionItem.m_structure));
-
-                GC_FREE(m_transitionTableVectorBuffer);
-                m_doesTransitionTableUseMap = true;
-                m_transitionTableMap = transitionTableMap;
-                m_transitionTableVectorBufferCapacity = 0;
-                m_transitionTableVectorBufferSize = 0;
-            } else {
-                if (m_transitionTableVectorBufferCapacity <= (size_t)(m_transitionTableVectorBufferSize + 1)) {
-                    size_t oldc = m_transitionTableVectorBufferCapacity;
-                    m_transitionTableVectorBufferCapacity = std::min(computeVectorAllocateSize(m_transitionTableVectorBufferSize + 1), (size_t)std::numeric_limits<uint8_t>::max());
-                    m_transitionTableVectorBuffer = (ObjectStructureTransitionVectorItem*)GC_REALLOC(m_transitionTableVectorBuffer, sizeof(ObjectStructureTransitionVectorItem) * m_transitionTableVectorBufferCapacity);
-                }
-                m_transitionTableVectorBuffer[m_transitionTableVectorBufferSize] = newTransitionItem;
-                m_transitionTableVectorBufferSize++;
-            }
-        }
+        insertTransition(name, desc, newObjectStructure);
     }
 
     return newObjectStructure;
@@ -298,6 +318,25 @@ ObjectStructure* ObjectStructureWithTransition::replacePropertyDescriptor(size_t
     return new ObjectStructureWithoutTransition(newProperties, m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
 }
 
+ObjectStructure* ObjectStructureWithTransition::generalizePropertyRepresentation(size_t idx)
+{
+    // generalized structure is registered in transition table under the name of existing property.
+    // addProperty never looks up a name which is already in this structure, so the entries don't collide
+    // and every object of this structure generalizes into the same structure
+    const ObjectStructureItem& item = m_properties[idx];
+    ObjectStructurePropertyDescriptor newDesc = item.m_descriptor.toTaggedRepresentation();
+    ObjectStructure* cachedStructure = findTransition(item.m_propertyName, newDesc);
+    if (cachedStructure) {
+        return cachedStructure;
+    }
+
+    ObjectStructureItemTightVector newProperties(m_properties);
+    newProperties[idx].m_descriptor = newDesc;
+    ObjectStructure* newObjectStructure = new ObjectStructureWithTransition(std::move(newProperties), m_hasIndexPropertyName, m_hasNonAtomicPropertyName);
+    insertTransition(item.m_propertyName, newDesc, newObjectStructure);
+    return newObjectStructure;
+}
+
 ObjectStructure* ObjectStructureWithTransition::convertToNonTransitionStructure()
 {
     ObjectStructureItemVector* newProperties = new ObjectStructureItemVector(m_properties);
@@ -388,6 +427,11 @@ ObjectStructure* ObjectStructureWithMap::replacePropertyDescriptor(size_t idx, c
     return newStructure;
 }
 
+ObjectStructure* ObjectStructureWithMap::generalizePropertyRepresentation(size_t idx)
+{
+    return replacePropertyDescriptor(idx, readProperty(idx).m_descriptor.toTaggedRepresentation());
+}
+
 ObjectStructure* ObjectStructureWithMap::convertToNonTransitionStructure()
 {
     return this;
@@ -126,6 +126,8 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) = 0;
     virtual ObjectStructure* removeProperty(size_t pIndex) = 0;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) = 0;
+    // returns structure whose property at idx has tagged representation instead of double representation
+    virtual ObjectStructure* generalizePropertyRepresentation(size_t idx) = 0;
 
     virtual ObjectStructure* convertToNonTransitionStructure() = 0;
 
@@ -149,6 +151,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* generalizePropertyRepresentation(size_t idx) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
@@ -190,6 +193,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* generalizePropertyRepresentation(size_t idx) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
@@ -215,6 +219,9 @@ private:
         return 1 << (base + 1);
     }
 
+    ObjectStructure* findTransition(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc);
+    void insertTransition(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc, ObjectStructure* structure);
+
     ObjectStructureItemTightVector m_properties;
 
     bool m_doesTransitionTableUseMap : 1;
@@ -272,6 +279,7 @@ public:
     virtual ObjectStructure* addProperty(const ObjectStructurePropertyName& name, const ObjectStructurePropertyDescriptor& desc) override;
     virtual ObjectStructure* removeProperty(size_t pIndex) override;
     virtual ObjectStructure* replacePropertyDescriptor(size_t idx, const ObjectStructurePropertyDescriptor& newDesc) override;
+    virtual ObjectStructure* generalizePropertyRepresentation(size_t idx) override;
     virtual ObjectStructure* convertToNonTransitionStructure() override;
 
     virtual bool inTransitionMode() override
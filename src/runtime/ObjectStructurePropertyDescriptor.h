@@ -128,6 +128,33 @@ public:
         return m_descriptorData.mode() == HasDataButHasNativeGetterSetter;
     }
 
+    // number value of this property is stored unboxed in the slot (64-bit only)
+    // see Object::generalizePropertyRepresentation
+    bool hasDoubleRepresentation() const
+    {
+#if defined(ESCARGOT_64)
+        return (m_descriptorData.m_data & (1 | DoubleRepresentation)) == (1 | DoubleRepresentation);
+#else
+        return false;
+#endif
+    }
+
+    ObjectStructurePropertyDescriptor toDoubleRepresentation() const
+    {
+        ASSERT(isPlainDataProperty() && isWritable());
+        ObjectStructurePropertyDescriptor desc = *this;
+        desc.m_descriptorData.m_data |= DoubleRepresentation;
+        return desc;
+    }
+
+    ObjectStructurePropertyDescriptor toTaggedRepresentation() const
+    {
+        ASSERT(hasDoubleRepresentation());
+        ObjectStructurePropertyDescriptor desc = *this;
+        desc.m_descriptorData.m_data &= ~(size_t)DoubleRepresentation;
+        return desc;
+    }
+
     bool operator==(const ObjectStructurePropertyDescriptor& desc) const
     {
         return m_descriptorData.m_data == desc.m_descriptorData.m_data;
@@ -222,6 +249,9 @@ public:
     }
 
 private:
+    // stored in ObjectStructurePropertyDescriptorData::m_data next to the mode bit (64)
+    static const size_t DoubleRepresentation = 128;
+
     ObjectStructurePropertyDescriptor(PresentAttribute attribute, ObjectStructurePropertyDescriptorMode mode)
         : m_descriptorData(attribute, mode)
     {
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotPropertyAccessStubCache__
+#define __EscargotPropertyAccessStubCache__
+
+#include "runtime/ObjectStructure.h"
+
+namespace Escargot {
+
+// VM-wide cache for named property accesses that went megamorphic at their call site.
+// Entries are keyed by (receiver structure, property name) and hold raw pointers
+// which are not scanned by GC, so the whole cache is cleared on every GC mark start.
+class PropertyAccessStubCache {
+public:
+    static const size_t maxPrototypeChainLength = 4;
+
+    struct GetEntry {
+        ObjectStructure* m_structure;
+        String* m_propertyName;
+        // structures of prototype objects; the last one is the holder of the property
+        ObjectStructure* m_prototypeChain[maxPrototypeChainLength];
+        size_t m_prototypeChainLength;
+        size_t m_index;
+    };
+
+    struct SetEntry {
+        ObjectStructure* m_structure;
+        String* m_propertyName;
+        size_t m_index;
+    };
+
+    PropertyAccessStubCache()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        memset(m_getEntries, 0, sizeof(m_getEntries));
+        memset(m_setEntries, 0, sizeof(m_setEntries));
+    }
+
+    ALWAYS_INLINE GetEntry& getEntry(ObjectStructure* structure, String* propertyName)
+    {
+        return m_getEntries[hash(structure, propertyName) & (getEntryCount - 1)];
+    }
+
+    ALWAYS_INLINE SetEntry& setEntry(ObjectStructure* structure, String* propertyName)
+    {
+        return m_setEntries[hash(structure, propertyName) & (setEntryCount - 1)];
+    }
+
+private:
+    static const size_t getEntryCount = PROPERTY_ACCESS_STUB_CACHE_SIZE;
+    static const size_t setEntryCount = PROPERTY_ACCESS_STUB_CACHE_SIZE / 2;
+    COMPILE_ASSERT((getEntryCount & (getEntryCount - 1)) == 0, "");
+    COMPILE_ASSERT(setEntryCount > 0 && (setEntryCount & (setEntryCount - 1)) == 0, "");
+
+    static ALWAYS_INLINE size_t hash(ObjectStructure* structure, String* propertyName)
+    {
+        return (((size_t)structure) >> 4) ^ (((size_t)propertyName) >> 3);
+    }
+
+    GetEntry m_getEntries[getEntryCount];
+    SetEntry m_setEntries[setEntryCount];
+};
+} // namespace Escargot
+
+#endif
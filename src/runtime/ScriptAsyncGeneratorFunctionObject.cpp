@@ -43,7 +43,7 @@ public:
             // --> thisMode is always not lexcial because this is class ctor.
             // Let calleeRealm be the value of F’s [[Realm]] internal slot.
             // Let localEnv be the LexicalEnvironment of calleeContext.
-            ASSERT(calleeState.context() == self->codeBlock()->context());
+            ASSERT(calleeState.context() == self->getFunctionRealm(calleeState));
 
             if (isStrict) {
                 // If thisMode is strict, let thisValue be thisArgument.
@@ -106,22 +106,28 @@ Object* ScriptClassConstructorFunctionObject::construct(ExecutionState& state, c
 
     // If kind is "base", then
     if (kind == ConstructorKind::Base) {
-        // Let thisArgument be OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%").
-        // OrdinaryCreateFromConstructor -> Let proto be GetPrototypeFromConstructor(constructor, intrinsicDefaultProto).
-        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be Get(constructor, "prototype").
-        Value proto = newTarget->get(state, ObjectPropertyName(state.context()->staticStrings().prototype)).value(state, newTarget);
-
-        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> If Type(proto) is not Object, then
-        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let realm be GetFunctionRealm(constructor).
-        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> ReturnIfAbrupt(realm).
-        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be realm’s intrinsic object named intrinsicDefaultProto.
-        if (!proto.isObject()) {
-            proto = codeBlock()->context()->globalObject()->objectPrototype();
+        if (LIKELY(newTarget == this)) {
+            // OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%")
+            // `prototype` of function is always an own data property, so Get(constructor, "prototype") is the value of its slot
+            thisArgument = objectAllocationSite()->allocateInstance(state, getFunctionPrototype(state), m_realm);
+        } else {
+            // Let thisArgument be OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%").
+            // OrdinaryCreateFromConstructor -> Let proto be GetPrototypeFromConstructor(constructor, intrinsicDefaultProto).
+            // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be Get(constructor, "prototype").
+            Value proto = newTarget->get(state, ObjectPropertyName(state.context()->staticStrings().prototype)).value(state, newTarget);
+
+            // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> If Type(proto) is not Object, then
+            // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let realm be GetFunctionRealm(constructor).
+            // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> ReturnIfAbrupt(realm).
+            // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be realm’s intrinsic object named intrinsicDefaultProto.
+            if (!proto.isObject()) {
+                proto = m_realm->globalObject()->objectPrototype();
+            }
+
+            thisArgument = objectAllocationSite()->allocate(state);
+            // Set the [[Prototype]] internal slot of obj to proto.
+            thisArgument->setPrototype(state, proto);
         }
-
-        thisArgument = new Object(state);
-        // Set the [[Prototype]] internal slot of obj to proto.
-        thisArgument->setPrototype(state, proto);
         // ReturnIfAbrupt(thisArgument).
     }
 
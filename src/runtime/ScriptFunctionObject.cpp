@@ -60,6 +60,8 @@ ScriptFunctionObject::ScriptFunctionObject(ExecutionState& state, CodeBlock* cod
 {
     m_codeBlock = codeBlock;
     m_outerEnvironment = outerEnvironment;
+    m_realm = state.context();
+    m_objectAllocationSite = nullptr;
 
 #ifdef NDEBUG
     if (m_outerEnvironment) {
@@ -94,6 +96,11 @@ Value ScriptFunctionObject::call(ExecutionState& state, const Value& thisValue,
     return FunctionObjectProcessCallGenerator::processCall<ScriptFunctionObject, false, false, false, FunctionObjectThisValueBinder, FunctionObjectNewTargetBinder, FunctionObjectReturnValueBinder>(state, this, thisValue, argc, argv, nullptr);
 }
 
+Value ScriptFunctionObject::callWithEnvironmentOnStack(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv)
+{
+    return FunctionObjectProcessCallGenerator::processCallWithEnvironmentOnStack(state, this, thisValue, argc, argv);
+}
+
 class ScriptFunctionObjectObjectThisValueBinderWithConstruct {
 public:
     Value operator()(ExecutionState& calleeState, FunctionObject* self, const Value& thisArgument, bool isStrict)
@@ -141,22 +148,29 @@ Object* ScriptFunctionObject::construct(ExecutionState& state, const size_t argc
 
     CodeBlock* cb = codeBlock();
     FunctionObject* constructor = this;
-    // Let thisArgument be OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%").
-    // OrdinaryCreateFromConstructor -> Let proto be GetPrototypeFromConstructor(constructor, intrinsicDefaultProto).
-    // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be Get(constructor, "prototype").
-    Value proto = newTarget->get(state, ObjectPropertyName(state.context()->staticStrings().prototype)).value(state, newTarget);
-
-    // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> If Type(proto) is not Object, then
-    // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let realm be GetFunctionRealm(constructor).
-    // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> ReturnIfAbrupt(realm).
-    // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be realm’s intrinsic object named intrinsicDefaultProto.
-    if (!proto.isObject()) {
-        proto = codeBlock()->context()->globalObject()->objectPrototype();
-    }
+    Object* thisArgument;
+    if (LIKELY(newTarget == this)) {
+        // OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%")
+        // `prototype` of function is always an own data property, so Get(constructor, "prototype") is the value of its slot
+        thisArgument = objectAllocationSite()->allocateInstance(state, getFunctionPrototype(state), m_realm);
+    } else {
+        // Let thisArgument be OrdinaryCreateFromConstructor(newTarget, "%ObjectPrototype%").
+        // OrdinaryCreateFromConstructor -> Let proto be GetPrototypeFromConstructor(constructor, intrinsicDefaultProto).
+        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be Get(constructor, "prototype").
+        Value proto = newTarget->get(state, ObjectPropertyName(state.context()->staticStrings().prototype)).value(state, newTarget);
+
+        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> If Type(proto) is not Object, then
+        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let realm be GetFunctionRealm(constructor).
+        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> ReturnIfAbrupt(realm).
+        // OrdinaryCreateFromConstructor -> GetPrototypeFromConstructor -> Let proto be realm’s intrinsic object named intrinsicDefaultProto.
+        if (!proto.isObject()) {
+            proto = m_realm->globalObject()->objectPrototype();
+        }
 
-    Object* thisArgument = new Object(state);
-    // Set the [[Prototype]] internal slot of obj to proto.
-    thisArgument->setPrototype(state, proto);
+        thisArgument = objectAllocationSite()->allocate(state);
+        // Set the [[Prototype]] internal slot of obj to proto.
+        thisArgument->setPrototype(state, proto);
+    }
     // ReturnIfAbrupt(thisArgument).
 
     return FunctionObjectProcessCallGenerator::processCall<ScriptFunctionObject, true, true, false, ScriptFunctionObjectObjectThisValueBinderWithConstruct, ScriptFunctionObjectNewTargetBinderWithConstruct, ScriptFunctionObjectReturnValueBinderWithConstruct>(state, this, Value(thisArgument), argc, argv, newTarget).asObject();
@@ -31,12 +31,27 @@ class ScriptFunctionObject : public FunctionObject {
 public:
     ScriptFunctionObject(ExecutionState& state, CodeBlock* codeBlock, LexicalEnvironment* outerEnvironment, bool isConstructor, bool isGenerator, bool isAsync);
 
+    // [[Realm]] is the Context which created this function
+    // CodeBlock can be shared by Contexts of a VMInstance, so CodeBlock::context is not the realm
+    Context* realm()
+    {
+        return m_realm;
+    }
+
+    virtual Context* getFunctionRealm(ExecutionState& state) override
+    {
+        return m_realm;
+    }
+
 protected:
     ScriptFunctionObject(ExecutionState& state, CodeBlock* codeBlock, LexicalEnvironment* outerEnvironment, size_t defaultPropertyCount);
 
     friend class FunctionObjectProcessCallGenerator;
     // https://www.ecma-international.org/ecma-262/6.0/#sec-ecmascript-function-objects-call-thisargument-argumentslist
     virtual Value call(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv) override;
+    // [[Call]] with frame setup specialized for environment on stack
+    // call target cache of CallFunction bytecodes checks the condition when it caches this function
+    Value callWithEnvironmentOnStack(ExecutionState& state, const Value& thisValue, const size_t argc, NULLABLE Value* argv);
     // https://www.ecma-international.org/ecma-262/6.0/#sec-ecmascript-function-objects-construct-argumentslist-newtarget
     virtual Object* construct(ExecutionState& state, const size_t argc, NULLABLE Value* argv, Object* newTarget) override;
 
@@ -55,6 +70,15 @@ protected:
         return true;
     }
 
+    // allocation site of `this` objects created by [[Construct]]
+    ObjectAllocationSite* objectAllocationSite()
+    {
+        if (UNLIKELY(!m_objectAllocationSite)) {
+            m_objectAllocationSite = new ObjectAllocationSite();
+        }
+        return m_objectAllocationSite;
+    }
+
     void generateArgumentsObject(ExecutionState& state, size_t argc, Value* argv, FunctionEnvironmentRecord* environmentRecordWillArgumentsObjectBeLocatedIn, Value* stackStorage, bool isMapped);
     void generateByteCodeBlock(ExecutionState& state);
 
@@ -63,9 +87,13 @@ protected:
         FunctionObject::fillGCDescriptor(desc);
 
         GC_set_bit(desc, GC_WORD_OFFSET(ScriptFunctionObject, m_outerEnvironment));
+        GC_set_bit(desc, GC_WORD_OFFSET(ScriptFunctionObject, m_realm));
+        GC_set_bit(desc, GC_WORD_OFFSET(ScriptFunctionObject, m_objectAllocationSite));
     }
 
     LexicalEnvironment* m_outerEnvironment;
+    Context* m_realm;
+    ObjectAllocationSite* m_objectAllocationSite;
 };
 }
 
@@ -210,6 +210,26 @@ public:
         return m_data.payload == ValueEmpty;
     }
 
+#if defined(ESCARGOT_64)
+    // unboxed double for slots which have double representation
+    // this is not SmallValue encoding, so it must be read only with asUnboxedDouble.
+    // bits are inverted and NaN is canonicalized, so the result never equals EmptyValue (holes of double elements)
+    static SmallValue fromUnboxedDouble(double d)
+    {
+        if (UNLIKELY(std::isnan(d))) {
+            d = std::numeric_limits<double>::quiet_NaN();
+        }
+        SmallValue v(ForceUninitialized);
+        v.m_data.payload = ~bitwise_cast<intptr_t>(d);
+        return v;
+    }
+
+    double asUnboxedDouble() const
+    {
+        return bitwise_cast<double>(~m_data.payload);
+    }
+#endif
+
     ALWAYS_INLINE operator Value() const
     {
         if (HAS_SMI_TAG(m_data.payload)) {
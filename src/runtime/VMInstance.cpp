@@ -27,6 +27,8 @@
 #include "runtime/CompressibleString.h"
 #include "interpreter/ByteCode.h"
 #include "parser/ASTAllocator.h"
+#include "parser/Script.h"
+#include "codecache/CodeCache.h"
 
 #include <pthread.h>
 
@@ -131,13 +133,19 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
             self->m_regexpCache->clear();
         }
 
+        // stub cache entries are not visible to GC
+        self->m_propertyAccessStubCache->clear();
+
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
-        if (currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX) {
+        if (currentCodeSizeTotal > self->m_maxCompiledByteCodeSize) {
+            self->releaseColdByteCodeBlocks();
             currentCodeSizeTotal = std::numeric_limits<size_t>::max();
-            auto& v = self->compiledByteCodeBlocks();
-            for (size_t i = 0; i < v.size(); i++) {
-                auto cb = v[i]->m_codeBlock;
-                v[i]->m_codeBlock->m_byteCodeBlock = nullptr;
+        }
+
+        auto& v = self->compiledByteCodeBlocks();
+        for (size_t i = 0; i < v.size(); i++) {
+            if (v[i]->m_age < std::numeric_limits<decltype(v[i]->m_age)>::max()) {
+                v[i]->m_age++;
             }
         }
     } else if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
@@ -173,6 +181,50 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
     */
 }
 
+// Detach ByteCodeBlocks from their CodeBlocks, the longest idle ones first, until the rest fits in the budget.
+// Blocks executed since the last GC are never released.
+// A released block which is still in use (e.g. running on the stack) survives this GC
+// and is attached again on GC_EVENT_RECLAIM_END.
+void VMInstance::releaseColdByteCodeBlocks()
+{
+    std::vector<ByteCodeBlock*> blocks = m_compiledByteCodeBlocks;
+    std::stable_sort(blocks.begin(), blocks.end(), [](ByteCodeBlock* a, ByteCodeBlock* b) -> bool {
+        return a->m_age > b->m_age;
+    });
+
+    size_t remainSize = m_compiledByteCodeSize;
+    for (size_t i = 0; i < blocks.size() && remainSize > m_maxCompiledByteCodeSize; i++) {
+        ByteCodeBlock* blk = blocks[i];
+        if (blk->m_age == 0) {
+            break;
+        }
+        // blocks loaded from bundle cannot be generated again, and global code can be generated again only by parsing whole script
+        if (blk->m_codeBlock->m_byteCodeBlock == blk && blk->m_codeBlock->script()->hasSourceCode() && !blk->m_codeBlock->isGlobalScopeCodeBlock()) {
+            blk->m_codeBlock->m_byteCodeBlock = nullptr;
+            remainSize -= std::min(remainSize, blk->memoryAllocatedSize());
+        }
+    }
+}
+
+void VMInstance::setWarmUpProfile(WarmUpProfile* profile)
+{
+    delete m_warmUpProfile;
+    m_warmUpProfile = profile;
+}
+
+size_t VMInstance::globalVariableAccessCacheSlotIndex(AtomicString name)
+{
+    auto iter = m_globalVariableAccessCacheSlotIndex.find(name);
+    if (iter != m_globalVariableAccessCacheSlotIndex.end()) {
+        return iter->second;
+    }
+
+    size_t index = m_globalVariableAccessCacheSlotNames.size();
+    m_globalVariableAccessCacheSlotNames.push_back(name);
+    m_globalVariableAccessCacheSlotIndex.insert(std::make_pair(name, index));
+    return index;
+}
+
 void* VMInstance::operator new(size_t size)
 {
     static bool typeInited = false;
@@ -246,6 +298,8 @@ VMInstance::~VMInstance()
     vzone_close(m_timezone);
 #endif
     delete m_astAllocator;
+    delete m_propertyAccessStubCache;
+    delete m_warmUpProfile;
 }
 
 VMInstance::VMInstance(Platform* platform, const char* locale, const char* timezone)
@@ -254,12 +308,15 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
     , m_isFinalized(false)
     , m_didSomePrototypeObjectDefineIndexedProperty(false)
     , m_compiledByteCodeSize(0)
+    , m_maxCompiledByteCodeSize(SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX)
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     , m_lastCompressibleStringsTestTime(0)
     , m_compressibleStringsUncomressedBufferSize(0)
 #endif
     , m_onVMInstanceDestroy(nullptr)
     , m_onVMInstanceDestroyData(nullptr)
+    , m_propertyAccessStubCache(new PropertyAccessStubCache())
+    , m_warmUpProfile(nullptr)
     , m_cachedUTC(nullptr)
     , m_platform(platform)
     , m_astAllocator(new ASTAllocator())
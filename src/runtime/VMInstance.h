@@ -29,6 +29,7 @@
 #include "runtime/String.h"
 #include "runtime/Symbol.h"
 #include "runtime/ToStringRecursionPreventer.h"
+#include "runtime/PropertyAccessStubCache.h"
 
 namespace Escargot {
 
@@ -38,6 +39,7 @@ class JobQueue;
 class Job;
 class ASTAllocator;
 class CompressibleString;
+class WarmUpProfile;
 
 #define DEFINE_GLOBAL_SYMBOLS(F) \
     F(hasInstance)               \
@@ -162,6 +164,11 @@ public:
         return m_toStringRecursionPreventer;
     }
 
+    PropertyAccessStubCache* propertyAccessStubCache()
+    {
+        return m_propertyAccessStubCache;
+    }
+
     JobQueue* jobQueue()
     {
         return m_jobQueue;
@@ -181,6 +188,36 @@ public:
         return m_compiledByteCodeSize;
     }
 
+    // when compiledByteCodeSize exceeds this on GC, bytecode of functions idle for the longest time is released
+    size_t maxCompiledByteCodeSize()
+    {
+        return m_maxCompiledByteCodeSize;
+    }
+
+    void setMaxCompiledByteCodeSize(size_t size)
+    {
+        m_maxCompiledByteCodeSize = size;
+    }
+
+    // global variable names get a VM-wide index when bytecode is generated
+    // GetGlobalVariable/SetGlobalVariable store this index and find the cache item in side table of running Context,
+    // so bytecode does not depend on the Context which compiled it
+    size_t globalVariableAccessCacheSlotIndex(AtomicString name);
+    AtomicString globalVariableAccessCacheSlotName(size_t index)
+    {
+        ASSERT(index < m_globalVariableAccessCacheSlotNames.size());
+        return m_globalVariableAccessCacheSlotNames[index];
+    }
+
+    // feedback of previous run imported with VMInstanceRef::importWarmUpProfile. nullptr if there is none
+    WarmUpProfile* warmUpProfile()
+    {
+        return m_warmUpProfile;
+    }
+
+    // takes ownership of profile
+    void setWarmUpProfile(WarmUpProfile* profile);
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     std::vector<CompressibleString*>& compressibleStrings()
     {
@@ -253,6 +290,11 @@ private:
 
     std::vector<ByteCodeBlock*> m_compiledByteCodeBlocks;
     size_t m_compiledByteCodeSize;
+    size_t m_maxCompiledByteCodeSize;
+
+    // names are kept alive by m_atomicStringMap
+    std::unordered_map<AtomicString, size_t, std::hash<AtomicString>, std::equal_to<AtomicString>> m_globalVariableAccessCacheSlotIndex;
+    std::vector<AtomicString> m_globalVariableAccessCacheSlotNames;
 
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     uint64_t m_lastCompressibleStringsTestTime;
@@ -263,10 +305,13 @@ private:
 #endif
 
     static void gcEventCallback(GC_EventType t, void* data);
+    void releaseColdByteCodeBlocks();
     void (*m_onVMInstanceDestroy)(VMInstance* instance, void* data);
     void* m_onVMInstanceDestroyData;
 
     ToStringRecursionPreventer m_toStringRecursionPreventer;
+    PropertyAccessStubCache* m_propertyAccessStubCache;
+    WarmUpProfile* m_warmUpProfile;
 
     void* m_stackStartAddress;
 
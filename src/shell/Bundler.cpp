@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2017-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include <string.h>
+#include <string>
+
+#include "api/EscargotPublic.h"
+
+// escargot-bundler compiles a script into precompiled bundle
+// the bundle can be loaded with ScriptParserRef::initializeScriptWithBundle (or `escargot --bundle=<file>`)
+// bundle is only valid for the engine build which wrote it
+
+using namespace Escargot;
+
+class BundlerPlatform : public PlatformRef {
+public:
+    virtual void didPromiseJobEnqueued(ContextRef* relatedContext, PromiseObjectRef* obj) override
+    {
+        // we never execute script
+    }
+
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromASCII("bundler does not support module"));
+    }
+
+    virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> referrer, ScriptRef* loadedModule) override
+    {
+    }
+};
+
+static bool readFile(const char* fileName, std::string& result)
+{
+    FILE* fp = fopen(fileName, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    char buf[4096];
+    size_t readLen;
+    while ((readLen = fread(buf, 1, sizeof buf, fp)) > 0) {
+        result.append(buf, readLen);
+    }
+    fclose(fp);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <input script> <output bundle>\n", argv[0]);
+        return 3;
+    }
+
+    std::string source;
+    if (!readFile(argv[1], source)) {
+        fprintf(stderr, "Cannot open file %s\n", argv[1]);
+        return 3;
+    }
+
+    Globals::initialize();
+
+    BundlerPlatform* platform = new BundlerPlatform();
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(platform);
+    instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+        delete instance->platform();
+    });
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+
+    int exitCode = 0;
+    StringRef* src = StringRef::createFromUTF8(source.data(), source.length());
+    auto scriptInitializeResult = context->scriptParser()->initializeScript(src, StringRef::createFromUTF8(argv[1], strlen(argv[1])), false);
+    if (!scriptInitializeResult.script) {
+        fprintf(stderr, "Script parsing error: %s\n", scriptInitializeResult.parseErrorMessage->toStdUTF8String().data());
+        exitCode = 3;
+    } else if (!context->scriptParser()->writeBundle(scriptInitializeResult.script.get(), argv[2])) {
+        fprintf(stderr, "Cannot write bundle %s\n", argv[2]);
+        exitCode = 3;
+    }
+
+    context.release();
+    instance.release();
+
+    Globals::finalize();
+
+    return exitCode;
+}
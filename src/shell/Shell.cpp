@@ -460,13 +460,8 @@ public:
     }
 };
 
-static bool evalScript(ContextRef* context, StringRef* str, StringRef* fileName, bool shouldPrintScriptResult, bool isModule)
+static bool executeScript(ContextRef* context, ScriptParserRef::InitializeScriptResult& scriptInitializeResult, bool shouldPrintScriptResult)
 {
-    if (stringEndsWith(fileName->toStdUTF8String(), "mjs")) {
-        isModule = isModule || true;
-    }
-
-    auto scriptInitializeResult = context->scriptParser()->initializeScript(str, fileName, isModule);
     if (!scriptInitializeResult.script) {
         printf("Script parsing error: ");
         switch (scriptInitializeResult.parseErrorCode) {
@@ -525,6 +520,37 @@ static bool evalScript(ContextRef* context, StringRef* str, StringRef* fileName,
     return true;
 }
 
+static bool evalScript(ContextRef* context, StringRef* str, StringRef* fileName, bool shouldPrintScriptResult, bool isModule)
+{
+    if (stringEndsWith(fileName->toStdUTF8String(), "mjs")) {
+        isModule = isModule || true;
+    }
+
+    auto scriptInitializeResult = context->scriptParser()->initializeScript(str, fileName, isModule);
+    return executeScript(context, scriptInitializeResult, shouldPrintScriptResult);
+}
+
+static bool evalBundle(ContextRef* context, const char* fileName)
+{
+    FILE* fp = fopen(fileName, "rb");
+    if (!fp) {
+        printf("Cannot open file %s\n", fileName);
+        return false;
+    }
+
+    std::vector<char> data;
+    char buf[4096];
+    size_t readLen;
+    while ((readLen = fread(buf, 1, sizeof buf, fp)) > 0) {
+        data.insert(data.end(), buf, buf + readLen);
+    }
+    fclose(fp);
+
+    // bundle data is copied while loading, so we can free it just after initializing
+    auto scriptInitializeResult = context->scriptParser()->initializeScriptWithBundle(data.data(), data.size(), StringRef::createFromUTF8(fileName, strlen(fileName)));
+    return executeScript(context, scriptInitializeResult, false);
+}
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -557,6 +583,7 @@ int main(int argc, char* argv[])
 
     bool runShell = true;
     bool seenModule = false;
+    const char* warmUpProfilePath = nullptr;
     for (int i = 1; i < argc; i++) {
         if (strlen(argv[i]) >= 2 && argv[i][0] == '-') { // parse command line option
             if (argv[i][1] == '-') { // `--option` case
@@ -568,6 +595,23 @@ int main(int argc, char* argv[])
                     seenModule = true;
                     continue;
                 }
+                if (strncmp(argv[i], "--code-cache-dir=", 17) == 0) {
+                    context->scriptParser()->setCodeCacheDirectory(argv[i] + 17);
+                    continue;
+                }
+                if (strncmp(argv[i], "--warm-up-profile=", 18) == 0) {
+                    // profile of previous run is imported now, and replaced on exit
+                    warmUpProfilePath = argv[i] + 18;
+                    instance->importWarmUpProfile(warmUpProfilePath);
+                    continue;
+                }
+                if (strncmp(argv[i], "--bundle=", 9) == 0) {
+                    runShell = false;
+                    if (!evalBundle(context, argv[i] + 9)) {
+                        return 3;
+                    }
+                    continue;
+                }
             } else { // `-option` case
                 if (strcmp(argv[i], "-e") == 0) {
                     runShell = false;
@@ -619,6 +663,10 @@ int main(int argc, char* argv[])
         evalScript(context, str, StringRef::createFromASCII("from shell input"), true, false);
     }
 
+    if (warmUpProfilePath) {
+        instance->exportWarmUpProfile(warmUpProfilePath);
+    }
+
     context.release();
     instance.release();
 
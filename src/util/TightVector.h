@@ -468,6 +468,22 @@ public:
         return m_buffer;
     }
 
+    // refers buffer which is not owned by this vector (e.g. storage placed inside of owner object)
+    // pushBack, resize, erase and clear should not be called until detachExternalBuffer is called
+    void referExternalBuffer(T* buffer)
+    {
+        m_buffer = buffer;
+    }
+
+    // copies first `size` items of external buffer into new buffer owned by this vector
+    void detachExternalBuffer(size_t size, size_t newSize)
+    {
+        ASSERT(size <= newSize);
+        T* newBuffer = (T*)GC_MALLOC(newSize * sizeof(T));
+        VectorCopier<T>::copy(newBuffer, m_buffer, size);
+        m_buffer = newBuffer;
+    }
+
 protected:
     T* m_buffer;
 };
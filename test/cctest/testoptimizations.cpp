@@ -0,0 +1,1273 @@
+/*
+ * Copyright (c) 2017-present Samsung Electronics Co., Ltd
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// tests for interpreter optimizations (inline caches, register allocation, code cache...)
+// each script is executed after its caches are warmed up by loops, and should return true
+
+#include <EscargotPublic.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#define CHECK(name, cond) \
+    printf(name " | %s\n", (cond) ? "pass" : "fail");
+
+using namespace Escargot;
+
+class TestPlatform : public PlatformRef {
+public:
+    virtual void didPromiseJobEnqueued(ContextRef* relatedContext, PromiseObjectRef* obj) override
+    {
+    }
+
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::SyntaxError, StringRef::createFromASCII("modules are not supported"));
+    }
+
+    virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> whereRequestFrom, ScriptRef* loadedModule) override
+    {
+    }
+};
+
+static bool executeScript(ContextRef* context, ScriptParserRef::InitializeScriptResult initializeResult)
+{
+    if (!initializeResult.isSuccessful()) {
+        printf("SyntaxError: %s\n", initializeResult.parseErrorMessage->toStdUTF8String().data());
+        return false;
+    }
+
+    auto evalResult = Evaluator::execute(context, [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         initializeResult.script.get());
+
+    if (!evalResult.isSuccessful()) {
+        printf("Uncaught %s\n", evalResult.resultOrErrorToString(context)->toStdUTF8String().data());
+        return false;
+    }
+    return evalResult.result->isTrue();
+}
+
+static bool evalScript(ContextRef* context, const char* source)
+{
+    return executeScript(context, context->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("testoptimizations.js")));
+}
+
+static void testPrototypeValidityCell(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // cell of C is taken from B after B's cell was invalidated by A
+    CHECK("Prototype validity cell 1", evalScript(context.get(), "(function() {"
+                                                                 "    function A() {} function B() {} function C() {}"
+                                                                 "    B.prototype = Object.create(A.prototype);"
+                                                                 "    C.prototype = Object.create(B.prototype);"
+                                                                 "    A.prototype.m = function() { return 1; };"
+                                                                 "    var b = new B(), c = new C();"
+                                                                 "    function callM(o) { return o.m(); }"
+                                                                 "    for (var i = 0; i < 100; i++) { if (callM(b) !== 1) return false; }"
+                                                                 "    A.prototype.x = 1;"
+                                                                 "    for (var i = 0; i < 100; i++) { if (callM(c) !== 1 || c.m() !== 1) return false; }"
+                                                                 "    B.prototype.m = function() { return 2; };"
+                                                                 "    return callM(c) === 2 && c.m() === 2 && callM(b) === 2;"
+                                                                 "})()"));
+
+    // property is added between receiver and cached holder
+    CHECK("Prototype validity cell 2", evalScript(context.get(), "(function() {"
+                                                                 "    var A = { v: 1 };"
+                                                                 "    var B = Object.create(A);"
+                                                                 "    var o = Object.create(B);"
+                                                                 "    function get(o) { return o.v; }"
+                                                                 "    for (var i = 0; i < 100; i++) { if (get(o) !== 1) return false; }"
+                                                                 "    B.v = 2;"
+                                                                 "    if (get(o) !== 2) return false;"
+                                                                 "    o.v = 3;"
+                                                                 "    return get(o) === 3;"
+                                                                 "})()"));
+
+    // prototype of intermediate object is changed
+    CHECK("Prototype validity cell 3", evalScript(context.get(), "(function() {"
+                                                                 "    var A1 = { v: 1 }, A2 = { v: 2 };"
+                                                                 "    var B = Object.create(A1);"
+                                                                 "    var o = Object.create(B);"
+                                                                 "    function get(o) { return o.v; }"
+                                                                 "    for (var i = 0; i < 100; i++) { if (get(o) !== 1) return false; }"
+                                                                 "    B.__proto__ = A2;"
+                                                                 "    if (get(o) !== 2) return false;"
+                                                                 "    for (var i = 0; i < 100; i++) { if (get(o) !== 2) return false; }"
+                                                                 "    Object.setPrototypeOf(B, A1);"
+                                                                 "    if (get(o) !== 1) return false;"
+                                                                 "    Object.setPrototypeOf(B, null);"
+                                                                 "    return get(o) === undefined;"
+                                                                 "})()"));
+
+    // property is deleted from cached holder
+    CHECK("Prototype validity cell 4", evalScript(context.get(), "(function() {"
+                                                                 "    var base = { v: 0 };"
+                                                                 "    var A = Object.create(base);"
+                                                                 "    A.v = 1;"
+                                                                 "    var o = Object.create(A);"
+                                                                 "    function get(o) { return o.v; }"
+                                                                 "    for (var i = 0; i < 100; i++) { if (get(o) !== 1) return false; }"
+                                                                 "    delete A.v;"
+                                                                 "    if (get(o) !== 0) return false;"
+                                                                 "    for (var i = 0; i < 100; i++) { if (get(o) !== 0) return false; }"
+                                                                 "    delete base.v;"
+                                                                 "    return get(o) === undefined;"
+                                                                 "})()"));
+}
+
+static void testRegisterCoalescing(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // temporaries with overlapping live ranges should not share register
+    CHECK("Register coalescing 1", evalScript(context.get(), "(function() {"
+                                                             "    function sum3(a, b, c) { return a * 100 + b * 10 + c; }"
+                                                             "    function f(a, b) {"
+                                                             "        var t = a; a = b; b = t;"
+                                                             "        var x = a + b, y = a - b;"
+                                                             "        var z = x * y;"
+                                                             "        return [a, b, x, y, z, (x = y, y = z, x + y), sum3(a + b, a * b, a - b)].join();"
+                                                             "    }"
+                                                             "    for (var i = 0; i < 100; i++) { if (f(1, 2) !== '2,1,3,1,3,4,321') return false; }"
+                                                             "    var c = true, a = 1, b = 2;"
+                                                             "    return (c ? a + b : a - b) * (c ? a - b : a + b) === -3;"
+                                                             "})()"));
+
+    CHECK("Register coalescing 2", evalScript(context.get(), "(function() {"
+                                                             "    function f(x) {"
+                                                             "        var a = x + 1;"
+                                                             "        try { var b = a * 2; if (x > 5) throw b; return a + b; }"
+                                                             "        catch (e) { return e + a; }"
+                                                             "        finally { a = 100; }"
+                                                             "    }"
+                                                             "    function g(x) { var r = x + 1; try { r = r * 2; } finally { r = r + 1; } return r; }"
+                                                             "    function h() { try { return 1; } finally { return 2; } }"
+                                                             "    for (var i = 0; i < 100; i++) { if (f(1) !== 6 || f(10) !== 33 || g(1) !== 5 || h() !== 2) return false; }"
+                                                             "    return true;"
+                                                             "})()"));
+
+    // registers live across yield are kept in generator
+    CHECK("Register coalescing 3", evalScript(context.get(), "(function() {"
+                                                             "    function* gen(n) {"
+                                                             "        var a = n + 1;"
+                                                             "        var b = a * 2;"
+                                                             "        var c = (yield a + b) + a;"
+                                                             "        yield c * b;"
+                                                             "        return a + b + c;"
+                                                             "    }"
+                                                             "    for (var i = 0; i < 100; i++) {"
+                                                             "        var it = gen(1);"
+                                                             "        if (it.next().value !== 6 || it.next(10).value !== 48) return false;"
+                                                             "        var last = it.next();"
+                                                             "        if (last.value !== 18 || !last.done) return false;"
+                                                             "    }"
+                                                             "    return true;"
+                                                             "})()"));
+
+    CHECK("Register coalescing 4", evalScript(context.get(), "(function() {"
+                                                             "    function make(n) {"
+                                                             "        var a = n * 2;"
+                                                             "        var fns = [];"
+                                                             "        for (let i = 0; i < 3; i++) { var t = a + i; fns.push(function() { return t + i + a; }); }"
+                                                             "        return fns;"
+                                                             "    }"
+                                                             "    function counter() { var c = 0; return function() { var old = c; c = c + 1; return old * 10 + c; }; }"
+                                                             "    for (var i = 0; i < 100; i++) {"
+                                                             "        var fns = make(1);"
+                                                             "        if (fns[0]() + fns[1]() + fns[2]() !== 21) return false;"
+                                                             "        var next = counter();"
+                                                             "        if (next() !== 1 || next() !== 12) return false;"
+                                                             "    }"
+                                                             "    return true;"
+                                                             "})()"));
+}
+
+// numbers are chosen not to fit in 32-bit integer or pointer too, so they are boxed differently on 32-bit
+static void testUnboxedDouble(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // slot of double representation receives non-number
+    CHECK("Unboxed double 1", evalScript(context.get(), "(function() {"
+                                                        "    function P(x) { this.x = x; }"
+                                                        "    function setX(o, v) { o.x = v; }"
+                                                        "    var objs = [];"
+                                                        "    for (var i = 0; i < 100; i++) { objs.push(new P(i + 0.5)); }"
+                                                        "    setX(objs[0], 'str'); setX(objs[1], { a: 1 }); setX(objs[2], null); setX(objs[3], undefined); setX(objs[4], true);"
+                                                        "    if (objs[0].x !== 'str' || objs[1].x.a !== 1 || objs[2].x !== null || !('x' in objs[3]) || objs[3].x !== undefined || objs[4].x !== true) return false;"
+                                                        "    for (var i = 5; i < 100; i++) { if (objs[i].x !== i + 0.5) return false; }"
+                                                        "    var arr = [1.5, 2.5, 3.5];"
+                                                        "    arr[1] = 'str'; arr.push({});"
+                                                        "    return arr[0] === 1.5 && arr[1] === 'str' && arr[2] === 3.5 && typeof arr[3] === 'object' && new P(7.25).x === 7.25;"
+                                                        "})()"));
+
+    CHECK("Unboxed double 2", evalScript(context.get(), "(function() {"
+                                                        "    var f = new Float64Array(1), u = new Uint32Array(f.buffer);"
+                                                        "    var values = [-0, NaN, 0 / 0, Infinity - Infinity, Infinity, -Infinity, 4294967296.5, -2147483649, 9007199254740993, 1e308, 5e-324];"
+                                                        "    u[0] = 1; u[1] = 0x7ff00000; values.push(f[0]);"
+                                                        "    u[0] = 0xffffffff; u[1] = 0xffffffff; values.push(f[0]);"
+                                                        "    for (var j = 0; j < 100; j++) {"
+                                                        "        for (var i = 0; i < values.length; i++) {"
+                                                        "            var o = { a: 1.5 };"
+                                                        "            o.a = values[i];"
+                                                        "            if (!Object.is(o.a, values[i])) return false;"
+                                                        "            var arr = [1.5, 2.5];"
+                                                        "            arr[0] = values[i]; arr.push(values[i]);"
+                                                        "            if (!Object.is(arr[0], values[i]) || !Object.is(arr[2], values[i]) || arr.length !== 3) return false;"
+                                                        "        }"
+                                                        "    }"
+                                                        "    var holes = [1.5, , 3.5];"
+                                                        "    holes[0] = NaN;"
+                                                        "    return !(1 in holes) && holes[1] === undefined && holes.length === 3 && Object.is(1 / [-0][0], -Infinity);"
+                                                        "})()"));
+
+    // representation is generalized after inline caches are filled with double representation
+    CHECK("Unboxed double 3", evalScript(context.get(), "(function() {"
+                                                        "    function P(x) { this.x = x; }"
+                                                        "    function get(o) { return o.x; }"
+                                                        "    function set(o, v) { o.x = v; }"
+                                                        "    function getElement(arr, i) { return arr[i]; }"
+                                                        "    var a = new P(1.5), b = new P(2.5), arr = [1.5, 2.5, 3.5];"
+                                                        "    for (var i = 0; i < 100; i++) {"
+                                                        "        set(a, i + 0.5);"
+                                                        "        if (get(a) + get(b) !== i + 3 || getElement(arr, 1) !== 2.5) return false;"
+                                                        "    }"
+                                                        "    set(b, 'str');"
+                                                        "    arr[0] = 'str';"
+                                                        "    for (var i = 0; i < 100; i++) {"
+                                                        "        set(a, i + 0.25);"
+                                                        "        var c = new P(i + 0.75);"
+                                                        "        if (get(a) !== i + 0.25 || get(b) !== 'str' || get(c) !== i + 0.75) return false;"
+                                                        "        if (getElement(arr, 0) !== 'str' || getElement(arr, 2) !== 3.5) return false;"
+                                                        "    }"
+                                                        "    set(a, -0);"
+                                                        "    return Object.is(get(a), -0);"
+                                                        "})()"));
+}
+
+// allocation sites decide their inline slot count after 8 instances
+static void testInlinePropertySlots(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // instances grow past inline slots after the count is decided
+    CHECK("Inline property slots 1", evalScript(context.get(), "(function() {"
+                                                               "    function P(a, b) { this.a = a; this.b = b; }"
+                                                               "    function literal(a) { return { a: a, b: a + 1 }; }"
+                                                               "    var objs = [];"
+                                                               "    for (var i = 0; i < 100; i++) { objs.push(new P(i, i + 1)); objs.push(literal(i)); }"
+                                                               "    for (var i = 0; i < objs.length; i++) {"
+                                                               "        for (var j = 0; j < 40; j++) { objs[i]['p' + j] = i * 100 + j; }"
+                                                               "    }"
+                                                               "    for (var i = 0; i < objs.length; i++) {"
+                                                               "        if (objs[i].a !== (i >> 1) || objs[i].b !== (i >> 1) + 1) return false;"
+                                                               "        for (var j = 0; j < 40; j++) { if (objs[i]['p' + j] !== i * 100 + j) return false; }"
+                                                               "        if (Object.keys(objs[i]).length !== 42) return false;"
+                                                               "    }"
+                                                               "    return true;"
+                                                               "})()"));
+
+    CHECK("Inline property slots 2", evalScript(context.get(), "(function() {"
+                                                               "    function P() { this.a = 1; this.b = 2; this.c = 3; }"
+                                                               "    var objs = [];"
+                                                               "    for (var i = 0; i < 100; i++) { objs.push(new P()); }"
+                                                               "    for (var i = 0; i < objs.length; i++) {"
+                                                               "        var o = objs[i];"
+                                                               "        delete o.b;"
+                                                               "        if ('b' in o || o.a !== 1 || o.c !== 3) return false;"
+                                                               "        o.d = i; o.b = i + 1;"
+                                                               "        delete o.a;"
+                                                               "        if (Object.keys(o).join() !== 'c,d,b' || o.c !== 3 || o.d !== i || o.b !== i + 1) return false;"
+                                                               "    }"
+                                                               "    return true;"
+                                                               "})()"));
+
+    // stores to inline slots after structure transition
+    CHECK("Inline property slots 3", evalScript(context.get(), "(function() {"
+                                                               "    function P(x) { this.x = x; }"
+                                                               "    function set(o, name, v) { o[name] = v; }"
+                                                               "    function setY(o, v) { o.y = v; }"
+                                                               "    var objs = [];"
+                                                               "    for (var i = 0; i < 100; i++) { objs.push(new P(i)); objs.push({ x: i }); }"
+                                                               "    for (var i = 0; i < objs.length; i++) {"
+                                                               "        setY(objs[i], i);"
+                                                               "        set(objs[i], 'z', i * 2);"
+                                                               "        setY(objs[i], i * 3);"
+                                                               "        objs[i].x = 'x' + i;"
+                                                               "    }"
+                                                               "    for (var i = 0; i < objs.length; i++) {"
+                                                               "        var o = objs[i];"
+                                                               "        if (o.x !== 'x' + i || o.y !== i * 3 || o.z !== i * 2) return false;"
+                                                               "    }"
+                                                               "    var frozen = new P(1);"
+                                                               "    Object.freeze(frozen);"
+                                                               "    frozen.x = 2;"
+                                                               "    return frozen.x === 1;"
+                                                               "})()"));
+}
+
+// object literals are created with structure cached at their CreateObject
+static void testObjectLiteralStructure(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    CHECK("Object literal structure 1", evalScript(context.get(), "(function() {"
+                                                                  "    function make(i) { return { a: i, b: i + 1, a: i + 2 }; }"
+                                                                  "    for (var i = 0; i < 100; i++) {"
+                                                                  "        var o = make(i);"
+                                                                  "        if (Object.keys(o).join() !== 'a,b' || o.a !== i + 2 || o.b !== i + 1) return false;"
+                                                                  "    }"
+                                                                  "    return true;"
+                                                                  "})()"));
+
+    CHECK("Object literal structure 2", evalScript(context.get(), "(function() {"
+                                                                  "    var proto = { p: 1 };"
+                                                                  "    function make(i) { return { __proto__: proto, a: i }; }"
+                                                                  "    function makeOwn(i) { return { ['__proto__']: i, a: i }; }"
+                                                                  "    for (var i = 0; i < 100; i++) {"
+                                                                  "        var o = make(i), own = makeOwn(i);"
+                                                                  "        if (Object.getPrototypeOf(o) !== proto || o.p !== 1 || o.a !== i || Object.keys(o).join() !== 'a') return false;"
+                                                                  "        if (Object.getPrototypeOf(own) !== Object.prototype || own.__proto__ !== i || Object.keys(own).join() !== '__proto__,a') return false;"
+                                                                  "    }"
+                                                                  "    var quoted = { '__proto__': proto }, ignored = { __proto__: 1 }, spread = { ...{ ['__proto__']: proto } };"
+                                                                  "    if (Object.getPrototypeOf(quoted) !== proto || Object.keys(quoted).length !== 0) return false;"
+                                                                  "    if (Object.getPrototypeOf(ignored) !== Object.prototype || Object.keys(ignored).length !== 0) return false;"
+                                                                  "    if (Object.getPrototypeOf(spread) !== Object.prototype || Object.keys(spread).join() !== '__proto__') return false;"
+                                                                  "    return true;"
+                                                                  "})()"));
+
+    CHECK("Object literal structure 3", evalScript(context.get(), "(function() {"
+                                                                  "    function make(i) { var k = 'k' + (i % 3); return { a: i, [k]: i, b: i }; }"
+                                                                  "    for (var i = 0; i < 100; i++) {"
+                                                                  "        var o = make(i);"
+                                                                  "        if (Object.keys(o).join() !== 'a,k' + (i % 3) + ',b' || o['k' + (i % 3)] !== i || o.b !== i) return false;"
+                                                                  "    }"
+                                                                  "    return true;"
+                                                                  "})()"));
+
+    CHECK("Object literal structure 4", evalScript(context.get(), "(function() {"
+                                                                  "    function make(i) {"
+                                                                  "        return { a: i, get b() { return this.a + 1; }, c: i, set d(v) { this.a = v; }, e: i, b: i * 2 };"
+                                                                  "    }"
+                                                                  "    for (var i = 0; i < 100; i++) {"
+                                                                  "        var o = make(i);"
+                                                                  "        if (Object.keys(o).join() !== 'a,b,c,d,e' || o.b !== i * 2 || o.c !== i || o.e !== i) return false;"
+                                                                  "        if (typeof Object.getOwnPropertyDescriptor(o, 'd').set !== 'function') return false;"
+                                                                  "        o.d = 5;"
+                                                                  "        if (o.a !== 5) return false;"
+                                                                  "    }"
+                                                                  "    return true;"
+                                                                  "})()"));
+
+    // mutating one instance should not affect instances created later
+    CHECK("Object literal structure 5", evalScript(context.get(), "(function() {"
+                                                                  "    function make(i) { return { a: i, b: i }; }"
+                                                                  "    var first = make(0);"
+                                                                  "    for (var i = 0; i < 100; i++) { make(i); }"
+                                                                  "    first.c = 1; delete first.a; Object.defineProperty(first, 'b', { writable: false }); Object.freeze(first);"
+                                                                  "    for (var i = 0; i < 100; i++) {"
+                                                                  "        var o = make(i);"
+                                                                  "        o.b = 'b';"
+                                                                  "        if (Object.keys(o).join() !== 'a,b' || o.a !== i || o.b !== 'b' || 'c' in o || !Object.isExtensible(o)) return false;"
+                                                                  "    }"
+                                                                  "    return Object.keys(first).join() === 'b,c' && Object.isFrozen(first);"
+                                                                  "})()"));
+}
+
+static void testSetObjectInlineCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // store site sees up to 4 shapes, so polymorphic cache is used
+    CHECK("Set object inline cache 1", evalScript(context.get(), "(function() {"
+                                                                 "    function set(o, v) { o.x = v; }"
+                                                                 "    var shapes = [function() { return {}; }, function() { return { a: 1 }; }, function() { return { b: 1 }; }, function() { return { a: 1, b: 1 }; }];"
+                                                                 "    for (var i = 0; i < 100; i++) {"
+                                                                 "        for (var j = 0; j < shapes.length; j++) {"
+                                                                 "            var o = shapes[j]();"
+                                                                 "            set(o, i);"
+                                                                 "            set(o, i + 1);"
+                                                                 "            if (o.x !== i + 1 || Object.keys(o).pop() !== 'x') return false;"
+                                                                 "        }"
+                                                                 "    }"
+                                                                 "    function P() {}"
+                                                                 "    var proto = P.prototype;"
+                                                                 "    for (var i = 0; i < 100; i++) { var o = new P(); set(o, i); if (!o.hasOwnProperty('x') || o.x !== i) return false; }"
+                                                                 "    var log = [];"
+                                                                 "    Object.defineProperty(proto, 'x', { set: function(v) { log.push(v); }, configurable: true });"
+                                                                 "    var o = new P();"
+                                                                 "    set(o, 7);"
+                                                                 "    if (o.hasOwnProperty('x') || log.join() !== '7') return false;"
+                                                                 "    Object.defineProperty(proto, 'x', { value: 0, writable: false, configurable: true });"
+                                                                 "    o = new P();"
+                                                                 "    set(o, 8);"
+                                                                 "    return !o.hasOwnProperty('x') && o.x === 0;"
+                                                                 "})()"));
+
+    // store site sees too many shapes, so it falls back to megamorphic cache
+    CHECK("Set object inline cache 2", evalScript(context.get(), "(function() {"
+                                                                 "    function set(o, v) { o.x = v; }"
+                                                                 "    function strictSet(o, v) { 'use strict'; o.x = v; }"
+                                                                 "    var objs = [];"
+                                                                 "    for (var j = 0; j < 40; j++) { var o = {}; o['p' + j] = j; objs.push(o); }"
+                                                                 "    for (var i = 0; i < 100; i++) {"
+                                                                 "        for (var j = 0; j < objs.length; j++) {"
+                                                                 "            set(objs[j], i * j);"
+                                                                 "            strictSet(objs[j], i + j);"
+                                                                 "            if (objs[j].x !== i + j) return false;"
+                                                                 "        }"
+                                                                 "    }"
+                                                                 "    var log = [];"
+                                                                 "    var proto = Object.defineProperty({}, 'x', { set: function(v) { log.push(v); } });"
+                                                                 "    for (var j = 0; j < 40; j++) {"
+                                                                 "        var o = Object.create(proto);"
+                                                                 "        o['q' + j] = j;"
+                                                                 "        set(o, j);"
+                                                                 "        if (o.hasOwnProperty('x')) return false;"
+                                                                 "    }"
+                                                                 "    var frozen = Object.freeze({ x: 1 });"
+                                                                 "    set(frozen, 2);"
+                                                                 "    try { strictSet(frozen, 3); return false; } catch (e) { if (!(e instanceof TypeError)) return false; }"
+                                                                 "    return log.length === 40 && frozen.x === 1;"
+                                                                 "})()"));
+}
+
+static void testCallTargetCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // cache is keyed by code block. each closure should still run with its own environment
+    CHECK("Call target cache 1", evalScript(context.get(), "(function() {"
+                                                           "    function adder(n) { return function(x) { return x + n; }; }"
+                                                           "    function apply(f, x) { return f(x); }"
+                                                           "    var sum = 0;"
+                                                           "    for (var i = 0; i < 100; i++) { sum += apply(adder(i), 1); }"
+                                                           "    var o = { n: 5, get: function() { return this.n; } };"
+                                                           "    var p = { n: 7, get: o.get };"
+                                                           "    function callGet(obj) { return obj.get(); }"
+                                                           "    for (var i = 0; i < 10; i++) { sum += callGet(o) + callGet(p); }"
+                                                           "    sum += apply(function(x) { return x * 3; }, 2) + apply(Math.abs, -4) + apply(adder(10).bind(null), 1);"
+                                                           "    return sum === 5050 + 120 + 6 + 4 + 11;"
+                                                           "})()"));
+}
+
+static std::string executeSharedScript(ContextRef* context, ScriptRef* script)
+{
+    auto evalResult = Evaluator::execute(context, [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         script);
+    return evalResult.resultOrErrorToString(context)->toStdUTF8String();
+}
+
+static void testSharedScript(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> contextA = ContextRef::create(instance);
+    PersistentRefHolder<ContextRef> contextB = ContextRef::create(instance);
+    evalScript(contextA.get(), "var onlyInA = 1; true");
+
+    // globals of each context are separated, and objects are made with intrinsics of the executing context
+    const char* source = "var counter = (typeof counter === 'number' ? counter : 0) + 1;"
+                         "function readCounter() { var sum = 0; for (var i = 0; i < 10; i++) { sum += counter; } return sum / 10; }"
+                         "function make() { return [[], {}, function() {}, /a/]; }"
+                         "var r = make();"
+                         "[readCounter(), typeof onlyInA, r[0] instanceof Array, Object.getPrototypeOf(r[0]) === Array.prototype,"
+                         " Object.getPrototypeOf(r[1]) === Object.prototype, Object.getPrototypeOf(r[2]) === Function.prototype,"
+                         " Object.getPrototypeOf(r[3]) === RegExp.prototype, readCounter.constructor === Function].join()";
+    auto initializeResult = contextA->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("testshared.js"));
+    if (!initializeResult.isSuccessful()) {
+        CHECK("Shared script 1", false);
+        return;
+    }
+    ScriptRef* script = initializeResult.script.get();
+    CHECK("Shared script 1", script->shareAcrossContexts() && script->isSharedAcrossContexts());
+
+    std::string resultA1 = executeSharedScript(contextA.get(), script);
+    std::string resultB1 = executeSharedScript(contextB.get(), script);
+    std::string resultA2 = executeSharedScript(contextA.get(), script);
+    std::string resultB2 = executeSharedScript(contextB.get(), script);
+    CHECK("Shared script 2", resultA1 == "1,number,true,true,true,true,true,true" && resultB1 == "1,undefined,true,true,true,true,true,true");
+    CHECK("Shared script 3", resultA2 == "2,number,true,true,true,true,true,true" && resultB2 == "2,undefined,true,true,true,true,true,true");
+
+    // functions made by shared script belong to the realm of the context which executed it
+    CHECK("Shared script 4", evalScript(contextA.get(), "Object.getPrototypeOf(make()[0]) === Array.prototype && readCounter() === 2")
+              && evalScript(contextB.get(), "Object.getPrototypeOf(make()[0]) === Array.prototype && readCounter() === 2 && typeof onlyInA === 'undefined'"));
+}
+
+static void testCompareAndJump(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // fused compare site is quickened for int32, then sees double and string operands
+    CHECK("Compare and jump 1", evalScript(context.get(), "(function() {"
+                                                          "    function less(a, b) { if (a < b) return 1; return 0; }"
+                                                          "    function count(n) { var c = 0; for (var i = 0; i < n; i++) { if (i >= 3) c++; } return c; }"
+                                                          "    var sum = 0;"
+                                                          "    for (var i = 0; i < 100; i++) { sum += less(i, 50) + count(10); }"
+                                                          "    for (var i = 0; i < 100; i++) { sum += less(i + 0.5, 50.5); }"
+                                                          "    sum += less('a', 'b') + less('b', 'a') + less(1, '2') + less(NaN, 1) + less({ valueOf() { return -1; } }, 0);"
+                                                          "    return sum === 50 + 700 + 50 + 3;"
+                                                          "})()"));
+
+    // compare result read after the branch should be stored
+    CHECK("Compare and jump 2", evalScript(context.get(), "(function() {"
+                                                          "    function and(a, b) { return a < b && 'yes'; }"
+                                                          "    function or(a, b) { return a === b || a > b; }"
+                                                          "    function saved(a, b) { var r = a <= b; if (r) { return r; } return r; }"
+                                                          "    for (var i = 0; i < 100; i++) {"
+                                                          "        if (and(1, 2) !== 'yes' || and(2, 1) !== false) return false;"
+                                                          "        if (or(2, 2) !== true || or(3, 2) !== true || or(1, 2) !== false) return false;"
+                                                          "        if (saved(1, 2) !== true || saved(2, 1) !== false) return false;"
+                                                          "    }"
+                                                          "    return true;"
+                                                          "})()"));
+}
+
+static void testTypedArrayElementCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // one site sees arrays and typed arrays of every element type
+    CHECK("Typed array element cache 1", evalScript(context.get(), "(function() {"
+                                                                   "    function get(a, i) { return a[i]; }"
+                                                                   "    function set(a, i, v) { a[i] = v; }"
+                                                                   "    var arrays = [new Int8Array(4), new Uint8ClampedArray(4), new Float64Array(4), new Uint32Array(4), [0, 0, 0, 0]];"
+                                                                   "    for (var n = 0; n < 100; n++) {"
+                                                                   "        for (var k = 0; k < arrays.length; k++) { set(arrays[k], n % 4, n * 3 + 0.5); }"
+                                                                   "    }"
+                                                                   "    var out = [];"
+                                                                   "    for (var k = 0; k < arrays.length; k++) { out.push(get(arrays[k], 3)); }"
+                                                                   "    return out.join() === '41,255,297.5,297,297.5';"
+                                                                   "})()"));
+
+    // keys which are not in-bound uint32 and values which are not number take the generic path
+    CHECK("Typed array element cache 2", evalScript(context.get(), "(function() {"
+                                                                   "    function get(a, i) { return a[i]; }"
+                                                                   "    function set(a, i, v) { a[i] = v; }"
+                                                                   "    var a = new Int16Array(2);"
+                                                                   "    for (var n = 0; n < 100; n++) { set(a, n & 1, n); }"
+                                                                   "    set(a, 5, 1); set(a, -1, 1); set(a, 1.5, 1); set(a, 'x', 7);"
+                                                                   "    set(a, 0, '12'); set(a, 1, { valueOf() { return 70000; } });"
+                                                                   "    var r = [get(a, 0), get(a, 1), get(a, 5), get(a, -1), get(a, 1.5), get(a, 'x'), a.length].join();"
+                                                                   "    return r === '12,4464,,,,7,2';"
+                                                                   "})()"));
+}
+
+static void testPropertyAccessStubCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // megamorphic sites with lookups through prototype chain, and changes of holder or prototype
+    CHECK("Property access stub cache 1", evalScript(context.get(), "(function() {"
+                                                                    "    var proto = { x: 1 };"
+                                                                    "    function make(i) { var o = Object.create(proto); o['p' + i] = i; return o; }"
+                                                                    "    function getX(o) { return o.x; }"
+                                                                    "    function getX2(o) { return o.x; }"
+                                                                    "    var objects = [];"
+                                                                    "    for (var i = 0; i < 40; i++) { objects.push(make(i)); }"
+                                                                    "    var sum = 0;"
+                                                                    "    for (var n = 0; n < 5; n++) { for (var i = 0; i < 40; i++) { sum += getX(objects[i]) + getX2(objects[i]); } }"
+                                                                    "    if (sum !== 400) return false;"
+                                                                    "    proto.x = 2;"
+                                                                    "    objects[3].x = 10;"
+                                                                    "    Object.defineProperty(proto, 'x', { get() { return 3; } });"
+                                                                    "    sum = 0;"
+                                                                    "    for (var i = 0; i < 40; i++) { sum += getX(objects[i]); }"
+                                                                    "    if (sum !== 39 * 3 + 10) return false;"
+                                                                    "    delete proto.x;"
+                                                                    "    Object.setPrototypeOf(proto, { x: 5 });"
+                                                                    "    sum = 0;"
+                                                                    "    for (var i = 0; i < 40; i++) { sum += getX2(objects[i]); }"
+                                                                    "    return sum === 39 * 5 + 10;"
+                                                                    "})()"));
+
+    // megamorphic stores only overwrite own writable data property
+    CHECK("Property access stub cache 2", evalScript(context.get(), "(function() {"
+                                                                    "    function make(i) { var o = { v: 0 }; o['p' + i] = i; return o; }"
+                                                                    "    function setV(o, v) { o.v = v; }"
+                                                                    "    var objects = [];"
+                                                                    "    for (var i = 0; i < 40; i++) { objects.push(make(i)); }"
+                                                                    "    for (var n = 0; n < 5; n++) { for (var i = 0; i < 40; i++) { setV(objects[i], n); } }"
+                                                                    "    Object.defineProperty(objects[1], 'v', { writable: false });"
+                                                                    "    var log = 0;"
+                                                                    "    Object.defineProperty(objects[2], 'v', { set(v) { log = v; } });"
+                                                                    "    Object.freeze(objects[3]);"
+                                                                    "    for (var i = 0; i < 40; i++) { setV(objects[i], 9); }"
+                                                                    "    return objects[0].v === 9 && objects[1].v === 4 && log === 9 && objects[3].v === 4 && objects[39].v === 9;"
+                                                                    "})()"));
+
+    // cache is cleared on GC. sites should keep working with structures made after GC
+    evalScript(context.get(), "function getY(o) { return o.y; }"
+                              "var objs = [];"
+                              "for (var i = 0; i < 40; i++) { var o = { y: i }; o['q' + i] = i; objs.push(o); getY(o); }"
+                              "true");
+    Memory::gc();
+    CHECK("Property access stub cache 3", evalScript(context.get(), "(function() {"
+                                                                    "    var sum = 0;"
+                                                                    "    for (var i = 0; i < 40; i++) { var o = { y: 1 }; o['r' + i] = i; sum += getY(o) + getY(objs[i]); }"
+                                                                    "    return sum === 40 + 780;"
+                                                                    "})()"));
+}
+
+static void testInstanceOfAndInCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // instanceof should see reassigned `prototype`, @@hasInstance and prototype chain changes
+    CHECK("instanceof cache 1", evalScript(context.get(), "(function() {"
+                                                          "    function A() {}"
+                                                          "    function B() {}"
+                                                          "    function test(o, C) { return o instanceof C; }"
+                                                          "    var a = new A(), b = new B();"
+                                                          "    for (var i = 0; i < 100; i++) { if (!test(a, A) || test(b, A) || !test(a, Object)) return false; }"
+                                                          "    var oldPrototype = A.prototype;"
+                                                          "    A.prototype = B.prototype;"
+                                                          "    if (test(a, A) || !test(b, A)) return false;"
+                                                          "    A.prototype = oldPrototype;"
+                                                          "    Object.setPrototypeOf(b, a);"
+                                                          "    if (!test(b, A)) return false;"
+                                                          "    Object.defineProperty(A, Symbol.hasInstance, { value: function(o) { return o === 1; } });"
+                                                          "    if (test(a, A) || !test(1, A)) return false;"
+                                                          "    var bound = B.bind(null);"
+                                                          "    return test(new B(), bound) && !test(a, bound);"
+                                                          "})()"));
+
+    // cached `in` results should follow property addition and deletion on receiver and prototype
+    CHECK("in cache 1", evalScript(context.get(), "(function() {"
+                                                  "    var proto = {};"
+                                                  "    function has(o) { return 'k' in o; }"
+                                                  "    function hasSymbol(o, s) { return s in o; }"
+                                                  "    var o = Object.create(proto), s = Symbol();"
+                                                  "    for (var i = 0; i < 100; i++) { if (has(o) || hasSymbol(o, s)) return false; }"
+                                                  "    proto.k = 1;"
+                                                  "    proto[s] = 1;"
+                                                  "    if (!has(o) || !hasSymbol(o, s)) return false;"
+                                                  "    delete proto.k;"
+                                                  "    if (has(o)) return false;"
+                                                  "    o.k = undefined;"
+                                                  "    if (!has(o)) return false;"
+                                                  "    var p = new Proxy({}, { has(t, key) { return key === 'k'; } });"
+                                                  "    return has(p) && has([]) === false && has({ k: 1 }) && has(Object.create(o));"
+                                                  "})()"));
+}
+
+static void testScopeShapeCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // sloppy eval can add a binding which shadows the cached one
+    CHECK("Scope shape cache 1", evalScript(context.get(), "(function() {"
+                                                           "    var x = 'outer';"
+                                                           "    function test(code) { eval(code); return function() { return x; }; }"
+                                                           "    var r = [];"
+                                                           "    for (var i = 0; i < 50; i++) { r.push(test('')()); }"
+                                                           "    r.push(test('var x = \"eval\"')());"
+                                                           "    function inner(code) { eval(code); var sum = ''; for (var i = 0; i < 20; i++) { sum = x; } return sum; }"
+                                                           "    for (var i = 0; i < 50; i++) { inner(''); }"
+                                                           "    r.push(inner('var x = \"inner\"'), inner(''));"
+                                                           "    return r.slice(48).join() === 'outer,outer,eval,inner,outer';"
+                                                           "})()"));
+
+    // with scope depends on the object and its prototype chain
+    CHECK("Scope shape cache 2", evalScript(context.get(), "(function() {"
+                                                           "    var v = 'local';"
+                                                           "    function read(o) { with (o) { return v; } }"
+                                                           "    function write(o, value) { with (o) { v = value; } }"
+                                                           "    var proto = {}, o = Object.create(proto), r = [];"
+                                                           "    for (var i = 0; i < 50; i++) { r.push(read(o)); }"
+                                                           "    proto.v = 'proto';"
+                                                           "    r.push(read(o));"
+                                                           "    o.v = 'own';"
+                                                           "    r.push(read(o));"
+                                                           "    o[Symbol.unscopables] = { v: true };"
+                                                           "    r.push(read(o));"
+                                                           "    for (var i = 0; i < 50; i++) { write({}, i); }"
+                                                           "    var target = { v: 0 };"
+                                                           "    write(target, 'w');"
+                                                           "    return r.slice(49).join() === 'local,proto,own,local' && v === 49 && target.v === 'w';"
+                                                           "})()"));
+
+    // global property shadowed by top-level lexical declaration made later
+    evalScript(context.get(), "var scopeShapeGlobal = 'var';"
+                              "function readScopeShapeGlobal() { return scopeShapeGlobal; }"
+                              "for (var i = 0; i < 50; i++) { readScopeShapeGlobal(); }"
+                              "true");
+    CHECK("Scope shape cache 3", evalScript(context.get(), "globalThis.lateGlobal = 'property';"
+                                                           "function readLateGlobal() { return lateGlobal; }"
+                                                           "for (var i = 0; i < 50; i++) { readLateGlobal(); }"
+                                                           "readScopeShapeGlobal() === 'var' && readLateGlobal() === 'property'"));
+    CHECK("Scope shape cache 4", evalScript(context.get(), "let lateGlobal = 'let';"
+                                                           "delete globalThis.scopeShapeGlobal;"
+                                                           "readLateGlobal() === 'let' && readScopeShapeGlobal() === 'var'"));
+}
+
+static void testSharedBuiltinStructure(VMInstanceRef* instance)
+{
+    // builtins of contexts made later follow structures recorded by the first context.
+    // changes on builtins of one context should not be visible in another
+    PersistentRefHolder<ContextRef> contextA = ContextRef::create(instance);
+    CHECK("Shared builtin structure 1", evalScript(contextA.get(), "Array.prototype.extra = 1;"
+                                                                   "delete Math.max;"
+                                                                   "Object.defineProperty(String.prototype, 'trim', { value: function() { return 'patched'; } });"
+                                                                   "[].extra === 1 && Math.max === undefined && ' a '.trim() === 'patched'"));
+
+    PersistentRefHolder<ContextRef> contextB = ContextRef::create(instance);
+    CHECK("Shared builtin structure 2", evalScript(contextB.get(), "(function() {"
+                                                                   "    if ([].extra !== undefined || Math.max(1, 2) !== 2 || ' a '.trim() !== 'a') return false;"
+                                                                   "    var names = Object.getOwnPropertyNames(Array.prototype);"
+                                                                   "    if (names.indexOf('map') < 0 || names.indexOf('extra') >= 0) return false;"
+                                                                   "    var d = Object.getOwnPropertyDescriptor(Math, 'PI');"
+                                                                   "    if (d.writable || d.enumerable || d.configurable) return false;"
+                                                                   "    d = Object.getOwnPropertyDescriptor(Array.prototype, 'push');"
+                                                                   "    if (!d.writable || d.enumerable || !d.configurable) return false;"
+                                                                   "    Array.prototype.push = function() { return 'b'; };"
+                                                                   "    return [].push(1) === 'b';"
+                                                                   "})()"));
+    CHECK("Shared builtin structure 3", evalScript(contextA.get(), "[].push(1) === 1 && Object.keys(Math).length === 0"));
+}
+
+static void testLazyBuiltins(VMInstanceRef* instance)
+{
+    // lazily installed globals should act as plain data properties of global object
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    CHECK("Lazy builtin 1", evalScript(context.get(), "(function() {"
+                                                      "    var d = Object.getOwnPropertyDescriptor(globalThis, 'Map');"
+                                                      "    if (typeof d.value !== 'function' || !d.writable || d.enumerable || !d.configurable) return false;"
+                                                      "    if (new Map([[1, 2]]).get(1) !== 2 || !(new Set([1]).has(1)) || Reflect.ownKeys({ a: 1 }).join() !== 'a') return false;"
+                                                      "    var keys = Object.getOwnPropertyNames(globalThis);"
+                                                      "    return ['Proxy', 'Reflect', 'DataView', 'WeakMap', 'WeakSet'].every(function(name) { return keys.indexOf(name) >= 0; });"
+                                                      "})()"));
+
+    // a global reached through prototype chain installs the builtin too
+    PersistentRefHolder<ContextRef> context2 = ContextRef::create(instance);
+    CHECK("Lazy builtin 2", evalScript(context2.get(), "(function() {"
+                                                       "    var o = Object.create(globalThis);"
+                                                       "    function get(o) { return o.WeakMap; }"
+                                                       "    for (var i = 0; i < 20; i++) { if (typeof get(o) !== 'function') return false; }"
+                                                       "    return get(o) === WeakMap && new (get(o))() instanceof WeakMap;"
+                                                       "})()"));
+
+    // writing, deleting or freezing before first read should not install builtin afterwards
+    PersistentRefHolder<ContextRef> context3 = ContextRef::create(instance);
+    CHECK("Lazy builtin 3", evalScript(context3.get(), "(function() {"
+                                                       "    Set = 1;"
+                                                       "    delete globalThis.Reflect;"
+                                                       "    Object.defineProperty(globalThis, 'DataView', { enumerable: true });"
+                                                       "    if (Set !== 1 || typeof Reflect !== 'undefined' || 'Reflect' in globalThis) return false;"
+                                                       "    if (Object.keys(globalThis).indexOf('DataView') < 0 || typeof DataView !== 'function') return false;"
+                                                       "    return new Map().set(1, 2).size === 1 && new Proxy({}, {}) !== null;"
+                                                       "})()"));
+}
+
+static void testByteCodeEviction(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    CHECK("Bytecode eviction 1", evalScript(context.get(), "function evictAdd(a, b) { var o = { a: a }; o.b = b; return o.a + o.b; }"
+                                                           "function evictCounter() { var c = 0; return function() { return ++c; }; }"
+                                                           "function* evictGen() { var x = yield 1; yield x * 2; return 'done'; }"
+                                                           "var evictCount = evictCounter();"
+                                                           "var evictIt = evictGen();"
+                                                           "var evictSum = 0;"
+                                                           "for (var i = 0; i < 100; i++) { evictSum += evictAdd(i, 1); evictCount(); }"
+                                                           "evictSum === 5050 && evictIt.next().value === 1"));
+
+    // release bytecode of every function which is not called between GCs, then run them again
+    size_t oldMaxSize = instance->maxCompiledByteCodeSize();
+    instance->setMaxCompiledByteCodeSize(0);
+    for (int i = 0; i < 4; i++) {
+        Memory::gc();
+    }
+    CHECK("Bytecode eviction 2", evalScript(context.get(), "evictAdd(1, 2) === 3 && evictAdd(1.5, 'x') === '1.5x' && evictCount() === 101"
+                                                           "&& evictIt.next(5).value === 10 && evictIt.next().value === 'done'"
+                                                           "&& evictCounter()() === 1"));
+    for (int i = 0; i < 4; i++) {
+        Memory::gc();
+    }
+    CHECK("Bytecode eviction 3", evalScript(context.get(), "(function() {"
+                                                           "    var sum = 0;"
+                                                           "    for (var i = 0; i < 100; i++) { sum += evictAdd(i, 1); }"
+                                                           "    try { evictAdd(null); } catch (e) { return false; }"
+                                                           "    return sum === 5050 && evictCount() === 102;"
+                                                           "})()"));
+    instance->setMaxCompiledByteCodeSize(oldMaxSize);
+}
+
+static void testLOCTable(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // functions with more bytecodes than a LOC table checkpoint interval
+    CHECK("LOC table 1", evalScript(context.get(), "function errorPosition(e) { var m = /testoptimizations\\.js:(\\d+):(\\d+)/.exec(e.stack); return m ? [+m[1], +m[2]] : [0, 0]; }\n"
+                                                   "function many(k) {\n"
+                                                   "    var a = k + 1, b = a * 2, c = b - 3, d = c / 4, e = d % 5, f = e + a, g = f * b, h = g - c;\n"
+                                                   "    var i = h + 1, j = i * 2, l = j - 3, m = l / 4, n = m % 5, o = n + i, p = o * j, q = p - l;\n"
+                                                   "    var r = q + 1, s = r * 2, t = s - 3, u = t / 4, v = u % 5, w = v + r, x = w * s, y = x - t;\n"
+                                                   "    if (k > 1) { null.x; }\n"
+                                                   "    var z = y + y + y + y + y + y + y + y; throw new Error('many');\n"
+                                                   "}\n"
+                                                   "function two(k) { if (k) { undefined.a; } else { k.b.c; } }\n"
+                                                   "(function() {\n"
+                                                   "    var r = [];\n"
+                                                   "    try { many(2); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    try { many(0); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    for (var i = 0; i < 50; i++) { try { many(i & 1); } catch (e) { } }\n"
+                                                   "    try { many(2); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    try { two(1); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    try { two(0); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    return r[0][0] === 6 && r[1][0] === 7 && r[2][0] === 6 && r[2][1] === r[0][1] && r[1][1] > r[0][1]\n"
+                                                   "        && r[3][0] === 9 && r[4][0] === 9 && r[4][1] > r[3][1];\n"
+                                                   "})()"));
+
+    // LOC data is computed again from source after bytecode is released
+    size_t oldMaxSize = instance->maxCompiledByteCodeSize();
+    instance->setMaxCompiledByteCodeSize(0);
+    for (int i = 0; i < 4; i++) {
+        Memory::gc();
+    }
+    instance->setMaxCompiledByteCodeSize(oldMaxSize);
+    CHECK("LOC table 2", evalScript(context.get(), "(function() {\n"
+                                                   "    var r = [];\n"
+                                                   "    try { many(2); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    try { two(0); } catch (e) { r.push(errorPosition(e)); }\n"
+                                                   "    return r[0][0] === 6 && r[1][0] === 9 && r[1][1] > 30;\n"
+                                                   "})()"));
+}
+
+static void testCompactByteCode(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // operands of every bytecode kind should be kept right after the opcode.
+    // meaningful on ESCARGOT_COMPACT_BYTECODE build, where operands live in tail padding of the header
+    CHECK("Compact bytecode 1", evalScript(context.get(), "(function() {"
+                                                          "    var literals = [1, -0.5, 'str', true, null, undefined, 1e300, 0x7fffffff + 1, /re/g.source, `t${1 + 1}t`];"
+                                                          "    var moved = literals.slice(), a = 1, b = a, c = b;"
+                                                          "    var o = { a: a, b: 'b', c: [c], ['d' + 1]: 4, get e() { return 5; } };"
+                                                          "    var s = 0;"
+                                                          "    for (var k in o) { s += k.length; }"
+                                                          "    for (var v of [1, 2, 3]) { s += v; }"
+                                                          "    switch (s) { case 12: s += 100; break; default: s = -1; }"
+                                                          "    try { throw s; } catch (e) { s = e + 1; } finally { s += 1; }"
+                                                          "    function* g() { var x = yield 1; yield x + 1; }"
+                                                          "    var it = g(); it.next();"
+                                                          "    s += it.next(10).value;"
+                                                          "    var [p, ...q] = [1, 2, 3], { a: r, ...t } = o;"
+                                                          "    s += p + q.length + r + Object.keys(t).length;"
+                                                          "    class K { constructor(v) { this.v = v; } get w() { return this.v * 2; } static make() { return new K(3); } }"
+                                                          "    s += K.make().w + Math.max(...[1, 7, 3]) + (typeof K).length;"
+                                                          "    return moved.join() === '1,-0.5,str,true,,,1e+300,2147483648,re,t2t' && s === 114 + 11 + 8 + 21;"
+                                                          "})()"));
+}
+
+static void testColdCatchClause(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // catch clauses are moved to the end of bytecode. control flow out of them and their error positions should be kept
+    CHECK("Cold catch clause 1", evalScript(context.get(), "function catchPosition(e) { var m = /testoptimizations\\.js:(\\d+):(\\d+)/.exec(e.stack); return m ? +m[1] : 0; }\n"
+                                                           "function nested(k) {\n"
+                                                           "    var log = '';\n"
+                                                           "    for (var i = 0; i < 3; i++) {\n"
+                                                           "        try { if (i === k) throw i; log += 't'; }\n"
+                                                           "        catch (e) { try { if (k > 1) throw 'inner'; log += 'c'; } catch (f) { log += 'f'; continue; } finally { log += 'n'; } if (k === 0) break; }\n"
+                                                           "        finally { log += 'F'; }\n"
+                                                           "    }\n"
+                                                           "    return log;\n"
+                                                           "}\n"
+                                                           "function rethrow() {\n"
+                                                           "    try { undefined.x; }\n"
+                                                           "    catch (e) {\n"
+                                                           "        null.y;\n"
+                                                           "    }\n"
+                                                           "}\n"
+                                                           "function returnFromCatch(v) { try { throw v; } catch (e) { return e * 2; } return -1; }\n"
+                                                           "(function() {\n"
+                                                           "    var r = [];\n"
+                                                           "    for (var i = 0; i < 20; i++) { r = [nested(0), nested(1), nested(2), returnFromCatch(i)]; }\n"
+                                                           "    try { rethrow(); } catch (e) { r.push(catchPosition(e), e instanceof TypeError); }\n"
+                                                           "    return r.join() === 'cnF,tFcnFtF,tFtFfnF,38,14,true';\n"
+                                                           "})()"));
+}
+
+static void testConstructorPrototypeCache(VMInstanceRef* instance)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+
+    // instances keep prototype they were created with after `prototype` is reassigned
+    CHECK("Constructor prototype cache 1", evalScript(context.get(), "(function() {"
+                                                                     "    function F() { this.a = 1; }"
+                                                                     "    var before = [];"
+                                                                     "    for (var i = 0; i < 10; i++) before.push(new F());"
+                                                                     "    var oldPrototype = F.prototype;"
+                                                                     "    F.prototype = { kind: 'new' };"
+                                                                     "    var after = [];"
+                                                                     "    for (var i = 0; i < 10; i++) after.push(new F());"
+                                                                     "    return before.every(function(o) { return Object.getPrototypeOf(o) === oldPrototype && o.kind === undefined; })"
+                                                                     "        && after.every(function(o) { return Object.getPrototypeOf(o) === F.prototype && o.kind === 'new' && o instanceof F; });"
+                                                                     "})()"));
+
+    // non-object `prototype` falls back to Object.prototype of function realm
+    CHECK("Constructor prototype cache 2", evalScript(context.get(), "(function() {"
+                                                                     "    function F() {}"
+                                                                     "    var result = [];"
+                                                                     "    for (var i = 0; i < 5; i++) new F();"
+                                                                     "    F.prototype = 1;"
+                                                                     "    for (var i = 0; i < 5; i++) result.push(Object.getPrototypeOf(new F()) === Object.prototype);"
+                                                                     "    F.prototype = null;"
+                                                                     "    result.push(Object.getPrototypeOf(new F()) === Object.prototype);"
+                                                                     "    F.prototype = { p: 1 };"
+                                                                     "    result.push(new F().p === 1);"
+                                                                     "    return result.every(function(v) { return v; }) && result.length === 7;"
+                                                                     "})()"));
+
+    // class constructors and Reflect.construct with another new.target
+    CHECK("Constructor prototype cache 3", evalScript(context.get(), "(function() {"
+                                                                     "    class A { constructor() { this.x = 1; } get kind() { return 'A'; } }"
+                                                                     "    function Other() {}"
+                                                                     "    Other.prototype.kind = 'Other';"
+                                                                     "    var kinds = [];"
+                                                                     "    for (var i = 0; i < 6; i++) {"
+                                                                     "        var o = i % 2 ? Reflect.construct(A, [], Other) : new A();"
+                                                                     "        kinds.push(o.kind + o.x);"
+                                                                     "    }"
+                                                                     "    function G() { this.y = 2; }"
+                                                                     "    var g = Reflect.construct(G, [], A);"
+                                                                     "    var h = new G();"
+                                                                     "    return kinds.join() + ',' + g.kind + g.y + ',' + (Object.getPrototypeOf(h) === G.prototype);"
+                                                                     "})() === 'A1,Other1,A1,Other1,A1,Other1,A2,true'"));
+
+    // prototype object mutated in place is still shared by cached instances
+    CHECK("Constructor prototype cache 4", evalScript(context.get(), "(function() {"
+                                                                     "    function F() {}"
+                                                                     "    var first = new F();"
+                                                                     "    F.prototype.value = 1;"
+                                                                     "    var second = new F();"
+                                                                     "    F.prototype.value = 2;"
+                                                                     "    Object.setPrototypeOf(F.prototype, { inherited: 3 });"
+                                                                     "    var third = new F();"
+                                                                     "    return [first.value, second.value, third.value, first.inherited, third.inherited].join();"
+                                                                     "})() === '2,2,2,3,3'"));
+}
+
+static std::vector<char> readFile(const std::string& path)
+{
+    std::vector<char> content;
+    FILE* fp = fopen(path.data(), "rb");
+    if (fp) {
+        char buf[4096];
+        size_t readLength;
+        while ((readLength = fread(buf, 1, sizeof(buf), fp)) > 0) {
+            content.insert(content.end(), buf, buf + readLength);
+        }
+        fclose(fp);
+    }
+    return content;
+}
+
+// file is rewritten in place, so its inode is kept
+static void writeFile(const std::string& path, const std::vector<char>& content)
+{
+    FILE* fp = fopen(path.data(), "wb");
+    if (fp) {
+        if (content.size()) {
+            fwrite(content.data(), content.size(), 1, fp);
+        }
+        fclose(fp);
+    }
+}
+
+static std::string findCacheFile(const char* directory)
+{
+    std::string result;
+    DIR* dir = opendir(directory);
+    if (dir) {
+        while (struct dirent* entry = readdir(dir)) {
+            std::string name(entry->d_name);
+            if (name.length() > 6 && name.compare(name.length() - 6, 6, ".cache") == 0) {
+                result = std::string(directory) + "/" + name;
+            }
+        }
+        closedir(dir);
+    }
+    return result;
+}
+
+// cache store writes a new file and renames it, so replaced cache file has another inode
+static ino_t inodeOf(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.data(), &st) != 0) {
+        return 0;
+    }
+    return st.st_ino;
+}
+
+static bool evalScriptWithCodeCache(VMInstanceRef* instance, const char* directory, const char* source, std::string& result)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    context->scriptParser()->setCodeCacheDirectory(directory);
+
+    auto initializeResult = context->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("testcodecache.js"));
+    if (!initializeResult.isSuccessful()) {
+        return false;
+    }
+
+    auto evalResult = Evaluator::execute(context.get(), [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         initializeResult.script.get());
+    result = evalResult.resultOrErrorToString(context.get())->toStdUTF8String();
+    return evalResult.isSuccessful();
+}
+
+static void testCodeCache(VMInstanceRef* instance)
+{
+    char directory[] = "/tmp/escargot-codecache-XXXXXX";
+    if (!mkdtemp(directory)) {
+        CHECK("Code cache 1", false);
+        return;
+    }
+
+    const char* source = "var cacheTest = (function() {"
+                         "    class Point { constructor(x, y) { this.x = x; this.y = y; } get length() { return Math.sqrt(this.x * this.x + this.y * this.y); } }"
+                         "    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }"
+                         "    var words = 'alpha beta gamma'.split(/\\s+/).map(function(w) { return w.toUpperCase(); });"
+                         "    var sum = 0;"
+                         "    for (let i = 0; i < 100; i++) { sum += i; }"
+                         "    try { null.x; } catch (e) { words.push(e instanceof TypeError); }"
+                         "    return `${new Point(3, 4).length},${fib(15)},${words.join('-')},${sum}`;"
+                         "})();"
+                         "cacheTest;";
+    const char* expected = "5,610,ALPHA-BETA-GAMMA-true,4950";
+
+    // first run stores the cache
+    std::string result;
+    CHECK("Code cache 1", evalScriptWithCodeCache(instance, directory, source, result) && result == expected);
+    std::string cacheFile = findCacheFile(directory);
+    std::vector<char> content = readFile(cacheFile);
+    CHECK("Code cache 2", cacheFile.length() && content.size() > 8);
+
+    // second run loads the cache and does not store it again
+    ino_t inode = inodeOf(cacheFile);
+    CHECK("Code cache 3", evalScriptWithCodeCache(instance, directory, source, result) && result == expected && inodeOf(cacheFile) == inode);
+
+    // stale or corrupted cache is rejected, and fresh one is stored instead
+    auto isRejected = [&](const std::vector<char>& corrupted) -> bool {
+        writeFile(cacheFile, corrupted);
+        ino_t corruptedInode = inodeOf(cacheFile);
+        std::string rerunResult;
+        if (!evalScriptWithCodeCache(instance, directory, source, rerunResult) || rerunResult != expected) {
+            return false;
+        }
+        std::vector<char> stored = readFile(cacheFile);
+        return inodeOf(cacheFile) != corruptedInode && stored.size() == content.size() && memcmp(stored.data(), content.data(), 8) == 0;
+    };
+
+    std::vector<char> corrupted = content;
+    corrupted[4]++; // version
+    CHECK("Code cache 4", isRejected(corrupted));
+    corrupted = content;
+    corrupted[16]++; // source hash
+    CHECK("Code cache 5", isRejected(corrupted));
+    corrupted = content;
+    corrupted.resize(content.size() / 2);
+    CHECK("Code cache 6", isRejected(corrupted));
+    corrupted.clear();
+    CHECK("Code cache 7", isRejected(corrupted));
+
+    unlink(cacheFile.data());
+    rmdir(directory);
+}
+
+static bool evalScriptFromBundle(VMInstanceRef* instance, const char* bundleFile, std::string& result)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    std::vector<char> bundle = readFile(bundleFile);
+    auto initializeResult = context->scriptParser()->initializeScriptWithBundle(bundle.data(), bundle.size(), StringRef::createFromASCII("testbundle.js"));
+    if (!initializeResult.isSuccessful()) {
+        return false;
+    }
+
+    auto evalResult = Evaluator::execute(context.get(), [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         initializeResult.script.get());
+    result = evalResult.resultOrErrorToString(context.get())->toStdUTF8String();
+    return evalResult.isSuccessful();
+}
+
+static void testBundle(VMInstanceRef* instance)
+{
+    char directory[] = "/tmp/escargot-bundle-XXXXXX";
+    if (!mkdtemp(directory)) {
+        CHECK("Bundle 1", false);
+        return;
+    }
+    std::string bundleFile = std::string(directory) + "/test.bundle";
+
+    // bundle is written before the script is executed
+    auto writeBundle = [&](const char* source) -> bool {
+        PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+        auto initializeResult = context->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("testbundle.js"));
+        return initializeResult.isSuccessful() && context->scriptParser()->writeBundle(initializeResult.script.get(), bundleFile.data());
+    };
+
+    std::string result;
+    CHECK("Bundle 1", writeBundle("function f() { return 3; } f();") && evalScriptFromBundle(instance, bundleFile.data(), result) && result == "3");
+
+    // every function block has its own relocations
+    CHECK("Bundle 2", writeBundle("function counter(start) { var count = start; return function() { return count++; }; }"
+                                  "class Point {"
+                                  "    constructor(x, y) { this.x = x; this.y = y; }"
+                                  "    add(other) { return new Point(this.x + other.x, this.y + other.y); }"
+                                  "    toString() { return `(${this.x}, ${this.y})`; }"
+                                  "}"
+                                  "var next = counter(5);"
+                                  "next();"
+                                  "[next(), new Point(1, 2).add(new Point(3, 4)).toString(), [1, 2, 3].map(function(v) { return v * next(); }).join()].join(';');")
+              && evalScriptFromBundle(instance, bundleFile.data(), result) && result == "6;(4, 6);7,16,27");
+
+    unlink(bundleFile.data());
+    rmdir(directory);
+}
+
+static bool evalWarmUpScript(VMInstanceRef* instance, const char* source, std::string& result)
+{
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    auto initializeResult = context->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("testwarmup.js"));
+    if (!initializeResult.isSuccessful()) {
+        return false;
+    }
+
+    auto evalResult = Evaluator::execute(context.get(), [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         initializeResult.script.get());
+    result = evalResult.resultOrErrorToString(context.get())->toStdUTF8String();
+    return evalResult.isSuccessful();
+}
+
+static void testWarmUpProfile(VMInstanceRef* instance)
+{
+    char directory[] = "/tmp/escargot-warmup-XXXXXX";
+    if (!mkdtemp(directory)) {
+        CHECK("Warm-up profile 1", false);
+        return;
+    }
+    std::string profileFile = std::string(directory) + "/profile";
+
+    const char* source = "function add(a, b) { return a + b; }"
+                         "function less(a, b) { return a < b; }"
+                         "function getX(o) { return o.x; }"
+                         "function setX(o, v) { o.x = v; }"
+                         "function call(f, v) { return f(v); }"
+                         "function twice(v) { return v * 2; }"
+                         "var warmUp = (function() {"
+                         "    var shapes = [];"
+                         "    for (var i = 0; i < 20; i++) { var o = { x: i }; o['p' + i] = i; shapes.push(o); }"
+                         "    var sum = 0;"
+                         "    for (var i = 0; i < 100; i++) { sum += add(i, 1) + less(i, 50) + getX(shapes[i % 20]) + call(twice, i); setX(shapes[i % 4], i); }"
+                         "    return sum;"
+                         "})();"
+                         "[warmUp, add('a', 1), add(0.5, 1), less('b', 'a'), getX({ y: 1, x: 'x' }), call(function(v) { return -v; }, 3), shapes0()].join();"
+                         "function shapes0() { var o = { x: 1 }; setX(o, 'set'); return o.x; }";
+    const char* expected = "16686,a1,1.5,false,x,-3,set";
+
+    // profile is written after the first run
+    std::string result;
+    CHECK("Warm-up profile 1", evalWarmUpScript(instance, source, result) && result == expected);
+    CHECK("Warm-up profile 2", instance->exportWarmUpProfile(profileFile.data()) && readFile(profileFile).size() > 8);
+
+    // caches and quickened code seeded from profile should still handle other types and shapes
+    {
+        PersistentRefHolder<VMInstanceRef> instance2 = VMInstanceRef::create(new TestPlatform());
+        instance2->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+            delete instance->platform();
+        });
+        CHECK("Warm-up profile 3", instance2->importWarmUpProfile(profileFile.data()));
+        CHECK("Warm-up profile 4", evalWarmUpScript(instance2.get(), source, result) && result == expected);
+        // function at profiled position whose source changed is not seeded
+        CHECK("Warm-up profile 5", evalWarmUpScript(instance2.get(), "function add(a, b) { return a - b; } add(3, 1) + add(0.5, 1);", result) && result == "1.5");
+        instance2.release();
+    }
+
+    // broken or missing profile is rejected
+    std::vector<char> content = readFile(profileFile);
+    content.resize(content.size() / 2);
+    writeFile(profileFile, content);
+    CHECK("Warm-up profile 6", !instance->importWarmUpProfile(profileFile.data()));
+    unlink(profileFile.data());
+    CHECK("Warm-up profile 7", !instance->importWarmUpProfile(profileFile.data()));
+    rmdir(directory);
+}
+
+int main(int argc, char* argv[])
+{
+#ifndef NDEBUG
+    setbuf(stdout, NULL);
+    setbuf(stderr, NULL);
+#endif
+
+    printf("testoptimizations begins\n");
+
+    Globals::initialize();
+
+    TestPlatform* platform = new TestPlatform();
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(platform);
+    instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+        delete instance->platform();
+    });
+
+    testPrototypeValidityCell(instance.get());
+    testRegisterCoalescing(instance.get());
+    testUnboxedDouble(instance.get());
+    testInlinePropertySlots(instance.get());
+    testObjectLiteralStructure(instance.get());
+    testSetObjectInlineCache(instance.get());
+    testCallTargetCache(instance.get());
+    testCompareAndJump(instance.get());
+    testTypedArrayElementCache(instance.get());
+    testPropertyAccessStubCache(instance.get());
+    testInstanceOfAndInCache(instance.get());
+    testScopeShapeCache(instance.get());
+    testSharedBuiltinStructure(instance.get());
+    testLazyBuiltins(instance.get());
+    testByteCodeEviction(instance.get());
+    testLOCTable(instance.get());
+    testCompactByteCode(instance.get());
+    testColdCatchClause(instance.get());
+    testConstructorPrototypeCache(instance.get());
+    testCodeCache(instance.get());
+    testBundle(instance.get());
+    testWarmUpProfile(instance.get());
+    testSharedScript(instance.get());
+
+    instance.release();
+
+    Globals::finalize();
+
+    printf("testoptimizations ended\n");
+
+    return 0;
+}